@@ -61,6 +61,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_allegro5.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_allegro5 doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 #include <stdint.h>     // uint64_t
 #include <cstring>      // memcpy
 
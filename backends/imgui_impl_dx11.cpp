@@ -46,6 +46,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_dx11.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_dx11 doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 
 // DirectX
 #include <stdio.h>
@@ -56,6 +56,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_dx12.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_dx12 doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 
 // DirectX
 #include <d3d12.h>
@@ -44,6 +44,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_dx9.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_dx9 doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 
 // DirectX
 #include <d3d9.h>
@@ -41,6 +41,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_metal.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_metal doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 #import <time.h>
 #import <Metal/Metal.h>
 
@@ -50,6 +50,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_opengl2.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_opengl2 doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 #include <stdint.h>     // intptr_t
 
 // Clang/GCC warnings with -Weverything
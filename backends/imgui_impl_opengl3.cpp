@@ -8,6 +8,9 @@
 //  [x] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset) [Desktop OpenGL only!]
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
 //  [X] Renderer: Multi-viewport support (multiple windows). Enable with 'io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable'.
+//  [X] Renderer: Compact vertex layout (IMGUI_USE_COMPACT_DRAWVERT).
+//  [X] Renderer: Signed distance field textures for ImFontAtlasFlags_SDF (ImGuiBackendFlags_RendererHasSdfTextures).
+//  [X] Renderer: Single-channel ImTextureFormat_Alpha8 textures (e.g. 'io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8').
 
 // About WebGL/ES:
 // - You need to '#define IMGUI_IMPL_OPENGL_ES2' or '#define IMGUI_IMPL_OPENGL_ES3' to use WebGL or OpenGL ES.
@@ -24,6 +27,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025-XX-XX: OpenGL: Added support for ImTextureFormat_Alpha8 textures: uploaded as a single-channel texture (GL_R8, or GL_LUMINANCE on GL 2.x/ES 2.0), expanded to white + alpha in the fragment shader.
+//  2025-XX-XX: OpenGL: Added support for ImGuiBackendFlags_RendererHasSdfTextures: textures with ImTextureData::IsSdf are thresholded in the fragment shader. OpenGL ES 2.0 needs GL_OES_standard_derivatives for best quality.
+//  2025-XX-XX: OpenGL: Added support for IMGUI_USE_COMPACT_DRAWVERT compact vertex layout (16-bit positions relative to ImDrawList::VtxOrigin, folded into projection matrix).
 //  2025-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2025-06-11: OpenGL: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas. Removed ImGui_ImplOpenGL3_CreateFontsTexture() and ImGui_ImplOpenGL3_DestroyFontsTexture().
 //  2025-06-04: OpenGL: Made GLES 3.20 contexts not access GL_CONTEXT_PROFILE_MASK nor GL_PRIMITIVE_RESTART. (#8664)
@@ -217,6 +223,25 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
 #endif
 
+// Compact vertex layout uses 16-bit signed positions (not exposed by our loader)
+#if defined(IMGUI_USE_COMPACT_DRAWVERT) && !defined(GL_SHORT)
+#define GL_SHORT                                0x1402
+#endif
+
+// Single-channel textures for ImTextureFormat_Alpha8 (not exposed by our loader)
+#ifndef GL_UNPACK_ALIGNMENT
+#define GL_UNPACK_ALIGNMENT                     0x0CF5
+#endif
+#ifndef GL_RED
+#define GL_RED                                  0x1903
+#endif
+#ifndef GL_R8
+#define GL_R8                                   0x8229
+#endif
+#ifndef GL_LUMINANCE
+#define GL_LUMINANCE                            0x1909
+#endif
+
 // [Debugging]
 //#define IMGUI_IMPL_OPENGL_DEBUG
 #ifdef IMGUI_IMPL_OPENGL_DEBUG
@@ -239,6 +264,8 @@ struct ImGui_ImplOpenGL3_Data
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationTexIsSdf;
+    GLint           AttribLocationTexIsAlpha8;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -248,7 +275,12 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasPolygonMode;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    bool            TextureIsSdf;           // Current value of the TextureIsSdf uniform
+    bool            TextureIsAlpha8;        // Current value of the TextureIsAlpha8 uniform
     ImVector<char>  TempBuffer;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    float           ProjMtx[4][4];          // Projection matrix set by ImGui_ImplOpenGL3_SetupRenderState(), see ImGui_ImplOpenGL3_SetupDrawListOrigin()
+#endif
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -370,6 +402,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
 #endif
     io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;       // We can honor ImGuiPlatformIO::Textures[] requests during render.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfTextures;    // We can render textures with ImTextureData::IsSdf (ImFontAtlasFlags_SDF).
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;      // We can create multi-viewports on the Renderer side (optional)
 
     ImGuiPlatformIO& platform_io = ImGui::GetPlatformIO();
@@ -429,7 +462,7 @@ void    ImGui_ImplOpenGL3_Shutdown()
     ImGui_ImplOpenGL3_DestroyDeviceObjects();
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasViewports);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasSdfTextures | ImGuiBackendFlags_RendererHasViewports);
     IM_DELETE(bd);
 }
 
@@ -496,7 +529,14 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     };
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
+    glUniform1i(bd->AttribLocationTexIsSdf, 0);
+    glUniform1i(bd->AttribLocationTexIsAlpha8, 0);
+    bd->TextureIsSdf = false;
+    bd->TextureIsAlpha8 = false;
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    memcpy(bd->ProjMtx, ortho_projection, sizeof(ortho_projection));
+#endif
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
@@ -514,11 +554,33 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxColor));
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_SHORT,          GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
+    GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
+#else
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxPos,   2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, pos)));
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxUV,    2, GL_FLOAT,         GL_FALSE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, uv)));
+#endif
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
 }
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Compact vertices store positions relative to ImDrawList::VtxOrigin, in 1/IM_DRAWVERT_POS_SCALE pixel units: fold this into the projection matrix.
+static void ImGui_ImplOpenGL3_SetupDrawListOrigin(const ImDrawList* draw_list)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    float mtx[4][4];
+    memcpy(mtx, bd->ProjMtx, sizeof(mtx));
+    for (int row = 0; row < 4; row++)
+    {
+        mtx[3][row] += bd->ProjMtx[0][row] * draw_list->VtxOrigin.x + bd->ProjMtx[1][row] * draw_list->VtxOrigin.y;
+        mtx[0][row] *= 1.0f / IM_DRAWVERT_POS_SCALE;
+        mtx[1][row] *= 1.0f / IM_DRAWVERT_POS_SCALE;
+    }
+    glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &mtx[0][0]);
+}
+#endif
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -628,6 +690,9 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             GL_CALL(glBufferData(GL_ARRAY_BUFFER, vtx_buffer_size, (const GLvoid*)draw_list->VtxBuffer.Data, GL_STREAM_DRAW));
             GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, idx_buffer_size, (const GLvoid*)draw_list->IdxBuffer.Data, GL_STREAM_DRAW));
         }
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        ImGui_ImplOpenGL3_SetupDrawListOrigin(draw_list);
+#endif
 
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
@@ -637,7 +702,12 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+                    ImGui_ImplOpenGL3_SetupDrawListOrigin(draw_list);
+#endif
+                }
                 else
                     pcmd->UserCallback(draw_list, pcmd);
             }
@@ -653,6 +723,18 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
 
                 // Bind texture, Draw
+                const bool texture_is_sdf = pcmd->TexRef._TexData != nullptr && pcmd->TexRef._TexData->IsSdf;
+                if (bd->TextureIsSdf != texture_is_sdf)
+                {
+                    GL_CALL(glUniform1i(bd->AttribLocationTexIsSdf, texture_is_sdf ? 1 : 0));
+                    bd->TextureIsSdf = texture_is_sdf;
+                }
+                const bool texture_is_alpha8 = pcmd->TexRef._TexData != nullptr && pcmd->TexRef._TexData->Format == ImTextureFormat_Alpha8;
+                if (bd->TextureIsAlpha8 != texture_is_alpha8)
+                {
+                    GL_CALL(glUniform1i(bd->AttribLocationTexIsAlpha8, texture_is_alpha8 ? 1 : 0));
+                    bd->TextureIsAlpha8 = texture_is_alpha8;
+                }
                 GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
@@ -719,6 +801,25 @@ static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
     tex->SetStatus(ImTextureStatus_Destroyed);
 }
 
+// ImTextureFormat_Alpha8 textures are uploaded as single-channel textures, and the fragment shader reads them from the red channel.
+// GL_LUMINANCE is used where GL_RED is not available (GL 2.x, GL ES 2.0), it replicates the value in red/green/blue.
+static void ImGui_ImplOpenGL3_GetTextureFormat(ImTextureData* tex, GLint* out_internal_format, GLenum* out_format)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (tex->Format == ImTextureFormat_RGBA32)
+    {
+        *out_internal_format = GL_RGBA;
+        *out_format = GL_RGBA;
+    }
+    else
+    {
+        IM_ASSERT(tex->Format == ImTextureFormat_Alpha8);
+        const bool has_red = bd->GlVersion >= 300 && !bd->GlProfileIsES2;
+        *out_internal_format = has_red ? GL_R8 : GL_LUMINANCE;
+        *out_format = has_red ? GL_RED : GL_LUMINANCE;
+    }
+}
+
 void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 {
     if (tex->Status == ImTextureStatus_WantCreate)
@@ -726,9 +827,11 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == 0 && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
         const void* pixels = tex->GetPixels();
         GLuint gl_texture_id = 0;
+        GLint gl_internal_format;
+        GLenum gl_format;
+        ImGui_ImplOpenGL3_GetTextureFormat(tex, &gl_internal_format, &gl_format);
 
         // Upload texture to graphics system
         // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
@@ -743,13 +846,17 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 #ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #endif
-        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tex->Width, tex->Height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        GLint last_unpack_alignment;
+        GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1)); // Rows of single-channel textures are not 4-bytes aligned
+        GL_CALL(glTexImage2D(GL_TEXTURE_2D, 0, gl_internal_format, tex->Width, tex->Height, 0, gl_format, GL_UNSIGNED_BYTE, pixels));
 
         // Store identifiers
         tex->SetTexID((ImTextureID)(intptr_t)gl_texture_id);
         tex->SetStatus(ImTextureStatus_OK);
 
         // Restore state
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment));
         GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
     }
     else if (tex->Status == ImTextureStatus_WantUpdates)
@@ -758,13 +865,19 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         // This backend choose to use tex->Updates[] but you can use tex->UpdateRect to upload a single region.
         GLint last_texture;
         GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+        GLint last_unpack_alignment;
+        GL_CALL(glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment));
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+        GLint gl_internal_format;
+        GLenum gl_format;
+        ImGui_ImplOpenGL3_GetTextureFormat(tex, &gl_internal_format, &gl_format);
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
         GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
 #if 0// GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
         for (ImTextureRect& r : tex->Updates)
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, tex->GetPixelsAt(r.x, r.y)));
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
 #else
         // GL ES doesn't have GL_UNPACK_ROW_LENGTH, so we need to (A) copy to a contiguous buffer or (B) upload line by line.
@@ -777,11 +890,12 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
             for (int y = 0; y < r.h; y++, out_p += src_pitch)
                 memcpy(out_p, tex->GetPixelsAt(r.x, r.y + y), src_pitch);
             IM_ASSERT(out_p == bd->TempBuffer.end());
-            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, GL_RGBA, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
+            GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, r.x, r.y, r.w, r.h, gl_format, GL_UNSIGNED_BYTE, bd->TempBuffer.Data));
         }
 #endif
         tex->SetStatus(ImTextureStatus_OK);
-        GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
+        GL_CALL(glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment)); // Restore state
+        GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
     }
     else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
         ImGui_ImplOpenGL3_DestroyTexture(tex);
@@ -903,47 +1017,77 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
+    // Textures with ImTextureFormat_Alpha8 are stored in the red channel: expand them to white + alpha.
+    // Textures with ImTextureData::IsSdf store a signed distance field in alpha: threshold it around 0.5 with a one pixel wide ramp (see ImTextureDataSampleSdf()).
     const GLchar* fragment_shader_glsl_120 =
         "#ifdef GL_ES\n"
+        "#ifdef GL_OES_standard_derivatives\n"
+        "#extension GL_OES_standard_derivatives : enable\n"
+        "#endif\n"
         "    precision mediump float;\n"
         "#endif\n"
         "uniform sampler2D Texture;\n"
+        "uniform int TextureIsSdf;\n"
+        "uniform int TextureIsAlpha8;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture2D(Texture, Frag_UV.st);\n"
+        "    tex = mix(tex, vec4(1.0, 1.0, 1.0, tex.r), float(TextureIsAlpha8));\n"
+        "#if defined(GL_ES) && !defined(GL_OES_standard_derivatives)\n"
+        "    float sdf_width = 0.1;\n"
+        "#else\n"
+        "    float sdf_width = max(fwidth(tex.a), 1.0 / 1024.0);\n"
+        "#endif\n"
+        "    float sdf_alpha = clamp((tex.a - 0.5) / sdf_width + 0.5, 0.0, 1.0);\n"
+        "    gl_FragColor = Frag_Color * vec4(tex.rgb, mix(tex.a, sdf_alpha, float(TextureIsSdf)));\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform int TextureIsSdf;\n"
+        "uniform int TextureIsAlpha8;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    tex = mix(tex, vec4(1.0, 1.0, 1.0, tex.r), float(TextureIsAlpha8));\n"
+        "    float sdf_alpha = clamp((tex.a - 0.5) / max(fwidth(tex.a), 1.0 / 1024.0) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * vec4(tex.rgb, mix(tex.a, sdf_alpha, float(TextureIsSdf)));\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int TextureIsSdf;\n"
+        "uniform int TextureIsAlpha8;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    tex = mix(tex, vec4(1.0, 1.0, 1.0, tex.r), float(TextureIsAlpha8));\n"
+        "    float sdf_alpha = clamp((tex.a - 0.5) / max(fwidth(tex.a), 1.0 / 1024.0) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * vec4(tex.rgb, mix(tex.a, sdf_alpha, float(TextureIsSdf)));\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform int TextureIsSdf;\n"
+        "uniform int TextureIsAlpha8;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    tex = mix(tex, vec4(1.0, 1.0, 1.0, tex.r), float(TextureIsAlpha8));\n"
+        "    float sdf_alpha = clamp((tex.a - 0.5) / max(fwidth(tex.a), 1.0 / 1024.0) + 0.5, 0.0, 1.0);\n"
+        "    Out_Color = Frag_Color * vec4(tex.rgb, mix(tex.a, sdf_alpha, float(TextureIsSdf)));\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -1002,6 +1146,8 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationTexIsSdf = glGetUniformLocation(bd->ShaderHandle, "TextureIsSdf");
+    bd->AttribLocationTexIsAlpha8 = glGetUniformLocation(bd->ShaderHandle, "TextureIsAlpha8");
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
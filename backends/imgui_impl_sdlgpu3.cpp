@@ -35,6 +35,9 @@
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_sdlgpu3.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_sdlgpu3 doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 #include "imgui_impl_sdlgpu3_shaders.h"
 
 // SDL_GPU Data
@@ -14,6 +14,7 @@
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+//  [X] Renderer: Compact vertex layout (IMGUI_USE_COMPACT_DRAWVERT). Vertices are decoded on CPU.
 // Missing features:
 //  [ ] Renderer: Multi-viewport support (multiple windows).
 
@@ -26,6 +27,7 @@
 // - Introduction, links and more at the top of imgui.cpp
 
 // CHANGELOG
+//  2025-XX-XX: Added support for IMGUI_USE_COMPACT_DRAWVERT compact vertex layout (decoded on CPU before calling SDL_RenderGeometryRaw()).
 //  2025-06-11: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas. Removed ImGui_ImplSDLRenderer2_CreateFontsTexture() and ImGui_ImplSDLRenderer2_DestroyFontsTexture().
 //  2025-01-18: Use endian-dependent RGBA32 texture format, to match SDL_Color.
 //  2024-10-09: Expose selected render state in ImGui_ImplSDLRenderer2_RenderState, which you can access in 'void* platform_io.Renderer_RenderState' during draw callbacks.
@@ -60,6 +62,9 @@
 struct ImGui_ImplSDLRenderer2_Data
 {
     SDL_Renderer*   Renderer;       // Main viewport's renderer
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    ImVector<ImVec2> DecodedVtxBuffer; // (pos, uv) pairs decoded from compact vertices
+#endif
 
     ImGui_ImplSDLRenderer2_Data()   { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -122,6 +127,10 @@ void ImGui_ImplSDLRenderer2_NewFrame()
 
 void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer* renderer)
 {
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    ImGui_ImplSDLRenderer2_Data* bd = ImGui_ImplSDLRenderer2_GetBackendData();
+#endif
+
     // If there's a scale factor set by the user, use that instead
     // If the user has specified a scale factor to SDL_Renderer already via SDL_RenderSetScale(), SDL will scale whatever we pass
     // to SDL_RenderGeometryRaw() by that scale factor. In that case we don't want to be also scaling it ourselves here.
@@ -176,6 +185,16 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
         const ImDrawList* draw_list = draw_data->CmdLists[n];
         const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
         const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        // SDL_RenderGeometryRaw() needs float positions and UV: decode compact vertices once per draw list, as (pos, uv) pairs.
+        bd->DecodedVtxBuffer.resize(draw_list->VtxBuffer.Size * 2);
+        for (int vtx_n = 0; vtx_n < draw_list->VtxBuffer.Size; vtx_n++)
+        {
+            const ImDrawVert* v = &vtx_buffer[vtx_n];
+            bd->DecodedVtxBuffer.Data[vtx_n * 2 + 0] = ImVec2(draw_list->VtxOrigin.x + v->pos[0] / IM_DRAWVERT_POS_SCALE, draw_list->VtxOrigin.y + v->pos[1] / IM_DRAWVERT_POS_SCALE);
+            bd->DecodedVtxBuffer.Data[vtx_n * 2 + 1] = ImVec2(v->uv[0] / 65535.0f, v->uv[1] / 65535.0f);
+        }
+#endif
 
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
@@ -204,8 +223,15 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
                 SDL_Rect r = { (int)(clip_min.x), (int)(clip_min.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
                 SDL_RenderSetClipRect(renderer, &r);
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+                const float* xy = &bd->DecodedVtxBuffer.Data[pcmd->VtxOffset * 2 + 0].x;
+                const float* uv = &bd->DecodedVtxBuffer.Data[pcmd->VtxOffset * 2 + 1].x;
+                const int xy_uv_stride = (int)sizeof(ImVec2) * 2;
+#else
                 const float* xy = (const float*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, pos));
                 const float* uv = (const float*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, uv));
+                const int xy_uv_stride = (int)sizeof(ImDrawVert);
+#endif
 #if SDL_VERSION_ATLEAST(2,0,19)
                 const SDL_Color* color = (const SDL_Color*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, col)); // SDL 2.0.19+
 #else
@@ -215,9 +241,9 @@ void ImGui_ImplSDLRenderer2_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
                 // Bind texture, Draw
                 SDL_Texture* tex = (SDL_Texture*)pcmd->GetTexID();
                 SDL_RenderGeometryRaw(renderer, tex,
-                    xy, (int)sizeof(ImDrawVert),
+                    xy, xy_uv_stride,
                     color, (int)sizeof(ImDrawVert),
-                    uv, (int)sizeof(ImDrawVert),
+                    uv, xy_uv_stride,
                     draw_list->VtxBuffer.Size - pcmd->VtxOffset,
                     idx_buffer + pcmd->IdxOffset, pcmd->ElemCount, sizeof(ImDrawIdx));
             }
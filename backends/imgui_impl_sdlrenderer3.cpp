@@ -14,6 +14,8 @@
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+//  [X] Renderer: Compact vertex layout (IMGUI_USE_COMPACT_DRAWVERT). Vertices are decoded on CPU.
+//  [X] Renderer: ImTextureFormat_Alpha8 textures. Pixels are expanded to RGBA32 on CPU when uploading, as SDL_Renderer has no single-channel texture format.
 // Missing features:
 //  [ ] Renderer: Multi-viewport support (multiple windows).
 
@@ -26,6 +28,8 @@
 // - Introduction, links and more at the top of imgui.cpp
 
 // CHANGELOG
+//  2025-XX-XX: Added support for ImTextureFormat_Alpha8 textures (expanded to white + alpha RGBA32 pixels when uploading updated blocks).
+//  2025-XX-XX: Added support for IMGUI_USE_COMPACT_DRAWVERT compact vertex layout (decoded on CPU before calling SDL_RenderGeometryRaw()).
 //  2025-06-11: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas. Removed ImGui_ImplSDLRenderer3_CreateFontsTexture() and ImGui_ImplSDLRenderer3_DestroyFontsTexture().
 //  2025-01-18: Use endian-dependent RGBA32 texture format, to match SDL_Color.
 //  2024-10-09: Expose selected render state in ImGui_ImplSDLRenderer3_RenderState, which you can access in 'void* platform_io.Renderer_RenderState' during draw callbacks.
@@ -58,6 +62,10 @@ struct ImGui_ImplSDLRenderer3_Data
 {
     SDL_Renderer*           Renderer;       // Main viewport's renderer
     ImVector<SDL_FColor>    ColorBuffer;
+    ImVector<unsigned char> TexUploadBuffer;    // Alpha8 pixels expanded to RGBA32 before upload
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    ImVector<ImVec2>        DecodedVtxBuffer;   // (pos, uv) pairs decoded from compact vertices
+#endif
 
     ImGui_ImplSDLRenderer3_Data()   { memset((void*)this, 0, sizeof(*this)); }
 };
@@ -196,6 +204,16 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
         const ImDrawList* draw_list = draw_data->CmdLists[n];
         const ImDrawVert* vtx_buffer = draw_list->VtxBuffer.Data;
         const ImDrawIdx* idx_buffer = draw_list->IdxBuffer.Data;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        // SDL_RenderGeometryRaw() needs float positions and UV: decode compact vertices once per draw list, as (pos, uv) pairs.
+        bd->DecodedVtxBuffer.resize(draw_list->VtxBuffer.Size * 2);
+        for (int vtx_n = 0; vtx_n < draw_list->VtxBuffer.Size; vtx_n++)
+        {
+            const ImDrawVert* v = &vtx_buffer[vtx_n];
+            bd->DecodedVtxBuffer.Data[vtx_n * 2 + 0] = ImVec2(draw_list->VtxOrigin.x + v->pos[0] / IM_DRAWVERT_POS_SCALE, draw_list->VtxOrigin.y + v->pos[1] / IM_DRAWVERT_POS_SCALE);
+            bd->DecodedVtxBuffer.Data[vtx_n * 2 + 1] = ImVec2(v->uv[0] / 65535.0f, v->uv[1] / 65535.0f);
+        }
+#endif
 
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
@@ -224,16 +242,23 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
                 SDL_Rect r = { (int)(clip_min.x), (int)(clip_min.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
                 SDL_SetRenderClipRect(renderer, &r);
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+                const float* xy = &bd->DecodedVtxBuffer.Data[pcmd->VtxOffset * 2 + 0].x;
+                const float* uv = &bd->DecodedVtxBuffer.Data[pcmd->VtxOffset * 2 + 1].x;
+                const int xy_uv_stride = (int)sizeof(ImVec2) * 2;
+#else
                 const float* xy = (const float*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, pos));
                 const float* uv = (const float*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, uv));
+                const int xy_uv_stride = (int)sizeof(ImDrawVert);
+#endif
                 const SDL_Color* color = (const SDL_Color*)(const void*)((const char*)(vtx_buffer + pcmd->VtxOffset) + offsetof(ImDrawVert, col)); // SDL 2.0.19+
 
                 // Bind texture, Draw
                 SDL_Texture* tex = (SDL_Texture*)pcmd->GetTexID();
                 SDL_RenderGeometryRaw8BitColor(renderer, bd->ColorBuffer, tex,
-                    xy, (int)sizeof(ImDrawVert),
+                    xy, xy_uv_stride,
                     color, (int)sizeof(ImDrawVert),
-                    uv, (int)sizeof(ImDrawVert),
+                    uv, xy_uv_stride,
                     draw_list->VtxBuffer.Size - pcmd->VtxOffset,
                     idx_buffer + pcmd->IdxOffset, pcmd->ElemCount, sizeof(ImDrawIdx));
             }
@@ -246,6 +271,32 @@ void ImGui_ImplSDLRenderer3_RenderDrawData(ImDrawData* draw_data, SDL_Renderer*
     SDL_SetRenderClipRect(renderer, old.ClipEnabled ? &old.ClipRect : nullptr);
 }
 
+static void ImGui_ImplSDLRenderer3_UploadTextureRect(SDL_Texture* sdl_texture, ImTextureData* tex, int x, int y, int w, int h)
+{
+    SDL_Rect sdl_r = { x, y, w, h };
+    if (tex->Format == ImTextureFormat_RGBA32)
+    {
+        SDL_UpdateTexture(sdl_texture, &sdl_r, tex->GetPixelsAt(x, y), tex->GetPitch());
+        return;
+    }
+
+    // SDL_Renderer has no single-channel format: expand to white + alpha
+    ImGui_ImplSDLRenderer3_Data* bd = ImGui_ImplSDLRenderer3_GetBackendData();
+    // (Bytes are written in R,G,B,A order to match SDL_PIXELFORMAT_RGBA32 regardless of endianness)
+    bd->TexUploadBuffer.resize(w * h * 4);
+    for (int yy = 0; yy < h; yy++)
+    {
+        const unsigned char* src = (const unsigned char*)tex->GetPixelsAt(x, y + yy);
+        unsigned char* dst = bd->TexUploadBuffer.Data + yy * w * 4;
+        for (int xx = 0; xx < w; xx++, dst += 4)
+        {
+            dst[0] = dst[1] = dst[2] = 255;
+            dst[3] = src[xx];
+        }
+    }
+    SDL_UpdateTexture(sdl_texture, &sdl_r, bd->TexUploadBuffer.Data, w * 4);
+}
+
 void ImGui_ImplSDLRenderer3_UpdateTexture(ImTextureData* tex)
 {
     ImGui_ImplSDLRenderer3_Data* bd = ImGui_ImplSDLRenderer3_GetBackendData();
@@ -255,13 +306,13 @@ void ImGui_ImplSDLRenderer3_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == 0 && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
 
         // Create texture
         // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
         SDL_Texture* sdl_texture = SDL_CreateTexture(bd->Renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, tex->Width, tex->Height);
         IM_ASSERT(sdl_texture != nullptr && "Backend failed to create texture!");
-        SDL_UpdateTexture(sdl_texture, nullptr, tex->GetPixels(), tex->GetPitch());
+        ImGui_ImplSDLRenderer3_UploadTextureRect(sdl_texture, tex, 0, 0, tex->Width, tex->Height);
         SDL_SetTextureBlendMode(sdl_texture, SDL_BLENDMODE_BLEND);
         SDL_SetTextureScaleMode(sdl_texture, SDL_SCALEMODE_LINEAR);
 
@@ -275,10 +326,7 @@ void ImGui_ImplSDLRenderer3_UpdateTexture(ImTextureData* tex)
         // This backend choose to use tex->Updates[] but you can use tex->UpdateRect to upload a single region.
         SDL_Texture* sdl_texture = (SDL_Texture*)(intptr_t)tex->TexID;
         for (ImTextureRect& r : tex->Updates)
-        {
-            SDL_Rect sdl_r = { r.x, r.y, r.w, r.h };
-            SDL_UpdateTexture(sdl_texture, &sdl_r, tex->GetPixelsAt(r.x, r.y), tex->GetPitch());
-        }
+            ImGui_ImplSDLRenderer3_UploadTextureRect(sdl_texture, tex, r.x, r.y, r.w, r.h);
         tex->SetStatus(ImTextureStatus_OK);
     }
     else if (tex->Status == ImTextureStatus_WantDestroy)
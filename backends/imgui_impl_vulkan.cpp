@@ -6,6 +6,9 @@
 //  [X] Renderer: Large meshes support (64k+ vertices) even with 16-bit indices (ImGuiBackendFlags_RendererHasVtxOffset).
 //  [X] Renderer: Texture updates support for dynamic font atlas (ImGuiBackendFlags_RendererHasTextures).
 //  [X] Renderer: Expose selected render state for draw callbacks to use. Access in '(ImGui_ImplXXXX_RenderState*)GetPlatformIO().Renderer_RenderState'.
+//  [X] Renderer: Compact vertex layout (IMGUI_USE_COMPACT_DRAWVERT).
+//  [X] Renderer: Signed distance field textures for ImFontAtlasFlags_SDF (ImGuiBackendFlags_RendererHasSdfTextures).
+//  [X] Renderer: Single-channel ImTextureFormat_Alpha8 textures (e.g. 'io.Fonts->TexDesiredFormat = ImTextureFormat_Alpha8').
 //  [x] Renderer: Multi-viewport / platform windows. With issues (flickering when creating a new viewport).
 
 // The aim of imgui_impl_vulkan.h/.cpp is to be usable in your engine without any modification.
@@ -28,6 +31,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025-XX-XX: Vulkan: Added support for ImTextureFormat_Alpha8 textures: uploaded as VK_FORMAT_R8_UNORM images, expanded to white + alpha by the image view component swizzle.
+//  2025-XX-XX: Vulkan: Added support for ImGuiBackendFlags_RendererHasSdfTextures: textures with ImTextureData::IsSdf are thresholded in the fragment shader, selected by a fragment push constant at offset 16.
+//  2025-XX-XX: Vulkan: Added support for IMGUI_USE_COMPACT_DRAWVERT compact vertex layout (16-bit positions relative to ImDrawList::VtxOrigin, folded into push constants).
 //  2025-XX-XX: Platform: Added support for multiple windows via the ImGuiPlatformIO interface.
 //  2025-06-11: Vulkan: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas. Removed ImGui_ImplVulkan_CreateFontsTexture() and ImGui_ImplVulkan_DestroyFontsTexture().
 //  2025-05-07: Vulkan: Fixed validation errors during window detach in multi-viewport mode. (#8600, #8176)
@@ -368,24 +374,31 @@ static uint32_t __glsl_shader_vert_spv[] =
 #version 450 core
 layout(location = 0) out vec4 fColor;
 layout(set=0, binding=0) uniform sampler2D sTexture;
+layout(push_constant) uniform uPushConstant { layout(offset = 16) float uTextureIsSdf; } pc;
 layout(location = 0) in struct { vec4 Color; vec2 UV; } In;
 void main()
 {
-    fColor = In.Color * texture(sTexture, In.UV.st);
+    vec4 tex = texture(sTexture, In.UV.st);
+    float sdf_alpha = clamp((tex.a - 0.5) / max(fwidth(tex.a), 1.0 / 1024.0) + 0.5, 0.0, 1.0);
+    tex.a = mix(tex.a, sdf_alpha, pc.uTextureIsSdf);
+    fColor = In.Color * tex;
 }
 */
 static uint32_t __glsl_shader_frag_spv[] =
 {
-    0x07230203,0x00010000,0x00080001,0x0000001e,0x00000000,0x00020011,0x00000001,0x0006000b,
+    0x07230203,0x00010000,0x00080001,0x00000031,0x00000000,0x00020011,0x00000001,0x0006000b,
     0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
     0x0007000f,0x00000004,0x00000004,0x6e69616d,0x00000000,0x00000009,0x0000000d,0x00030010,
     0x00000004,0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000004,0x6e69616d,
     0x00000000,0x00040005,0x00000009,0x6c6f4366,0x0000726f,0x00030005,0x0000000b,0x00000000,
     0x00050006,0x0000000b,0x00000000,0x6f6c6f43,0x00000072,0x00040006,0x0000000b,0x00000001,
     0x00005655,0x00030005,0x0000000d,0x00006e49,0x00050005,0x00000016,0x78655473,0x65727574,
-    0x00000000,0x00040047,0x00000009,0x0000001e,0x00000000,0x00040047,0x0000000d,0x0000001e,
+    0x00000000,0x00060005,0x0000001e,0x73755075,0x6e6f4368,0x6e617473,0x00000074,0x00070006,
+    0x0000001e,0x00000000,0x78655475,0x65727574,0x64537349,0x00000066,0x00030005,0x00000020,
+    0x00006370,0x00040047,0x00000009,0x0000001e,0x00000000,0x00040047,0x0000000d,0x0000001e,
     0x00000000,0x00040047,0x00000016,0x00000022,0x00000000,0x00040047,0x00000016,0x00000021,
-    0x00000000,0x00020013,0x00000002,0x00030021,0x00000003,0x00000002,0x00030016,0x00000006,
+    0x00000000,0x00050048,0x0000001e,0x00000000,0x00000023,0x00000010,0x00030047,0x0000001e,
+    0x00000002,0x00020013,0x00000002,0x00030021,0x00000003,0x00000002,0x00030016,0x00000006,
     0x00000020,0x00040017,0x00000007,0x00000006,0x00000004,0x00040020,0x00000008,0x00000003,
     0x00000007,0x0004003b,0x00000008,0x00000009,0x00000003,0x00040017,0x0000000a,0x00000006,
     0x00000002,0x0004001e,0x0000000b,0x00000007,0x0000000a,0x00040020,0x0000000c,0x00000001,
@@ -394,13 +407,24 @@ static uint32_t __glsl_shader_frag_spv[] =
     0x00000007,0x00090019,0x00000013,0x00000006,0x00000001,0x00000000,0x00000000,0x00000000,
     0x00000001,0x00000000,0x0003001b,0x00000014,0x00000013,0x00040020,0x00000015,0x00000000,
     0x00000014,0x0004003b,0x00000015,0x00000016,0x00000000,0x0004002b,0x0000000e,0x00000018,
-    0x00000001,0x00040020,0x00000019,0x00000001,0x0000000a,0x00050036,0x00000002,0x00000004,
-    0x00000000,0x00000003,0x000200f8,0x00000005,0x00050041,0x00000010,0x00000011,0x0000000d,
-    0x0000000f,0x0004003d,0x00000007,0x00000012,0x00000011,0x0004003d,0x00000014,0x00000017,
-    0x00000016,0x00050041,0x00000019,0x0000001a,0x0000000d,0x00000018,0x0004003d,0x0000000a,
-    0x0000001b,0x0000001a,0x00050057,0x00000007,0x0000001c,0x00000017,0x0000001b,0x00050085,
-    0x00000007,0x0000001d,0x00000012,0x0000001c,0x0003003e,0x00000009,0x0000001d,0x000100fd,
-    0x00010038
+    0x00000001,0x00040020,0x00000019,0x00000001,0x0000000a,0x0003001e,0x0000001e,0x00000006,
+    0x00040020,0x0000001f,0x00000009,0x0000001e,0x0004003b,0x0000001f,0x00000020,0x00000009,
+    0x00040020,0x00000021,0x00000009,0x00000006,0x0004002b,0x00000006,0x00000022,0x3f000000,
+    0x0004002b,0x00000006,0x00000023,0x3a800000,0x0004002b,0x00000006,0x00000024,0x00000000,
+    0x0004002b,0x00000006,0x00000025,0x3f800000,0x00050036,0x00000002,0x00000004,0x00000000,
+    0x00000003,0x000200f8,0x00000005,0x00050041,0x00000010,0x00000011,0x0000000d,0x0000000f,
+    0x0004003d,0x00000007,0x00000012,0x00000011,0x0004003d,0x00000014,0x00000017,0x00000016,
+    0x00050041,0x00000019,0x0000001a,0x0000000d,0x00000018,0x0004003d,0x0000000a,0x0000001b,
+    0x0000001a,0x00050057,0x00000007,0x0000001c,0x00000017,0x0000001b,0x00050051,0x00000006,
+    0x00000026,0x0000001c,0x00000003,0x000400d1,0x00000006,0x00000027,0x00000026,0x0007000c,
+    0x00000006,0x00000028,0x00000001,0x00000028,0x00000027,0x00000023,0x00050083,0x00000006,
+    0x00000029,0x00000026,0x00000022,0x00050088,0x00000006,0x0000002a,0x00000029,0x00000028,
+    0x00050081,0x00000006,0x0000002b,0x0000002a,0x00000022,0x0008000c,0x00000006,0x0000002c,
+    0x00000001,0x0000002b,0x0000002b,0x00000024,0x00000025,0x00050041,0x00000021,0x0000002d,
+    0x00000020,0x0000000f,0x0004003d,0x00000006,0x0000002e,0x0000002d,0x0008000c,0x00000006,
+    0x0000002f,0x00000001,0x0000002e,0x00000026,0x0000002c,0x0000002e,0x00060052,0x00000007,
+    0x00000030,0x0000002f,0x0000001c,0x00000003,0x00050085,0x00000007,0x0000001d,0x00000012,
+    0x00000030,0x0003003e,0x00000009,0x0000001d,0x000100fd,0x00010038
 };
 
 //-----------------------------------------------------------------------------
@@ -519,7 +543,32 @@ static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline
         vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
         vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
     }
+
+    // Setup signed distance field thresholding (enabled per draw command for textures with ImTextureData::IsSdf)
+    {
+        float texture_is_sdf = 0.0f;
+        vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(float) * 4, sizeof(float), &texture_is_sdf);
+    }
+}
+
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+// Compact vertices store positions relative to ImDrawList::VtxOrigin, in 1/IM_DRAWVERT_POS_SCALE pixel units.
+// We read them as VK_FORMAT_R16G16_SNORM (which support is mandatory for vertex buffers): fold this into scale and translation.
+static void ImGui_ImplVulkan_SetupDrawListOrigin(ImDrawData* draw_data, VkCommandBuffer command_buffer, const ImDrawList* draw_list)
+{
+    ImGui_ImplVulkan_Data* bd = ImGui_ImplVulkan_GetBackendData();
+    float scale[2];
+    scale[0] = 2.0f / draw_data->DisplaySize.x;
+    scale[1] = 2.0f / draw_data->DisplaySize.y;
+    float translate[2];
+    translate[0] = -1.0f + (draw_list->VtxOrigin.x - draw_data->DisplayPos.x) * scale[0];
+    translate[1] = -1.0f + (draw_list->VtxOrigin.y - draw_data->DisplayPos.y) * scale[1];
+    scale[0] *= 32767.0f / IM_DRAWVERT_POS_SCALE;
+    scale[1] *= 32767.0f / IM_DRAWVERT_POS_SCALE;
+    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 0, sizeof(float) * 2, scale);
+    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, sizeof(float) * 2, sizeof(float) * 2, translate);
 }
+#endif
 
 // Render function
 void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline)
@@ -614,9 +663,13 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     // (Because we merged all buffers into a single one, we maintain our own offset into them)
     int global_vtx_offset = 0;
     int global_idx_offset = 0;
+    bool texture_is_sdf = false; // Current value of the fragment push constant, see ImGui_ImplVulkan_SetupRenderState()
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
         const ImDrawList* draw_list = draw_data->CmdLists[n];
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+        ImGui_ImplVulkan_SetupDrawListOrigin(draw_data, command_buffer, draw_list);
+#endif
         for (int cmd_i = 0; cmd_i < draw_list->CmdBuffer.Size; cmd_i++)
         {
             const ImDrawCmd* pcmd = &draw_list->CmdBuffer[cmd_i];
@@ -625,7 +678,13 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
+                    texture_is_sdf = false;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+                    ImGui_ImplVulkan_SetupDrawListOrigin(draw_data, command_buffer, draw_list);
+#endif
+                }
                 else
                     pcmd->UserCallback(draw_list, pcmd);
             }
@@ -654,6 +713,13 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
                 // Bind DescriptorSet with font or user texture
                 VkDescriptorSet desc_set = (VkDescriptorSet)pcmd->GetTexID();
                 vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bd->PipelineLayout, 0, 1, &desc_set, 0, nullptr);
+                const bool cmd_texture_is_sdf = pcmd->TexRef._TexData != nullptr && pcmd->TexRef._TexData->IsSdf;
+                if (texture_is_sdf != cmd_texture_is_sdf)
+                {
+                    float push_value = cmd_texture_is_sdf ? 1.0f : 0.0f;
+                    vkCmdPushConstants(command_buffer, bd->PipelineLayout, VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(float) * 4, sizeof(float), &push_value);
+                    texture_is_sdf = cmd_texture_is_sdf;
+                }
 
                 // Draw
                 vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
@@ -708,15 +774,16 @@ void ImGui_ImplVulkan_UpdateTexture(ImTextureData* tex)
         // Create and upload new texture to graphics system
         //IMGUI_DEBUG_LOG("UpdateTexture #%03d: WantCreate %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
         IM_ASSERT(tex->TexID == ImTextureID_Invalid && tex->BackendUserData == nullptr);
-        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32);
+        IM_ASSERT(tex->Format == ImTextureFormat_RGBA32 || tex->Format == ImTextureFormat_Alpha8);
         ImGui_ImplVulkan_Texture* backend_tex = IM_NEW(ImGui_ImplVulkan_Texture)();
+        const VkFormat vk_format = (tex->Format == ImTextureFormat_Alpha8) ? VK_FORMAT_R8_UNORM : VK_FORMAT_R8G8B8A8_UNORM;
 
         // Create the Image:
         {
             VkImageCreateInfo info = {};
             info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
             info.imageType = VK_IMAGE_TYPE_2D;
-            info.format = VK_FORMAT_R8G8B8A8_UNORM;
+            info.format = vk_format;
             info.extent.width = tex->Width;
             info.extent.height = tex->Height;
             info.extent.depth = 1;
@@ -747,7 +814,15 @@ void ImGui_ImplVulkan_UpdateTexture(ImTextureData* tex)
             info.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
             info.image = backend_tex->Image;
             info.viewType = VK_IMAGE_VIEW_TYPE_2D;
-            info.format = VK_FORMAT_R8G8B8A8_UNORM;
+            info.format = vk_format;
+            if (tex->Format == ImTextureFormat_Alpha8)
+            {
+                // Sample single-channel textures as white + alpha, so the same shader renders both formats.
+                info.components.r = VK_COMPONENT_SWIZZLE_ONE;
+                info.components.g = VK_COMPONENT_SWIZZLE_ONE;
+                info.components.b = VK_COMPONENT_SWIZZLE_ONE;
+                info.components.a = VK_COMPONENT_SWIZZLE_R;
+            }
             info.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
             info.subresourceRange.levelCount = 1;
             info.subresourceRange.layerCount = 1;
@@ -939,11 +1014,19 @@ static void ImGui_ImplVulkan_CreatePipeline(VkDevice device, const VkAllocationC
     VkVertexInputAttributeDescription attribute_desc[3] = {};
     attribute_desc[0].location = 0;
     attribute_desc[0].binding = binding_desc[0].binding;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    attribute_desc[0].format = VK_FORMAT_R16G16_SNORM; // See ImGui_ImplVulkan_SetupDrawListOrigin()
+#else
     attribute_desc[0].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
     attribute_desc[0].offset = offsetof(ImDrawVert, pos);
     attribute_desc[1].location = 1;
     attribute_desc[1].binding = binding_desc[0].binding;
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    attribute_desc[1].format = VK_FORMAT_R16G16_UNORM;
+#else
     attribute_desc[1].format = VK_FORMAT_R32G32_SFLOAT;
+#endif
     attribute_desc[1].offset = offsetof(ImDrawVert, uv);
     attribute_desc[2].location = 2;
     attribute_desc[2].binding = binding_desc[0].binding;
@@ -1088,16 +1171,20 @@ bool ImGui_ImplVulkan_CreateDeviceObjects()
     if (!bd->PipelineLayout)
     {
         // Constants: we are using 'vec2 offset' and 'vec2 scale' instead of a full 3d projection matrix
-        VkPushConstantRange push_constants[1] = {};
+        // Fragment constant: 'float uTextureIsSdf' (ImGuiBackendFlags_RendererHasSdfTextures)
+        VkPushConstantRange push_constants[2] = {};
         push_constants[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
         push_constants[0].offset = sizeof(float) * 0;
         push_constants[0].size = sizeof(float) * 4;
+        push_constants[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        push_constants[1].offset = sizeof(float) * 4;
+        push_constants[1].size = sizeof(float) * 1;
         VkDescriptorSetLayout set_layout[1] = { bd->DescriptorSetLayout };
         VkPipelineLayoutCreateInfo layout_info = {};
         layout_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
         layout_info.setLayoutCount = 1;
         layout_info.pSetLayouts = set_layout;
-        layout_info.pushConstantRangeCount = 1;
+        layout_info.pushConstantRangeCount = (uint32_t)IM_ARRAYSIZE(push_constants);
         layout_info.pPushConstantRanges = push_constants;
         err = vkCreatePipelineLayout(v->Device, &layout_info, v->Allocator, &bd->PipelineLayout);
         check_vk_result(err);
@@ -1240,6 +1327,7 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info)
     io.BackendRendererName = "imgui_impl_vulkan";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
     io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;   // We can honor ImGuiPlatformIO::Textures[] requests during render.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasSdfTextures;// We can render textures with ImTextureData::IsSdf (ImFontAtlasFlags_SDF).
     io.BackendFlags |= ImGuiBackendFlags_RendererHasViewports;  // We can create multi-viewports on the Renderer side (optional)
 
     IM_ASSERT(info->Instance != VK_NULL_HANDLE);
@@ -1302,7 +1390,7 @@ void ImGui_ImplVulkan_Shutdown()
 
     io.BackendRendererName = nullptr;
     io.BackendRendererUserData = nullptr;
-    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasViewports);
+    io.BackendFlags &= ~(ImGuiBackendFlags_RendererHasVtxOffset | ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasSdfTextures | ImGuiBackendFlags_RendererHasViewports);
     IM_DELETE(bd);
 }
 
@@ -61,6 +61,9 @@
 
 #ifndef IMGUI_DISABLE
 #include "imgui_impl_wgpu.h"
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+#error "imgui_impl_wgpu doesn't support IMGUI_USE_COMPACT_DRAWVERT (see imconfig.h for supported renderer backends)."
+#endif
 #include <limits.h>
 #include <webgpu/webgpu.h>
 
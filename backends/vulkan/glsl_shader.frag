@@ -3,6 +3,10 @@ layout(location = 0) out vec4 fColor;
 
 layout(set=0, binding=0) uniform sampler2D sTexture;
 
+layout(push_constant) uniform uPushConstant {
+    layout(offset = 16) float uTextureIsSdf;
+} pc;
+
 layout(location = 0) in struct {
     vec4 Color;
     vec2 UV;
@@ -10,5 +14,8 @@ layout(location = 0) in struct {
 
 void main()
 {
-    fColor = In.Color * texture(sTexture, In.UV.st);
+    vec4 tex = texture(sTexture, In.UV.st);
+    float sdf_alpha = clamp((tex.a - 0.5) / max(fwidth(tex.a), 1.0 / 1024.0) + 0.5, 0.0, 1.0);
+    tex.a = mix(tex.a, sdf_alpha, pc.uTextureIsSdf);
+    fColor = In.Color * tex;
 }
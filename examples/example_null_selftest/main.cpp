@@ -0,0 +1,1261 @@
+// dear imgui: "null" self-test application
+// (compile and link imgui, run headless with NO INPUTS, NO GRAPHICS OUTPUT)
+// Checks behaviors which cannot be seen in the regular examples. See Makefile: 'make check' builds and runs all variants.
+//
+// Built with IMGUI_DEBUG_PARANOID, so the library verifies its own SIMD paths and other internal invariants with IM_ASSERT().
+//
+// Usage:
+//   example_null_selftest polyline                       Tessellate a fixed set of polylines and convex polygons (SSE normals/miters are checked against the scalar path).
+//                                                        Check that AddLineBatch() outputs the same geometry as AddLine().
+//   example_null_selftest triangulate                    Triangulate simple and degenerate concave polygons of 100 to 10k points, check and time the output.
+//   example_null_selftest utf8                           Check UTF-8 decoding fast paths against ImTextCharFromUtf8(), report throughput in MB/s.
+//   example_null_selftest fontfile <font> <atlases>      Load a 16 MB copy of a font file in N atlases, report startup time and resident memory, check they share it.
+//   example_null_selftest rasterize <font> [checksum]     Bake glyphs from 13 to 96 px with several oversampling factors, report glyphs/s and atlas checksum.
+//                                                        Fail if a checksum is given and doesn't match (used to compare SSE and scalar rasterization).
+//   example_null_selftest sdf <font>                     Bake glyphs with ImFontAtlasFlags_SDF, compare their coverage (ImTextureDataSampleSdf()) with regular glyphs at several sizes.
+//   example_null_selftest pages <font> <frames>          Load glyphs and custom rectangles into 256x256 pages (ImFontAtlasFlags_MultiPage) until more than
+//                                                        IM_FONTATLAS_PAGES_MAX were needed, check rectangles, UV and pixels of every page each frame.
+//   example_null_selftest evict <font> <frames>          Alternate between text at many sizes and at a single size with ImFontAtlas::TexGlyphBudget and ImFontAtlasFlags_MultiPage,
+//                                                        check that pages get evicted back under budget and that evicted glyphs reload identically.
+//   example_null_selftest defertess <frames>             Render the demo window with and without io.ConfigDrawListsDeferTessellation, compare the output.
+//   example_null_selftest drawvert <frames>              Render the demo window and style editor, report vertex/index bytes uploaded per frame.
+//   example_null_selftest wrapcache <frames>             Submit large wrapped text blocks from a new buffer every frame, check that their cache doesn't grow.
+//   example_null_selftest multicontext <threads> <frames>  Run N contexts sharing a font atlas, serially then in parallel threads, and compare their output.
+//                                                         Requires IMGUI_ENABLE_THREAD_LOCAL_CONTEXT. Build with -fsanitize=thread to check for data races.
+#include "imgui.h"
+#include "imgui_internal.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#include <thread>
+#include <vector>
+#endif
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+// Deterministic pseudo-random generator, so every build variant tessellates the same shapes
+static unsigned int g_Seed = 0x12345678;
+static float RandomFloat(float min, float max)
+{
+    g_Seed = g_Seed * 1664525u + 1013904223u;
+    return min + (max - min) * (float)(g_Seed >> 8) / (float)(1 << 24);
+}
+
+static int RandomInt(int max)
+{
+    return (int)RandomFloat(0.0f, (float)max);
+}
+
+// Time in microseconds, for benchmarks
+static double GetTimeUs()
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Resident set size in bytes, 0 when unsupported
+static size_t GetResidentMemory()
+{
+    size_t pages_count = 0;
+#ifdef __linux__
+    if (FILE* f = fopen("/proc/self/statm", "r"))
+    {
+        unsigned long size = 0, resident = 0;
+        if (fscanf(f, "%lu %lu", &size, &resident) == 2)
+            pages_count = (size_t)resident * (size_t)sysconf(_SC_PAGESIZE);
+        fclose(f);
+    }
+#endif
+    return pages_count;
+}
+
+static ImGuiContext* CreateHeadlessContext(ImFontAtlas* shared_font_atlas = NULL)
+{
+    ImGuiContext* ctx = ImGui::CreateContext(shared_font_atlas);
+    ImGui::SetCurrentContext(ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    return ctx;
+}
+
+// Honor texture requests like a renderer backend would
+static void UpdateTexturesLikeBackend(ImFontAtlas* atlas)
+{
+    for (ImTextureData* tex : atlas->TexList)
+    {
+        if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
+        {
+            tex->SetTexID((ImTextureID)(intptr_t)tex->UniqueID);
+            tex->SetStatus(ImTextureStatus_OK);
+        }
+        else if (tex->Status == ImTextureStatus_WantDestroy)
+        {
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+}
+
+static ImGuiID HashDrawList(const ImDrawList* draw_list, ImGuiID seed)
+{
+    seed = ImHashData(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), seed);
+    return ImHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), seed);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Polyline tessellation (SSE vs scalar path)
+//-----------------------------------------------------------------------------
+
+// Tessellate shapes covering all code paths of AddPolyline() and AddConvexPolyFilled():
+// - open/closed, thin/thick/textured lines, with and without anti-aliasing.
+// - point counts around multiples of 4, for the SIMD blocks and their scalar tails.
+// - duplicate points (zero-length segments) and back-tracking points (degenerate miters).
+static int TestPolyline()
+{
+    CreateHeadlessContext();
+    ImGui::NewFrame();
+
+    const ImDrawListFlags flags_variants[] =
+    {
+        ImDrawListFlags_None,
+        ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill,
+        ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill,
+    };
+    const float thickness_variants[] = { 1.0f, 1.5f, 2.0f, 3.7f, 12.0f };
+
+    ImVector<ImVec2> points;
+    ImDrawList* draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    size_t total_vtx = 0, total_idx = 0;
+    ImGuiID checksum = 0;
+    for (const ImDrawListFlags dl_flags : flags_variants)
+        for (int points_count = 2; points_count <= 19; points_count++)
+            for (int shape_n = 0; shape_n < 4; shape_n++)
+            {
+                points.resize(points_count);
+                for (int n = 0; n < points_count; n++)
+                    points[n] = ImVec2(RandomFloat(0.0f, 1000.0f), RandomFloat(0.0f, 1000.0f));
+                if (shape_n == 1)
+                    points[points_count / 2] = points[points_count / 2 - 1];        // Zero-length segment
+                if (shape_n == 2 && points_count >= 3)
+                    points[2] = points[0];                                          // Back-tracking segment
+
+                draw_list->_ResetForNewFrame();
+                draw_list->Flags = dl_flags;
+                draw_list->PushClipRectFullScreen();
+                draw_list->PushTexture(ImGui::GetIO().Fonts->TexRef);
+                for (const float thickness : thickness_variants)
+                {
+                    draw_list->AddPolyline(points.Data, points.Size, IM_COL32(255, 128, 64, 200), ImDrawFlags_None, thickness);
+                    draw_list->AddPolyline(points.Data, points.Size, IM_COL32(255, 128, 64, 200), ImDrawFlags_Closed, thickness);
+                }
+                draw_list->AddConvexPolyFilled(points.Data, points.Size, IM_COL32(64, 128, 255, 200));
+
+                checksum = ImHashData(draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes(), checksum);
+                checksum = ImHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), checksum);
+                total_vtx += (size_t)draw_list->VtxBuffer.Size;
+                total_idx += (size_t)draw_list->IdxBuffer.Size;
+            }
+
+    // AddLineBatch() must output the same vertices and indices as calling AddLine() for each line
+    int errors = 0;
+    ImDrawList* batch_draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    ImVector<ImVec2> p1, p2;
+    ImVector<ImU32> cols;
+    for (int line_n = 0; line_n < 200; line_n++)
+    {
+        p1.push_back(ImVec2(RandomFloat(0.0f, 1000.0f), RandomFloat(0.0f, 1000.0f)));
+        p2.push_back((line_n % 7) == 3 ? p1.back() : ImVec2(RandomFloat(0.0f, 1000.0f), RandomFloat(0.0f, 1000.0f))); // Include zero-length lines
+        cols.push_back((line_n % 5) == 2 ? IM_COL32(255, 255, 255, 0) : IM_COL32(255, 128, 64, 200));                 // Include transparent lines
+    }
+    for (const ImDrawListFlags dl_flags : flags_variants)
+        for (const float thickness : thickness_variants)
+        {
+            ImDrawList* lists[2] = { draw_list, batch_draw_list };
+            for (ImDrawList* list : lists)
+            {
+                list->_ResetForNewFrame();
+                list->Flags = dl_flags;
+                list->PushClipRectFullScreen();
+                list->PushTexture(ImGui::GetIO().Fonts->TexRef);
+            }
+            for (int line_n = 0; line_n < p1.Size; line_n++)
+                draw_list->AddLine(p1[line_n], p2[line_n], cols[line_n], thickness);
+            batch_draw_list->AddLineBatch(p1.Data, p2.Data, cols.Data, p1.Size, thickness);
+            if (draw_list->VtxBuffer.Size != batch_draw_list->VtxBuffer.Size || draw_list->IdxBuffer.Size != batch_draw_list->IdxBuffer.Size
+                || memcmp(draw_list->VtxBuffer.Data, batch_draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes()) != 0
+                || memcmp(draw_list->IdxBuffer.Data, batch_draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes()) != 0)
+            {
+                fprintf(stderr, "polyline: AddLineBatch() output differs from AddLine() (flags 0x%X, thickness %.1f).\n", dl_flags, thickness);
+                errors++;
+            }
+        }
+    IM_DELETE(batch_draw_list);
+    IM_DELETE(draw_list);
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    printf("polyline: %d vertices, %d indices, checksum 0x%08X, %d line batch mismatches.\n", (int)total_vtx, (int)total_idx, checksum, errors);
+    return errors > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Concave polygon triangulation (ImTriangulator)
+//-----------------------------------------------------------------------------
+
+enum TriangulateShape
+{
+    TriangulateShape_WavyStar,          // Simple polygons
+    TriangulateShape_RandomRadial,
+    TriangulateShape_Spiky,
+    TriangulateShape_Comb,
+    TriangulateShape_Coincident,        // Degenerate polygons
+    TriangulateShape_Collinear,
+    TriangulateShape_SelfIntersecting,
+    TriangulateShape_COUNT
+};
+
+static const char* TriangulateShapeNames[TriangulateShape_COUNT] = { "wavy star", "random radial", "spiky", "comb", "coincident", "collinear", "self-intersecting" };
+
+static void BuildTriangulateShape(ImVector<ImVec2>& points, TriangulateShape shape, int points_count)
+{
+    const ImVec2 center(500.0f, 500.0f);
+    points.resize(points_count);
+    for (int n = 0; n < points_count; n++)
+    {
+        const float a = IM_PI * 2.0f * n / points_count;
+        float r = 0.0f;
+        switch (shape)
+        {
+        case TriangulateShape_WavyStar:         r = 300.0f + 100.0f * ImSin(a * 12.0f); break;
+        case TriangulateShape_RandomRadial:     r = RandomFloat(100.0f, 450.0f); break;
+        case TriangulateShape_Spiky:            r = (n & 1) ? 40.0f : 450.0f; break;
+        case TriangulateShape_Coincident:       r = (n < points_count / 2) ? 450.0f : 0.0f; break; // Half of the points at the center
+        default: break;
+        }
+        points[n] = ImVec2(center.x + ImCos(a) * r, center.y + ImSin(a) * r);
+    }
+    if (shape == TriangulateShape_Comb)
+    {
+        // Teeth along the top edge, going back along a flat bottom edge: not star-shaped, reflex vertices are spread along the polygon.
+        const int teeth_points_count = points_count - 2;
+        for (int n = 0; n < teeth_points_count; n++)
+            points[n] = ImVec2(50.0f + 900.0f * (n >> 1) / ImMax(teeth_points_count >> 1, 1), ((n & 3) == 1 || (n & 3) == 2) ? 100.0f : 800.0f);
+        points[points_count - 2] = ImVec2(950.0f, 900.0f);
+        points[points_count - 1] = ImVec2(50.0f, 900.0f);
+    }
+    else if (shape == TriangulateShape_Collinear)
+    {
+        for (int n = 0; n < points_count; n++)
+            points[n] = ImVec2(50.0f + 900.0f * n / points_count, 500.0f);
+    }
+    else if (shape == TriangulateShape_SelfIntersecting)
+    {
+        for (int n = 0; n < points_count; n++)
+            points[n] = ImVec2(RandomFloat(50.0f, 950.0f), RandomFloat(50.0f, 950.0f));
+    }
+}
+
+// Triangulate simple and degenerate polygons of 100, 1k and 10k points with AddConcavePolyFilled().
+// - Every output must be a valid set of points_count - 2 triangles.
+// - Triangles of simple polygons must all have the orientation of the polygon and cover its area exactly.
+// Also report the best time out of a few runs, degenerate polygons must not be much slower than simple ones.
+static int TestTriangulate()
+{
+    CreateHeadlessContext();
+    ImGui::NewFrame();
+
+    ImVector<ImVec2> points;
+    ImDrawList* draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    int errors = 0;
+    ImGuiID checksum = 0;
+    const int points_count_variants[] = { 100, 1000, 10000 };
+    for (int shape_n = 0; shape_n < TriangulateShape_COUNT; shape_n++)
+    {
+        printf("triangulate: %-18s", TriangulateShapeNames[shape_n]);
+        for (const int points_count : points_count_variants)
+        {
+            // Random self-intersecting polygons run out of ears and rebuild them after almost every triangle: 10k points take several seconds.
+            if (shape_n == TriangulateShape_SelfIntersecting && points_count > 1000)
+                continue;
+            BuildTriangulateShape(points, (TriangulateShape)shape_n, points_count);
+
+            double best_time = 0.0, total_time = 0.0;
+            for (int run_n = 0; run_n < 5 && total_time < 100000.0; run_n++)
+            {
+                draw_list->_ResetForNewFrame();
+                draw_list->Flags = ImDrawListFlags_None;
+                draw_list->PushClipRectFullScreen();
+                draw_list->PushTexture(ImGui::GetIO().Fonts->TexRef);
+                const double t0 = GetTimeUs();
+                draw_list->AddConcavePolyFilled(points.Data, points.Size, IM_COL32(64, 128, 255, 200));
+                const double time = GetTimeUs() - t0;
+                best_time = (run_n == 0) ? time : ImMin(best_time, time);
+                total_time += time;
+            }
+            printf(" %5d: %8.0f us", points_count, best_time);
+
+            // Validate output of the last run
+            checksum = ImHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), checksum);
+            const int expected_idx_count = (points_count - 2) * 3;
+            bool valid = (draw_list->IdxBuffer.Size == expected_idx_count);
+            for (int n = 0; valid && n < draw_list->IdxBuffer.Size; n++)
+                valid = ((int)draw_list->IdxBuffer[n] < points_count);
+            if (valid && shape_n < TriangulateShape_Coincident)
+            {
+                double polygon_area = 0.0, triangles_area = 0.0;
+                for (int n = 0; n < points_count; n++)
+                    polygon_area += (double)points[n].x * points[(n + 1) % points_count].y - (double)points[(n + 1) % points_count].x * points[n].y;
+                for (int n = 0; n < expected_idx_count; n += 3)
+                {
+                    const ImVec2& a = points[draw_list->IdxBuffer[n]];
+                    const ImVec2& b = points[draw_list->IdxBuffer[n + 1]];
+                    const ImVec2& c = points[draw_list->IdxBuffer[n + 2]];
+                    const double area = (double)(b.x - a.x) * (c.y - a.y) - (double)(c.x - a.x) * (b.y - a.y);
+                    if (area * polygon_area < 0.0)
+                        valid = false;
+                    triangles_area += ImAbs(area);
+                }
+                if (ImAbs(triangles_area - ImAbs(polygon_area)) > ImAbs(polygon_area) * 1e-4)
+                    valid = false;
+            }
+            if (!valid)
+            {
+                fprintf(stderr, "\ntriangulate: invalid triangulation of '%s' polygon with %d points.\n", TriangulateShapeNames[shape_n], points_count);
+                errors++;
+            }
+        }
+        printf("\n");
+    }
+    IM_DELETE(draw_list);
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    printf("triangulate: checksum 0x%08X, %d invalid triangulations.\n", checksum, errors);
+    return errors > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] UTF-8 decoding (ASCII fast paths vs ImTextCharFromUtf8)
+//-----------------------------------------------------------------------------
+
+// Append random UTF-8 text. 'mixed' adds control characters, 2 to 4 bytes sequences and invalid bytes to printable ASCII.
+static void AppendRandomUtf8(ImVector<char>& buf, int len, bool mixed)
+{
+    static const char* const mixed_samples[] = { "\n", "\t", "\r", "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80", "\xFF", "\x80", "\xE4\xB8", "\xC0\xAF" };
+    while (len > 0)
+    {
+        const char* sample = (mixed && RandomInt(10) == 0) ? mixed_samples[RandomInt(IM_ARRAYSIZE(mixed_samples))] : NULL;
+        if (sample != NULL)
+        {
+            for (; *sample && len > 0; sample++, len--)
+                buf.push_back(*sample);
+            continue;
+        }
+        buf.push_back((char)(32 + RandomInt(127 - 32)));
+        len--;
+    }
+}
+
+// Reference implementation of ImTextStrFromUtf8(): decode every character with ImTextCharFromUtf8().
+static int RefTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
+{
+    ImWchar* buf_out = buf;
+    while (buf_out < buf + buf_size - 1 && in_text < in_text_end && *in_text)
+    {
+        unsigned int c;
+        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+        *buf_out++ = (ImWchar)c;
+    }
+    *buf_out = 0;
+    *in_text_remaining = in_text;
+    return (int)(buf_out - buf);
+}
+
+// Reference implementation of ImFont::CalcTextSizeA() without word-wrapping: decode every character with ImTextCharFromUtf8().
+static ImVec2 RefCalcTextSizeA(ImFont* font, float size, float max_width, const char* text_begin, const char* text_end, const char** remaining)
+{
+    ImFontBaked* baked = font->GetFontBaked(size);
+    const float scale = size / baked->Size;
+    ImVec2 text_size(0.0f, 0.0f);
+    float line_width = 0.0f;
+    const char* s = text_begin;
+    while (s < text_end)
+    {
+        const char* prev_s = s;
+        unsigned int c;
+        s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c == '\n')
+        {
+            text_size.x = ImMax(text_size.x, line_width);
+            text_size.y += size;
+            line_width = 0.0f;
+            continue;
+        }
+        if (c == '\r')
+            continue;
+        const float char_width = baked->GetCharAdvance((ImWchar)c) * scale;
+        if (line_width + char_width >= max_width)
+        {
+            s = prev_s;
+            break;
+        }
+        line_width += char_width;
+    }
+    text_size.x = ImMax(text_size.x, line_width);
+    if (line_width > 0 || text_size.y == 0.0f)
+        text_size.y += size;
+    *remaining = s;
+    return text_size;
+}
+
+// Compare ImTextStrFromUtf8(), ImTextCountCharsFromUtf8() and ImFont::CalcTextSizeA() to decoding every character, on random ASCII and mixed strings.
+// Then report their throughput in MB/s on 1 MB of text, and on short labels for CalcTextSizeA().
+static int TestUtf8()
+{
+    CreateHeadlessContext();
+    ImGui::NewFrame();
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+
+    int errors = 0;
+    ImVector<char> text;
+    ImVector<ImWchar> out, ref_out;
+    for (int test_n = 0; test_n < 3000; test_n++)
+    {
+        text.resize(0);
+        AppendRandomUtf8(text, RandomInt(200), (test_n & 1) != 0);
+        const char* text_begin = text.Data;
+        const char* text_end = text.Data + text.Size;
+
+        const int buf_size = (test_n % 3 == 0) ? 1 + RandomInt(text.Size + 1) : text.Size + 1; // Include truncated outputs
+        out.resize(buf_size);
+        ref_out.resize(buf_size);
+        const char* remaining = NULL;
+        const char* ref_remaining = NULL;
+        const int count = ImTextStrFromUtf8(out.Data, buf_size, text_begin, text_end, &remaining);
+        const int ref_count = RefTextStrFromUtf8(ref_out.Data, buf_size, text_begin, text_end, &ref_remaining);
+        if (count != ref_count || remaining != ref_remaining || memcmp(out.Data, ref_out.Data, (size_t)(count + 1) * sizeof(ImWchar)) != 0)
+            errors++;
+        if (ImTextCountCharsFromUtf8(text_begin, text_end) != RefTextStrFromUtf8(ref_out.Data, text.Size + 1, text_begin, text_end, &ref_remaining))
+            errors++;
+
+        const float max_width = (test_n % 4 == 0) ? RandomFloat(0.0f, 400.0f) : FLT_MAX; // Include clipped measures
+        const ImVec2 text_size = font->CalcTextSizeA(font_size, max_width, 0.0f, text_begin, text_end, &remaining);
+        const ImVec2 ref_text_size = RefCalcTextSizeA(font, font_size, max_width, text_begin, text_end, &ref_remaining);
+        if (text_size.x != ref_text_size.x || text_size.y != ref_text_size.y || remaining != ref_remaining)
+            errors++;
+    }
+    if (errors > 0)
+        fprintf(stderr, "utf8: %d outputs differ from the reference decoder.\n", errors);
+
+    // Benchmark: best of a few runs over 1 MB of text, and over 2000 labels of 8-64 characters
+    ImVector<char> labels;
+    ImVector<int> labels_offsets;
+    for (int mixed = 0; mixed < 2; mixed++)
+    {
+        text.resize(0);
+        AppendRandomUtf8(text, 1024 * 1024, mixed != 0);
+        for (int n = 80; n < text.Size; n += 80)
+            if ((unsigned char)text[n] < 0x80)
+                text[n] = '\n';
+        labels.resize(0);
+        labels_offsets.resize(0);
+        for (int n = 0; n < 2000; n++)
+        {
+            labels_offsets.push_back(labels.Size);
+            AppendRandomUtf8(labels, 8 + RandomInt(57), mixed != 0);
+        }
+        labels_offsets.push_back(labels.Size);
+        out.resize(text.Size + 1);
+
+        const char* text_begin = text.Data;
+        const char* text_end = text.Data + text.Size;
+        double best_times[5] = { 1e10, 1e10, 1e10, 1e10, 1e10 };
+        volatile unsigned int sink = 0;
+        for (int run_n = 0; run_n < 5; run_n++)
+        {
+            double t0 = GetTimeUs();
+            for (const char* s = text_begin; s < text_end; )
+            {
+                unsigned int c;
+                s += ImTextCharFromUtf8(&c, s, text_end);
+                sink += c;
+            }
+            double t1 = GetTimeUs();
+            sink += (unsigned int)ImTextStrFromUtf8(out.Data, out.Size, text_begin, text_end);
+            double t2 = GetTimeUs();
+            sink += (unsigned int)ImTextCountCharsFromUtf8(text_begin, text_end);
+            double t3 = GetTimeUs();
+            sink += (unsigned int)font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, text_begin, text_end).y;
+            double t4 = GetTimeUs();
+            for (int n = 0; n + 1 < labels_offsets.Size; n++)
+                sink += (unsigned int)font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, labels.Data + labels_offsets[n], labels.Data + labels_offsets[n + 1]).x;
+            double t5 = GetTimeUs();
+            const double times[5] = { t1 - t0, t2 - t1, t3 - t2, t4 - t3, t5 - t4 };
+            for (int n = 0; n < 5; n++)
+                best_times[n] = ImMin(best_times[n], times[n]);
+        }
+        const double text_mb = text.Size / (1024.0 * 1024.0), labels_mb = labels.Size / (1024.0 * 1024.0);
+        printf("utf8: %-5s MB/s: ImTextCharFromUtf8 loop %6.0f, ImTextStrFromUtf8 %6.0f, ImTextCountCharsFromUtf8 %6.0f, CalcTextSizeA %6.0f, CalcTextSizeA labels %6.0f\n", mixed ? "mixed" : "ascii",
+            text_mb * 1e6 / best_times[0], text_mb * 1e6 / best_times[1], text_mb * 1e6 / best_times[2], text_mb * 1e6 / best_times[3], labels_mb * 1e6 / best_times[4]);
+    }
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+    printf("utf8: %d mismatches.\n", errors);
+    return errors > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Font files shared between atlases (AddFontFromFileTTF)
+//-----------------------------------------------------------------------------
+
+// Write a copy of a font file padded to 'file_size' bytes, standing in for a large CJK font. Font loaders ignore trailing data.
+static bool WritePaddedFontFile(const char* filename, const void* font_data, size_t font_data_size, size_t file_size, char padding)
+{
+    ImVector<char> buf;
+    buf.resize((int)file_size, padding);
+    memcpy(buf.Data, font_data, font_data_size);
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    const bool ret = ImFileWrite(buf.Data, 1, (ImU64)buf.Size, f) == (ImU64)buf.Size;
+    ImFileClose(f);
+    return ret;
+}
+
+// Load the same 16 MB font file in N contexts with their own atlas, and bake the glyphs of one sentence in each.
+// Report startup time and resident memory when copying the file in each atlas (AddFontFromMemoryTTF), then when sharing it (AddFontFromFileTTF).
+// Check that all atlases share the same file data, that a file replaced on disk gets loaded again, and that the last atlas releases it.
+static int TestFontFile(const char* font_filename, int atlases_count)
+{
+    size_t font_data_size = 0;
+    void* font_data = ImFileLoadToMemory(font_filename, "rb", &font_data_size);
+    const char* filename = "example_null_selftest_font.ttf";
+    const size_t file_size = 16 * 1024 * 1024;
+    if (font_data == NULL || !WritePaddedFontFile(filename, font_data, font_data_size, file_size, 0))
+    {
+        fprintf(stderr, "fontfile: could not load '%s' or write '%s'.\n", font_filename, filename);
+        return 1;
+    }
+
+    const char* text = "The quick brown fox jumps over the lazy dog 0123456789";
+    int errors = 0;
+    for (int shared = 0; shared < 2; shared++)
+    {
+        ImVector<ImGuiContext*> contexts;
+        const size_t rss_before = GetResidentMemory();
+        const double t0 = GetTimeUs();
+        for (int atlas_n = 0; atlas_n < atlases_count; atlas_n++)
+        {
+            contexts.push_back(CreateHeadlessContext());
+            ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+            ImFont* font = NULL;
+            if (shared)
+            {
+                font = atlas->AddFontFromFileTTF(filename, 20.0f);
+            }
+            else
+            {
+                size_t data_size = 0;
+                void* data = ImFileLoadToMemory(filename, "rb", &data_size);
+                font = atlas->AddFontFromMemoryTTF(data, (int)data_size, 20.0f);
+            }
+            ImGui::NewFrame();
+            ImGui::PushFont(font, 20.0f);
+            ImGui::CalcTextSize(text);
+            ImGui::PopFont();
+            ImGui::EndFrame();
+        }
+        const double t1 = GetTimeUs();
+        const size_t rss_after = GetResidentMemory();
+        printf("fontfile: %d atlases, %s: %6.1f ms, +%5.1f MB resident\n", atlases_count, shared ? "AddFontFromFileTTF()  " : "AddFontFromMemoryTTF()",
+            (t1 - t0) / 1000.0, (rss_after > rss_before ? rss_after - rss_before : 0) / (1024.0 * 1024.0));
+
+        if (shared)
+        {
+            const ImFontConfig& first_src = contexts[0]->IO.Fonts->Sources[0];
+            for (ImGuiContext* ctx : contexts)
+                if (ctx->IO.Fonts->Sources[0].FontDataShared == NULL || ctx->IO.Fonts->Sources[0].FontDataShared != first_src.FontDataShared || ctx->IO.Fonts->Sources[0].FontData != first_src.FontData)
+                {
+                    fprintf(stderr, "fontfile: atlases don't share font file data.\n");
+                    errors++;
+                    break;
+                }
+#ifndef _WIN32
+            // Replace file on disk (a mapped file can't be replaced on Windows): it must be loaded again, previous data must stay valid.
+            const char* new_filename = "example_null_selftest_font.ttf.new";
+            ImFontSharedFileData* new_shared_data = NULL;
+            if (WritePaddedFontFile(new_filename, font_data, font_data_size, file_size, 1) && rename(new_filename, filename) == 0)
+                new_shared_data = ImFontAtlasSharedFileDataAcquire(filename);
+            if (new_shared_data == NULL || new_shared_data == first_src.FontDataShared || ((const char*)new_shared_data->Data)[file_size - 1] != 1
+                || memcmp(first_src.FontData, font_data, font_data_size) != 0 || ((const char*)first_src.FontData)[file_size - 1] != 0)
+            {
+                fprintf(stderr, "fontfile: file replaced on disk wasn't loaded again.\n");
+                errors++;
+            }
+            if (new_shared_data != NULL)
+                ImFontAtlasSharedFileDataRelease(new_shared_data);
+#endif
+        }
+        for (ImGuiContext* ctx : contexts)
+            ImGui::DestroyContext(ctx);
+    }
+
+    // Last atlas released the data: acquiring the file again must load it again
+    if (ImFontSharedFileData* shared_data = ImFontAtlasSharedFileDataAcquire(filename))
+    {
+        if (shared_data->RefCount != 1)
+        {
+            fprintf(stderr, "fontfile: file data not released with the last atlas.\n");
+            errors++;
+        }
+        ImFontAtlasSharedFileDataRelease(shared_data);
+    }
+    remove(filename);
+    IM_FREE(font_data);
+    printf("fontfile: %d errors.\n", errors);
+    return errors > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Glyph rasterization (stb_truetype loader, SSE vs scalar path)
+//-----------------------------------------------------------------------------
+
+// Bake ASCII glyphs at sizes from 13 to 96 px with several oversampling factors, report glyphs per second and a checksum of atlas textures.
+// The 'default' (SSE) and 'nosse' variants must output the same checksum: pass the checksum of one to the other to compare them.
+static int TestRasterize(const char* font_filename, const char* expected_checksum)
+{
+    const int oversample_variants[][2] = { { 1, 1 }, { 2, 1 }, { 4, 2 }, { 7, 6 } };
+    const float size_variants[] = { 13.0f, 16.0f, 20.0f, 24.0f, 32.0f, 48.0f, 64.0f, 96.0f };
+    ImGuiID checksum = 0;
+    for (const int* oversample : oversample_variants)
+    {
+        CreateHeadlessContext();
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        ImFontConfig font_cfg;
+        font_cfg.OversampleH = (ImS8)oversample[0];
+        font_cfg.OversampleV = (ImS8)oversample[1];
+        ImFont* font = atlas->AddFontFromFileTTF(font_filename, 20.0f, &font_cfg);
+        if (font == NULL)
+        {
+            fprintf(stderr, "rasterize: could not load '%s'.\n", font_filename);
+            ImGui::DestroyContext();
+            return 1;
+        }
+        ImGui::NewFrame();
+
+        // Best of a few runs, discarding baked glyphs between runs
+        double best_time = 0.0;
+        int glyphs_count = 0;
+        for (int run_n = 0; run_n < 3; run_n++)
+        {
+            font->ClearOutputData();
+            glyphs_count = 0;
+            const double t0 = GetTimeUs();
+            for (const float size : size_variants)
+            {
+                ImFontBaked* baked = font->GetFontBaked(size);
+                for (ImWchar c = 33; c < 127; c++, glyphs_count++)
+                    baked->FindGlyph(c);
+            }
+            const double time = GetTimeUs() - t0;
+            best_time = (run_n == 0) ? time : ImMin(best_time, time);
+        }
+        ImGui::EndFrame();
+        for (ImTextureData* tex : atlas->TexList)
+            if (tex->Pixels != NULL)
+                checksum = ImHashData(tex->GetPixels(), (size_t)tex->GetSizeInBytes(), checksum);
+        printf("rasterize: oversample %dx%d, %d glyphs from 13 to 96 px: %8.0f glyphs/s\n", oversample[0], oversample[1], glyphs_count, glyphs_count * 1e6 / best_time);
+        ImGui::DestroyContext();
+    }
+
+    char checksum_str[16];
+    ImFormatString(checksum_str, IM_ARRAYSIZE(checksum_str), "0x%08X", checksum);
+    const bool mismatch = (expected_checksum != NULL && strcmp(checksum_str, expected_checksum) != 0);
+    if (mismatch)
+        fprintf(stderr, "rasterize: atlas textures checksum %s differs from expected %s.\n", checksum_str, expected_checksum);
+    printf("rasterize: checksum %s\n", checksum_str);
+    return mismatch ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Signed distance field glyphs (ImFontAtlasFlags_SDF)
+//-----------------------------------------------------------------------------
+
+// Coverage of a glyph at display pixel center 'p' (relative to the glyph origin), as a renderer would output it when drawing the glyph scaled by 'scale'.
+static float SampleGlyphCoverage(ImTextureData* tex, const ImFontGlyph* glyph, float scale, ImVec2 p)
+{
+    const ImVec2 q = ImVec2(p.x / scale, p.y / scale);
+    if (q.x < glyph->X0 || q.x >= glyph->X1 || q.y < glyph->Y0 || q.y >= glyph->Y1)
+        return 0.0f;
+    const ImVec2 uv(ImLerp(glyph->U0, glyph->U1, (q.x - glyph->X0) / (glyph->X1 - glyph->X0)), ImLerp(glyph->V0, glyph->V1, (q.y - glyph->Y0) / (glyph->Y1 - glyph->Y0)));
+    return ImTextureDataSampleSdf(tex, uv, 1.0f / scale);
+}
+
+// Bake alphanumeric glyphs as signed distance fields and as regular coverage (1x1 oversampling), at several display sizes.
+// Compare the coverage output for each display pixel by ImTextureDataSampleSdf() (what ImGuiBackendFlags_RendererHasSdfTextures backends output)
+// with the regular glyphs: the sum of differences, and the difference of total coverage, must stay under a fraction of the glyphs total coverage.
+static int TestSdf(const char* font_filename)
+{
+    const float display_sizes[] = { 13.0f, 16.0f, 20.0f, 28.0f, 40.0f, 64.0f, 100.0f };
+    const float max_error = 0.12f;
+    const float max_total_error = 0.08f;
+    ImGuiContext* ctx_plain = CreateHeadlessContext();
+    ImFontConfig font_cfg_plain;
+    font_cfg_plain.OversampleH = font_cfg_plain.OversampleV = 1;
+    ImFont* font_plain = ImGui::GetIO().Fonts->AddFontFromFileTTF(font_filename, 20.0f, &font_cfg_plain);
+    ImGuiContext* ctx_sdf = CreateHeadlessContext();
+    ImGui::GetIO().BackendFlags |= ImGuiBackendFlags_RendererHasSdfTextures;
+    ImGui::GetIO().Fonts->Flags |= ImFontAtlasFlags_SDF;
+    ImFont* font_sdf = ImGui::GetIO().Fonts->AddFontFromFileTTF(font_filename, 20.0f);
+    if (font_plain == NULL || font_sdf == NULL)
+    {
+        fprintf(stderr, "sdf: could not load '%s'.\n", font_filename);
+        ImGui::DestroyContext(ctx_sdf);
+        ImGui::DestroyContext(ctx_plain);
+        return 1;
+    }
+    ImGui::SetCurrentContext(ctx_plain);
+    ImGui::NewFrame();
+    ImGui::SetCurrentContext(ctx_sdf);
+    ImGui::NewFrame();
+
+    int errors = 0;
+    for (const float display_size : display_sizes)
+    {
+        ImFontBaked* baked_plain = font_plain->GetFontBaked(display_size);
+        ImFontBaked* baked_sdf = font_sdf->GetFontBaked(display_size);
+        const float scale_sdf = display_size / baked_sdf->Size;
+        const float sdf_offset_y = IM_ROUND(baked_sdf->Ascent) * scale_sdf - IM_ROUND(baked_plain->Ascent); // Each ImFontBaked rounds its own Ascent: compare glyph shapes, not line placement
+        double coverage_plain_total = 0.0, coverage_sdf_total = 0.0, coverage_diff = 0.0;
+        for (const char* p_c = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz"; *p_c != 0; p_c++)
+        {
+            const ImFontGlyph* glyph_plain = baked_plain->FindGlyph((ImWchar)*p_c);
+            const ImFontGlyph* glyph_sdf = baked_sdf->FindGlyph((ImWchar)*p_c);
+            ImTextureData* tex_plain = font_plain->ContainerAtlas->TexData;
+            ImTextureData* tex_sdf = font_sdf->ContainerAtlas->TexData;
+            const int x0 = (int)ImFloor(ImMin(glyph_plain->X0, glyph_sdf->X0 * scale_sdf)), x1 = (int)ImCeil(ImMax(glyph_plain->X1, glyph_sdf->X1 * scale_sdf));
+            const int y0 = (int)ImFloor(ImMin(glyph_plain->Y0, glyph_sdf->Y0 * scale_sdf - sdf_offset_y)), y1 = (int)ImCeil(ImMax(glyph_plain->Y1, glyph_sdf->Y1 * scale_sdf - sdf_offset_y));
+            for (int y = y0; y < y1; y++)
+                for (int x = x0; x < x1; x++)
+                {
+                    const ImVec2 p((float)x + 0.5f, (float)y + 0.5f);
+                    const float coverage_plain = SampleGlyphCoverage(tex_plain, glyph_plain, 1.0f, p);
+                    const float coverage_sdf = SampleGlyphCoverage(tex_sdf, glyph_sdf, scale_sdf, ImVec2(p.x, p.y + sdf_offset_y));
+                    coverage_plain_total += coverage_plain;
+                    coverage_sdf_total += coverage_sdf;
+                    coverage_diff += ImFabs(coverage_sdf - coverage_plain);
+                }
+        }
+        const float error = (float)(coverage_diff / ImMax(coverage_plain_total, 1.0));
+        const float total_ratio = (float)(coverage_sdf_total / ImMax(coverage_plain_total, 1.0));
+        printf("sdf: %5.1f px (scaled from %3.0f px): coverage error %5.2f%%, total coverage ratio %.3f\n", display_size, baked_sdf->Size, error * 100.0f, total_ratio);
+        if (!(error <= max_error) || !(ImFabs(total_ratio - 1.0f) <= max_total_error))
+        {
+            fprintf(stderr, "sdf: coverage at %.1f px differs from regular glyphs by more than %.0f%% (or total coverage by more than %.0f%%).\n", display_size, max_error * 100.0f, max_total_error * 100.0f);
+            errors++;
+        }
+    }
+    ImGui::DestroyContext(ctx_sdf);
+    ImGui::SetCurrentContext(ctx_plain);
+    ImGui::EndFrame();
+    ImGui::DestroyContext(ctx_plain);
+    printf("sdf: %d errors.\n", errors);
+    return errors > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Texture pages (ImFontAtlasFlags_MultiPage)
+//-----------------------------------------------------------------------------
+
+// Check packed rectangles of all pages: glyphs UV and page index match their rectangle, rectangles don't overlap,
+// and glyph pixels are the same as when they were loaded ('glyphs_pixels_hash': hash of baked id and codepoint -> hash of pixels).
+static int CheckAtlasPages(ImFontAtlas* atlas, ImGuiStorage* glyphs_pixels_hash)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    int errors = 0;
+    ImVector<ImBitVector> pages_used;
+    pages_used.resize(builder->Pages.Size);
+    for (int page_n = 0; page_n < builder->Pages.Size; page_n++)
+    {
+        memset((void*)&pages_used[page_n], 0, sizeof(ImBitVector));
+        pages_used[page_n].Create(builder->Pages[page_n].Tex->Width * builder->Pages[page_n].Tex->Height);
+    }
+    for (const ImFontAtlasRectEntry& index_entry : builder->RectsIndex)
+    {
+        if (!index_entry.IsUsed)
+            continue;
+        const ImTextureRect& r = builder->Rects[index_entry.TargetIndex];
+        const ImTextureData* tex = builder->Pages[builder->RectsPage[index_entry.TargetIndex]].Tex;
+        ImBitVector& used = pages_used[builder->RectsPage[index_entry.TargetIndex]];
+        if (r.x + r.w > tex->Width || r.y + r.h > tex->Height)
+        {
+            errors++;
+            continue;
+        }
+        for (int y = r.y; y < r.y + r.h; y++)
+            for (int x = r.x; x < r.x + r.w; x++)
+            {
+                errors += used.TestBit(y * tex->Width + x) ? 1 : 0;
+                used.SetBit(y * tex->Width + x);
+            }
+    }
+    for (ImBitVector& used : pages_used)
+        used.Clear();
+
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+    {
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        if (baked->WantDestroy)
+            continue;
+        for (const ImFontGlyph& glyph : baked->Glyphs)
+        {
+            if (glyph.PackId == ImFontAtlasRectId_Invalid)
+                continue;
+            ImTextureRect* r = ImFontAtlasPackGetRectSafe(atlas, glyph.PackId);
+            if (r == NULL || builder->RectsPage[builder->Rects.index_from_ptr(r)] != glyph.PageIdx || glyph.U0 != r->x * atlas->TexUvScale.x || glyph.V1 != (r->y + r->h) * atlas->TexUvScale.y)
+            {
+                errors++;
+                continue;
+            }
+            ImTextureData* tex = builder->Pages[glyph.PageIdx].Tex;
+            ImGuiID pixels_hash = 0;
+            for (int y = r->y; y < r->y + r->h; y++)
+                pixels_hash = ImHashData(tex->GetPixelsAt(r->x, y), (size_t)(r->w * tex->BytesPerPixel), pixels_hash);
+            const unsigned int codepoint = glyph.Codepoint;
+            const ImGuiID key = ImHashData(&codepoint, sizeof(codepoint), baked->BakedId);
+            if (int* stored_hash = glyphs_pixels_hash->GetIntRef(key, 0))
+            {
+                if (*stored_hash == 0)
+                    *stored_hash = (int)pixels_hash;
+                else if (*stored_hash != (int)pixels_hash)
+                    errors++;
+            }
+        }
+    }
+    return errors;
+}
+
+// Load glyphs at a new size every frame and keep using all previous sizes, while adding custom rectangles and removing most of them,
+// so pages get partially emptied. The atlas needs more than IM_FONTATLAS_PAGES_MAX pages over time and must reuse partially emptied pages.
+static int TestPages(const char* font_filename, int frames_count)
+{
+    CreateHeadlessContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    atlas->Flags |= ImFontAtlasFlags_MultiPage;
+    atlas->TexPageWidth = atlas->TexPageHeight = 256;
+    ImFont* font = atlas->AddFontFromFileTTF(font_filename, 20.0f);
+    if (font == NULL)
+    {
+        fprintf(stderr, "pages: could not load '%s'.\n", font_filename);
+        ImGui::DestroyContext();
+        return 1;
+    }
+
+    ImGuiStorage glyphs_pixels_hash;
+    ImGuiStorage pages_created;
+    ImVector<ImFontAtlasRectId> custom_rects;
+    int errors = 0;
+    for (int frame_n = 0; frame_n < frames_count; frame_n++)
+    {
+        ImGui::NewFrame();
+        for (int size_n = 0; size_n <= frame_n; size_n++)
+        {
+            ImFontBaked* baked = font->GetFontBaked(16.0f + size_n);
+            for (ImWchar c = '0'; c <= '9'; c++)
+                baked->FindGlyph(c);
+        }
+        for (int rect_n = 0; rect_n < 40; rect_n++)
+            custom_rects.push_back(atlas->AddCustomRect(16 + RandomInt(32), 16 + RandomInt(32)));
+        for (int rect_n = custom_rects.Size - 40; rect_n < custom_rects.Size; rect_n++)
+            if (RandomInt(10) != 0)
+                atlas->RemoveCustomRect(custom_rects[rect_n]);
+        ImGui::EndFrame();
+        ImGui::Render();
+        UpdateTexturesLikeBackend(atlas);
+        for (const ImFontAtlasPage& page : atlas->Builder->Pages)
+            pages_created.SetInt(page.Tex->UniqueID, 1);
+        errors += CheckAtlasPages(atlas, &glyphs_pixels_hash);
+    }
+    const int pages_alive = atlas->Builder->Pages.Size;
+    ImGui::DestroyContext();
+
+    printf("pages: %d frames, %d pages created, %d pages alive, %d errors.\n", frames_count, pages_created.Data.Size, pages_alive, errors);
+    if (pages_created.Data.Size <= IM_FONTATLAS_PAGES_MAX || pages_alive > IM_FONTATLAS_PAGES_MAX)
+    {
+        fprintf(stderr, "pages: expected more than %d pages created, and at most %d alive.\n", IM_FONTATLAS_PAGES_MAX, IM_FONTATLAS_PAGES_MAX);
+        errors++;
+    }
+    return errors > 0 ? 1 : 0;
+}
+
+// Alternate every 10 frames between text at 20 sizes (needing more pages than the budget allows) and text at a single size,
+// with ImFontAtlas::TexGlyphBudget set to 8 pages. Texture memory must go back under budget once the 20 sizes are not used anymore,
+// and evicted glyphs must be reloaded with the same pixels when used again.
+static int TestEvictPages(const char* font_filename, int frames_count)
+{
+    CreateHeadlessContext();
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    atlas->Flags |= ImFontAtlasFlags_MultiPage;
+    atlas->TexPageWidth = atlas->TexPageHeight = 256;
+    atlas->TexGlyphBudget = 8 * 256 * 256 * 4; // ImTextureFormat_RGBA32
+    ImFont* font = atlas->AddFontFromFileTTF(font_filename, 20.0f);
+    if (font == NULL)
+    {
+        fprintf(stderr, "evict: could not load '%s'.\n", font_filename);
+        ImGui::DestroyContext();
+        return 1;
+    }
+
+    ImGuiStorage glyphs_pixels_hash;
+    int errors = 0;
+    int max_pages_size = 0;
+    int max_idle_pages_size = 0;
+    for (int frame_n = 0; frame_n < frames_count; frame_n++)
+    {
+        const bool busy = ((frame_n / 10) & 1) == 0;
+        ImGui::NewFrame();
+        for (int size_n = 0; size_n < (busy ? 20 : 1); size_n++)
+        {
+            ImFontBaked* baked = font->GetFontBaked(16.0f + size_n * 4.0f);
+            for (ImWchar c = 33; c < 127; c++)
+                baked->FindGlyph(c);
+        }
+        ImGui::EndFrame();
+        ImGui::Render();
+        UpdateTexturesLikeBackend(atlas);
+        errors += CheckAtlasPages(atlas, &glyphs_pixels_hash);
+
+        int pages_size = 0;
+        for (const ImFontAtlasPage& page : atlas->Builder->Pages)
+            pages_size += page.Tex->GetSizeInBytes();
+        max_pages_size = ImMax(max_pages_size, pages_size);
+        if ((frame_n % 10) == 9 && !busy)
+            max_idle_pages_size = ImMax(max_idle_pages_size, pages_size);
+    }
+    const int budget = atlas->TexGlyphBudget;
+    ImGui::DestroyContext();
+
+    printf("evict: %d frames, budget %d KB, up to %d KB of pages, up to %d KB after idle frames, %d errors.\n", frames_count, budget / 1024, max_pages_size / 1024, max_idle_pages_size / 1024, errors);
+    if (max_pages_size <= budget || max_idle_pages_size > budget)
+    {
+        fprintf(stderr, "evict: expected pages to exceed budget when busy, and to fit within budget after idle frames.\n");
+        errors++;
+    }
+    return errors > 0 ? 1 : 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Deferred tessellation (io.ConfigDrawListsDeferTessellation)
+//-----------------------------------------------------------------------------
+
+// Render the demo window with and without io.ConfigDrawListsDeferTessellation and compare the output, including:
+// - a draw list owned by the application, recording deferred shapes, added with ImDrawData::AddDrawList() after Render().
+// - a copy of the foreground draw list made with CloneOutput() before Render() tessellated it.
+static ImGuiID RenderDeferTessellationFrames(bool defer, int frames_count)
+{
+    CreateHeadlessContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.ConfigDrawListsDeferTessellation = defer;
+    ImDrawList* user_draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    ImGuiID seed = 0;
+    for (int frame_n = 0; frame_n < frames_count; frame_n++)
+    {
+        io.AddMousePosEvent(200.0f + (float)((frame_n * 37) % 600), 100.0f + (float)((frame_n * 23) % 500));
+        ImGui::NewFrame();
+        ImGui::ShowDemoWindow();
+        ImDrawList* fg_draw_list = ImGui::GetForegroundDrawList();
+        fg_draw_list->AddCircle(ImVec2(300.0f, 300.0f), 50.0f + frame_n, IM_COL32(255, 255, 0, 255), 0, 2.0f);
+        ImDrawList* fg_clone = fg_draw_list->CloneOutput();
+        ImGui::Render();
+
+        user_draw_list->_ResetForNewFrame();
+        if (defer)
+            user_draw_list->Flags |= ImDrawListFlags_DeferTessellation;
+        user_draw_list->PushClipRectFullScreen();
+        user_draw_list->PushTexture(io.Fonts->TexRef);
+        user_draw_list->AddRectFilled(ImVec2(10.0f, 10.0f), ImVec2(100.0f + frame_n, 50.0f), IM_COL32(255, 0, 0, 255), 4.0f);
+        user_draw_list->AddBezierCubic(ImVec2(10.0f, 10.0f), ImVec2(200.0f, 10.0f), ImVec2(10.0f, 200.0f), ImVec2(200.0f, 200.0f + frame_n), IM_COL32(0, 255, 0, 255), 3.0f);
+        ImGui::GetDrawData()->AddDrawList(user_draw_list);
+
+        UpdateTexturesLikeBackend(io.Fonts);
+        for (const ImDrawList* draw_list : ImGui::GetDrawData()->CmdLists)
+            seed = HashDrawList(draw_list, seed);
+        seed = HashDrawList(fg_clone, seed);
+        IM_DELETE(fg_clone);
+    }
+    IM_DELETE(user_draw_list);
+    ImGui::DestroyContext();
+    return seed;
+}
+
+static int TestDeferTessellation(int frames_count)
+{
+    const ImGuiID immediate_hash = RenderDeferTessellationFrames(false, frames_count);
+    const ImGuiID deferred_hash = RenderDeferTessellationFrames(true, frames_count);
+    printf("defertess: %d frames, immediate 0x%08X, deferred 0x%08X.\n", frames_count, immediate_hash, deferred_hash);
+    if (immediate_hash != deferred_hash)
+    {
+        fprintf(stderr, "defertess: deferred tessellation output differs from immediate tessellation.\n");
+        return 1;
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Vertex/index data uploaded per frame (default vs IMGUI_USE_COMPACT_DRAWVERT layout)
+//-----------------------------------------------------------------------------
+
+// Render the demo window and the style editor, and report how many bytes of vertex and index data a renderer backend would upload per frame.
+// Compare the output of the 'default' and 'compact' variants. With IMGUI_DEBUG_PARANOID, vertices out of range of their ImDrawList::VtxOrigin assert.
+static int TestDrawVert(int frames_count)
+{
+    CreateHeadlessContext();
+    ImGuiIO& io = ImGui::GetIO();
+    size_t total_vtx = 0, total_idx = 0;
+    for (int frame_n = 0; frame_n < frames_count; frame_n++)
+    {
+        io.AddMousePosEvent(200.0f + (float)((frame_n * 37) % 600), 100.0f + (float)((frame_n * 23) % 500));
+        ImGui::NewFrame();
+        ImGui::ShowDemoWindow();
+        ImGui::SetNextWindowPos(ImVec2(800.0f, 20.0f));
+        ImGui::Begin("Dear ImGui Style Editor");
+        ImGui::ShowStyleEditor();
+        ImGui::End();
+        ImGui::Render();
+        UpdateTexturesLikeBackend(io.Fonts);
+        total_vtx += (size_t)ImGui::GetDrawData()->TotalVtxCount;
+        total_idx += (size_t)ImGui::GetDrawData()->TotalIdxCount;
+    }
+    ImGui::DestroyContext();
+
+    const size_t bytes = total_vtx * sizeof(ImDrawVert) + total_idx * sizeof(ImDrawIdx);
+    printf("drawvert: %d bytes per vertex, %d frames, %d vertices/frame, %d indices/frame, %d bytes/frame.\n",
+        (int)sizeof(ImDrawVert), frames_count, (int)(total_vtx / frames_count), (int)(total_idx / frames_count), (int)(bytes / frames_count));
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Word-wrap cache of large text blocks
+//-----------------------------------------------------------------------------
+
+// Submit large wrapped text blocks from buffers allocated at a different address every frame, as e.g. text rebuilt every frame would.
+// The cache (g.TextWrapCaches) must keep one entry per text block and not grow over time.
+static int TestTextWrapCache(int frames_count)
+{
+    CreateHeadlessContext();
+    ImGuiContext& g = *ImGui::GetCurrentContext();
+    ImVector<char*> buffers;
+    for (int frame_n = 0; frame_n < frames_count; frame_n++)
+    {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowSize(ImVec2(400.0f, 600.0f));
+        ImGui::Begin("Text");
+        ImGui::PushTextWrapPos(0.0f);
+        for (int block_n = 0; block_n < 2; block_n++)
+        {
+            char* buf = (char*)IM_ALLOC(8000 + frame_n); // Keep previous buffers alive so addresses are never reused
+            buffers.push_back(buf);
+            char* p = buf;
+            for (int word_n = 0; word_n < 800; word_n++)
+                p += sprintf(p, "%d%s", block_n * 1000 + word_n + frame_n / 10, (word_n % 17) == 16 ? "\n" : " ");
+            ImGui::TextUnformatted(buf, p);
+        }
+        ImGui::PopTextWrapPos();
+        ImGui::End();
+        ImGui::Render();
+    }
+    const int alive_count = g.TextWrapCaches.GetAliveCount();
+    const int keys_count = g.TextWrapCaches.GetMapSize();
+    ImGui::DestroyContext();
+    for (char* buf : buffers)
+        IM_FREE(buf);
+
+    printf("wrapcache: %d frames, %d entries, %d keys.\n", frames_count, alive_count, keys_count);
+    if (alive_count != 2 || keys_count != 2)
+    {
+        fprintf(stderr, "wrapcache: expected 2 entries and 2 keys.\n");
+        return 1;
+    }
+    return 0;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Multiple contexts in multiple threads (IMGUI_ENABLE_THREAD_LOCAL_CONTEXT)
+//-----------------------------------------------------------------------------
+
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+
+struct MultiContextClient
+{
+    int                 Index;
+    ImGuiContext*       Ctx;
+    ImVector<ImGuiID>   FrameHashes;
+};
+
+// Hash draw data vertices and indices, ignoring texture coordinates and draw commands:
+// glyphs are packed in the shared atlas in whichever order threads requested them, and a draw command is split
+// whenever the atlas texture gets replaced, so only those may differ between runs.
+static ImGuiID HashDrawDataGeometry(const ImDrawData* draw_data)
+{
+    ImGuiID seed = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        for (const ImDrawVert& vtx : draw_list->VtxBuffer)
+        {
+            const ImVec2 pos = ImDrawVertGetPos(&vtx, draw_list->VtxOrigin);
+            seed = ImHashData(&pos, sizeof(pos), seed);
+            seed = ImHashData(&vtx.col, sizeof(vtx.col), seed);
+        }
+        seed = ImHashData(draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes(), seed);
+    }
+    return seed;
+}
+
+// Run one frame of a client. Inputs and contents only depend on client index and frame number.
+static void MultiContextClientFrame(MultiContextClient* client, int frame_n)
+{
+    ImGui::SetCurrentContext(client->Ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.AddMousePosEvent(100.0f + (float)((frame_n * 37 + client->Index * 113) % 800), 50.0f + (float)((frame_n * 23 + client->Index * 71) % 600));
+    io.AddMouseButtonEvent(0, (frame_n % 20) >= 10 && (frame_n % 20) < 12);
+    ImGui::NewFrame();
+
+    ImGui::ShowDemoWindow();
+    ImGui::SetNextWindowPos(ImVec2(900.0f, 100.0f + client->Index * 10.0f));
+    ImGui::Begin("Client");
+    ImGui::Text("Client %d, frame %d", client->Index, frame_n);
+    for (int line_n = 0; line_n < 30; line_n++)
+    {
+        // Different sizes, so threads concurrently create ImFontBaked and load glyphs into them
+        ImGui::PushFont(NULL, 8.0f + (float)((line_n + client->Index + frame_n / 10) % 16) * 2.0f);
+        ImGui::TextWrapped("%d: The quick brown fox jumps over the lazy dog. %08X", line_n, (unsigned int)(client->Index * 7919 + line_n * frame_n));
+        ImGui::PopFont();
+    }
+    ImGui::End();
+
+    ImGui::Render();
+    client->FrameHashes.push_back(HashDrawDataGeometry(ImGui::GetDrawData()));
+}
+
+// Update shared atlas and honor texture requests like a renderer backend would. No other thread may use the atlas meanwhile.
+static void MultiContextUpdateAtlas(ImFontAtlas* atlas, int frame_n)
+{
+    for (ImTextureData* tex : atlas->TexList)
+    {
+        if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
+        {
+            tex->SetTexID((ImTextureID)(intptr_t)tex->UniqueID);
+            tex->SetStatus(ImTextureStatus_OK);
+        }
+        else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+        {
+            tex->SetTexID(ImTextureID_Invalid);
+            tex->SetStatus(ImTextureStatus_Destroyed);
+        }
+    }
+    ImFontAtlasUpdateNewFrame(atlas, frame_n + 1, true);
+}
+
+static void MultiContextRun(std::vector<MultiContextClient>& clients, int frames_count, bool parallel)
+{
+    ImFontAtlas* atlas = IM_NEW(ImFontAtlas)();
+    atlas->AddFontDefault();
+    for (int n = 0; n < (int)clients.size(); n++)
+    {
+        clients[n].Index = n;
+        clients[n].FrameHashes.resize(0);
+        clients[n].Ctx = CreateHeadlessContext(atlas);
+        ImGui::GetIO().ConfigTextSizeCache = true; // Invalidated by baked fonts discarded from any thread
+    }
+
+    for (int frame_n = 0; frame_n < frames_count; frame_n++)
+    {
+        MultiContextUpdateAtlas(atlas, frame_n);
+        if (parallel)
+        {
+            std::vector<std::thread> threads;
+            for (MultiContextClient& client : clients)
+                threads.emplace_back(MultiContextClientFrame, &client, frame_n);
+            for (std::thread& thread : threads)
+                thread.join();
+        }
+        else
+        {
+            for (MultiContextClient& client : clients)
+                MultiContextClientFrame(&client, frame_n);
+        }
+    }
+
+    for (MultiContextClient& client : clients)
+        ImGui::DestroyContext(client.Ctx);
+    IM_DELETE(atlas);
+}
+
+static int TestMultiContext(int threads_count, int frames_count)
+{
+    std::vector<MultiContextClient> serial_clients(threads_count), parallel_clients(threads_count);
+    MultiContextRun(serial_clients, frames_count, false);
+    MultiContextRun(parallel_clients, frames_count, true);
+
+    int errors = 0;
+    for (int client_n = 0; client_n < threads_count; client_n++)
+        for (int frame_n = 0; frame_n < frames_count; frame_n++)
+            if (serial_clients[client_n].FrameHashes[frame_n] != parallel_clients[client_n].FrameHashes[frame_n])
+            {
+                fprintf(stderr, "multicontext: client %d frame %d: output 0x%08X differs from serial run 0x%08X.\n", client_n, frame_n, parallel_clients[client_n].FrameHashes[frame_n], serial_clients[client_n].FrameHashes[frame_n]);
+                errors++;
+            }
+    printf("multicontext: %d contexts, %d frames, %d mismatches.\n", threads_count, frames_count, errors);
+    return errors > 0 ? 1 : 0;
+}
+
+#endif // #ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+
+//-----------------------------------------------------------------------------
+// [SECTION] Main
+//-----------------------------------------------------------------------------
+
+int main(int argc, char** argv)
+{
+    IMGUI_CHECKVERSION();
+    if (argc >= 2 && strcmp(argv[1], "polyline") == 0)
+        return TestPolyline();
+    if (argc >= 2 && strcmp(argv[1], "triangulate") == 0)
+        return TestTriangulate();
+    if (argc >= 2 && strcmp(argv[1], "utf8") == 0)
+        return TestUtf8();
+    if (argc >= 4 && strcmp(argv[1], "fontfile") == 0)
+        return TestFontFile(argv[2], atoi(argv[3]));
+    if (argc >= 3 && strcmp(argv[1], "rasterize") == 0)
+        return TestRasterize(argv[2], (argc >= 4) ? argv[3] : NULL);
+    if (argc >= 3 && strcmp(argv[1], "sdf") == 0)
+        return TestSdf(argv[2]);
+    if (argc >= 4 && strcmp(argv[1], "pages") == 0)
+        return TestPages(argv[2], atoi(argv[3]));
+    if (argc >= 4 && strcmp(argv[1], "evict") == 0)
+        return TestEvictPages(argv[2], atoi(argv[3]));
+    if (argc >= 3 && strcmp(argv[1], "defertess") == 0)
+        return TestDeferTessellation(atoi(argv[2]));
+    if (argc >= 3 && strcmp(argv[1], "drawvert") == 0)
+        return TestDrawVert(atoi(argv[2]));
+    if (argc >= 3 && strcmp(argv[1], "wrapcache") == 0)
+        return TestTextWrapCache(atoi(argv[2]));
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    if (argc >= 4 && strcmp(argv[1], "multicontext") == 0)
+        return TestMultiContext(atoi(argv[2]), atoi(argv[3]));
+#endif
+    fprintf(stderr, "Usage: %s polyline | triangulate | utf8 | fontfile <font> <atlases> | rasterize <font> [checksum] | sdf <font> | pages <font> <frames> | evict <font> <frames> | defertess <frames> | drawvert <frames> | wrapcache <frames> | multicontext <threads> <frames>\n", argv[0]);
+    return 1;
+}
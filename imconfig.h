@@ -27,6 +27,10 @@
 //#define IMGUI_API __declspec(dllimport)                   // MSVC Windows: DLL import
 //#define IMGUI_API __attribute__((visibility("default")))  // GCC/Clang: override visibility when set is hidden
 
+//---- Use thread local storage for the current context pointer, so N threads can each use their own context concurrently.
+// A ImFontAtlas shared by multiple contexts is then protected by a lock. Requires C++11. Not compatible with building as a DLL with MSVC (thread_local data cannot be exported).
+//#define IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+
 //---- Don't define obsolete functions/enums/behaviors. Consider enabling from time to time after updating to clean your code of obsolete function/names.
 //#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 
@@ -47,6 +51,7 @@
 //#define IMGUI_DISABLE_DEFAULT_MATH_FUNCTIONS              // Don't implement ImFabs/ImSqrt/ImPow/ImFmod/ImCos/ImSin/ImAcos/ImAtan2 so you can implement them yourself.
 //#define IMGUI_DISABLE_FILE_FUNCTIONS                      // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle at all (replace them with dummies)
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
+//#define IMGUI_DISABLE_FILE_MAPPING                        // Don't implement ImFileMapToMemory() with mmap()/MapViewOfFile(): AddFontFromFileTTF() will load fonts into heap memory.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
@@ -118,6 +123,14 @@
 // Read about ImGuiBackendFlags_RendererHasVtxOffset for details.
 //#define ImDrawIdx unsigned int
 
+//---- Use a compact 12 bytes vertex layout instead of the default 20 bytes one, reducing vertex data uploaded every frame.
+// Positions are stored as 16-bit fixed point values relative to ImDrawList::VtxOrigin, UV as 16-bit normalized values (see ImDrawVert).
+// Positions further than 4096 pixels from their draw list origin are clamped (asserting only with IMGUI_DEBUG_PARANOID), distorting any primitive crossing into the
+// visible area: clip your own geometry (e.g. canvas contents) if it may extend that far off-screen.
+// UV are limited to the [0,1] range and clamped: tiled UV (e.g. AddImage() with uv_max > 1 and a repeating sampler) are not supported.
+// Supported by renderer backends: imgui_impl_opengl3, imgui_impl_vulkan, imgui_impl_sdlrenderer2, imgui_impl_sdlrenderer3.
+//#define IMGUI_USE_COMPACT_DRAWVERT
+
 //---- Override ImDrawCallback signature (will need to modify renderer backends accordingly)
 //struct ImDrawList;
 //struct ImDrawCmd;
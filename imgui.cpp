@@ -1396,12 +1396,16 @@ static void             UpdateFontsEndFrame();
 static void             UpdateTexturesNewFrame();
 static void             UpdateTexturesEndFrame();
 static void             UpdateSettings();
+static ImGuiID          GetStyleRefreshHash(const ImGuiStyle& style);
 static int              UpdateWindowManualResize(ImGuiWindow* window, const ImVec2& size_auto_fit, int* border_hovered, int* border_held, int resize_grip_count, ImU32 resize_grip_col[4], const ImRect& visibility_rect);
 static void             RenderWindowOuterBorders(ImGuiWindow* window);
 static void             RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar_rect, bool title_bar_is_highlight, bool handle_borders_and_resize_grips, int resize_grip_count, const ImU32 resize_grip_col[4], float resize_grip_draw_size);
 static void             RenderWindowTitleBarContents(ImGuiWindow* window, const ImRect& title_bar_rect, const char* name, bool* p_open);
 static void             RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32 col);
 static void             RenderDimmedBackgrounds();
+static void             RenderFinalizeDrawLists();
+static void             RenderMergeDrawLists(ImGuiViewportP* viewport);
+static void             RenderOcclusionCulling(ImGuiViewportP* viewport);
 static void             SetLastItemDataForWindow(ImGuiWindow* window, const ImRect& rect);
 static void             SetLastItemDataForChildWindowItem(ImGuiWindow* window, const ImRect& rect);
 
@@ -1439,6 +1443,12 @@ static void             UpdateViewportPlatformMonitor(ImGuiViewportP* viewport);
 // - Important: Dear ImGui functions are not thread-safe because of this pointer.
 //   If you want thread-safety to allow N threads to access N different contexts:
 //   - Change this variable to use thread local storage so each thread can refer to a different context, in your imconfig.h:
+//         #define IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+//     Contexts may then share a ImFontAtlas: accesses to fonts are serialized by a lock (see ImFontAtlasLock()).
+//     Building the shared atlas and calling ImFontAtlasUpdateNewFrame() on it still needs to be done while other threads are not using it.
+//     ImFontGlyph* pointers are only valid while holding the lock. See examples/example_null_selftest/ for a multi-threaded usage example.
+//     MSVC cannot export thread_local variables from a DLL: with this define, Dear ImGui needs to be statically linked on Windows.
+//   - Alternatively, to use your own thread local storage, in your imconfig.h:
 //         struct ImGuiContext;
 //         extern thread_local ImGuiContext* MyImGuiTLS;
 //         #define GImGui MyImGuiTLS
@@ -1447,8 +1457,12 @@ static void             UpdateViewportPlatformMonitor(ImGuiViewportP* viewport);
 //   - If you need a finite number of contexts, you may compile and use multiple instances of the ImGui code from a different namespace.
 // - DLL users: read comments above.
 #ifndef GImGui
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+thread_local ImGuiContext* GImGui = NULL;
+#else
 ImGuiContext*   GImGui = NULL;
 #endif
+#endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // - You probably don't want to modify that mid-program, and if you use global/static e.g. ImVector<> instances you may need to keep them accessible during program destruction.
@@ -1650,6 +1664,10 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsCopyContentsWithCtrlC = false;
     ConfigScrollbarScrollByPage = true;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigDrawListsDeferTessellation = false;
+    ConfigDrawDataOcclusionCulling = false;
+    ConfigDrawDataMergeDrawLists = false;
+    ConfigTextSizeCache = false;
     ConfigDebugIsDebuggerPresent = false;
     ConfigDebugHighlightIdConflicts = true;
     ConfigDebugHighlightIdConflictsShowItemPicker = true;
@@ -2508,6 +2526,28 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
     return ~crc;
 }
 
+// 64-bit hash reading 8 bytes at a time, with a multiply-xorshift step per block.
+// Used to detect changes in text contents (e.g. io.ConfigTextSizeCache), where ImHashData() processing one byte at a time
+// without SSE 4.2 would cost about as much as measuring the text. Not for persistent storage: result depends on endianness.
+ImU64 ImHashData64(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const ImU64 k = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* data = (const unsigned char*)data_p;
+    ImU64 h = seed ^ (data_size * k);
+    for (; data_size >= 8; data_size -= 8, data += 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        h = (h ^ v) * k;
+        h ^= h >> 29;
+    }
+    ImU64 v = 0;
+    memcpy(&v, data, data_size);
+    h = (h ^ v) * k;
+    h ^= h >> 32;
+    return h;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -2588,6 +2628,127 @@ void*   ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_f
     return file_data;
 }
 
+// Helper: Map file content into read-only memory, avoiding a copy. Pages are loaded on demand and shared with other processes mapping the same file.
+// Return NULL if the file cannot be mapped or if file mapping is not supported: you may use ImFileLoadToMemory() instead.
+// Mapping bypasses ImFileOpen(), so it is unavailable when IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS is set.
+// - The mapping is private (MAP_PRIVATE) so our view can never be written back, but pages not yet read still reflect the file on disk.
+// - If another process truncates the file while it is mapped, reading pages past the new end raises SIGBUS on POSIX systems.
+//   Replacing the file (write to a new file + rename, as most installers and editors do) is safe. Windows refuses to truncate mapped files.
+// Helper: ImFileGetUniqueId() identifies a file regardless of the path used to open it, and changes when it is modified or replaced.
+#if !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && !defined(IMGUI_DISABLE_FILE_MAPPING)
+#if defined(_WIN32) && (defined(IMGUI_DISABLE_WIN32_FUNCTIONS) || (defined(WINAPI_FAMILY) && ((defined(WINAPI_FAMILY_APP) && WINAPI_FAMILY == WINAPI_FAMILY_APP) || (defined(WINAPI_FAMILY_GAMES) && WINAPI_FAMILY == WINAPI_FAMILY_GAMES))))
+#define IMGUI_DISABLE_FILE_MAPPING
+#elif !defined(_WIN32) && !defined(__unix__) && !defined(__APPLE__)
+#define IMGUI_DISABLE_FILE_MAPPING
+#endif
+#endif
+
+#if !defined(IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) && !defined(IMGUI_DISABLE_FILE_MAPPING)
+#ifdef _WIN32
+void*   ImFileMapToMemory(const char* filename, size_t* out_file_size)
+{
+    IM_ASSERT(filename && out_file_size);
+    *out_file_size = 0;
+    const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    ImVector<wchar_t> filename_wbuf;
+    filename_wbuf.resize(filename_wsize);
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_wbuf.Data, filename_wsize);
+
+    HANDLE file = ::CreateFileW(filename_wbuf.Data, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    LARGE_INTEGER file_size;
+    void* file_data = NULL;
+    if (::GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 && (ImU64)file_size.QuadPart <= (ImU64)(size_t)-1)
+        if (HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL))
+        {
+            file_data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            ::CloseHandle(mapping); // View keeps mapping alive
+        }
+    ::CloseHandle(file);
+    if (file_data != NULL)
+        *out_file_size = (size_t)file_size.QuadPart;
+    return file_data;
+}
+
+void    ImFileUnmap(void* file_data, size_t)
+{
+    ::UnmapViewOfFile(file_data);
+}
+
+ImU64   ImFileGetUniqueId(const char* filename)
+{
+    const int filename_wsize = ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, NULL, 0);
+    ImVector<wchar_t> filename_wbuf;
+    filename_wbuf.resize(filename_wsize);
+    ::MultiByteToWideChar(CP_UTF8, 0, filename, -1, filename_wbuf.Data, filename_wsize);
+
+    HANDLE file = ::CreateFileW(filename_wbuf.Data, 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return 0;
+    BY_HANDLE_FILE_INFORMATION info;
+    ImU64 id = 0;
+    if (::GetFileInformationByHandle(file, &info))
+    {
+        const DWORD id_data[7] = { info.dwVolumeSerialNumber, info.nFileIndexHigh, info.nFileIndexLow, info.nFileSizeHigh, info.nFileSizeLow, info.ftLastWriteTime.dwHighDateTime, info.ftLastWriteTime.dwLowDateTime };
+        id = ImHashData64(id_data, sizeof(id_data));
+    }
+    ::CloseHandle(file);
+    return id;
+}
+#else
+#include <fcntl.h>      // open
+#include <sys/mman.h>   // mmap
+#include <sys/stat.h>   // fstat
+#include <unistd.h>     // close
+void*   ImFileMapToMemory(const char* filename, size_t* out_file_size)
+{
+    IM_ASSERT(filename && out_file_size);
+    *out_file_size = 0;
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat st;
+    void* file_data = NULL;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        file_data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (file_data == MAP_FAILED)
+            file_data = NULL;
+    }
+    close(fd); // Mapping keeps file alive
+    if (file_data != NULL)
+        *out_file_size = (size_t)st.st_size;
+    return file_data;
+}
+
+void    ImFileUnmap(void* file_data, size_t file_size)
+{
+    munmap(file_data, file_size);
+}
+
+ImU64   ImFileGetUniqueId(const char* filename)
+{
+    struct stat st;
+    if (stat(filename, &st) != 0)
+        return 0;
+#if defined(__APPLE__)
+    const ImU64 mtime_nsec = (ImU64)st.st_mtimespec.tv_nsec;
+#elif defined(__linux__)
+    const ImU64 mtime_nsec = (ImU64)st.st_mtim.tv_nsec;
+#else
+    const ImU64 mtime_nsec = 0;
+#endif
+    const ImU64 id_data[5] = { (ImU64)st.st_dev, (ImU64)st.st_ino, (ImU64)st.st_size, (ImU64)st.st_mtime, mtime_nsec };
+    return ImHashData64(id_data, sizeof(id_data));
+}
+#endif
+#else
+void*   ImFileMapToMemory(const char*, size_t* out_file_size)   { *out_file_size = 0; return NULL; }
+void    ImFileUnmap(void*, size_t)                              { IM_ASSERT(0); }
+ImU64   ImFileGetUniqueId(const char*)                          { return 0; }
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 //-----------------------------------------------------------------------------
@@ -2604,6 +2765,14 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     static const uint32_t mins[] = { 0x400000, 0, 0x80, 0x800, 0x10000 };
     static const int shiftc[] = { 0, 18, 12, 6, 0 };
     static const int shifte[] = { 0, 6, 4, 2, 0 };
+
+    // Fast path for ASCII
+    if (*(const unsigned char*)in_text < 0x80 && (in_text_end == NULL || in_text < in_text_end))
+    {
+        *out_char = *(const unsigned char*)in_text;
+        return 1;
+    }
+
     int len = lengths[*(const unsigned char*)in_text >> 3];
     int wanted = len + (len ? 0 : 1);
 
@@ -2655,6 +2824,15 @@ int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const cha
     ImWchar* buf_end = buf + buf_size;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
+        // Fast path: copy runs of ASCII characters without decoding them.
+        // (without an end pointer we can't scan ahead safely, so null-terminated input goes through the decoder)
+        if (in_text_end && (unsigned char)*in_text < 0x80)
+        {
+            const char* run_end = ImTextFindNonAscii(in_text, ImMin(in_text_end, in_text + (buf_end - 1 - buf_out)), 1);
+            while (in_text < run_end)
+                *buf_out++ = (ImWchar)(unsigned char)*in_text++;
+            continue;
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         *buf_out++ = (ImWchar)c;
@@ -2670,6 +2848,13 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
     int char_count = 0;
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
+        if (in_text_end && (unsigned char)*in_text < 0x80)
+        {
+            const char* run_end = ImTextFindNonAscii(in_text, in_text_end, 1);
+            char_count += (int)(run_end - in_text);
+            in_text = run_end;
+            continue;
+        }
         unsigned int c;
         in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
         char_count++;
@@ -2677,6 +2862,26 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
     return char_count;
 }
 
+// Find the end of a run of ASCII characters in the [min_char..0x7F] range, e.g. use min_char = 32 to stop on control characters.
+// Test 16 (SSE2) or 32 (AVX2) bytes at a time: a signed compare rejects both bytes < min_char and bytes >= 0x80 (which are negative).
+const char* ImTextFindNonAscii(const char* in_text, const char* in_text_end, int min_char)
+{
+    IM_ASSERT(min_char >= 0 && min_char < 0x80);
+#if defined(IMGUI_ENABLE_SSE) && defined(__AVX2__)
+    const __m256i min_char_m1_256 = _mm256_set1_epi8((char)(min_char - 1));
+    while (in_text_end - in_text >= 32 && _mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_loadu_si256((const __m256i*)(const void*)in_text), min_char_m1_256)) == -1)
+        in_text += 32;
+#endif
+#ifdef IMGUI_ENABLE_SSE
+    const __m128i min_char_m1 = _mm_set1_epi8((char)(min_char - 1));
+    while (in_text_end - in_text >= 16 && _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_loadu_si128((const __m128i*)(const void*)in_text), min_char_m1)) == 0xFFFF)
+        in_text += 16;
+#endif
+    while (in_text < in_text_end && (unsigned char)*in_text >= (unsigned char)min_char && (unsigned char)*in_text < 0x80)
+        in_text++;
+    return in_text;
+}
+
 // Based on stb_to_utf8() from github.com/nothings/stb/
 static inline int ImTextCharToUtf8_inline(char* buf, int buf_size, unsigned int c)
 {
@@ -3944,18 +4149,25 @@ void ImGui::RenderTextEllipsis(ImDrawList* draw_list, const ImVec2& pos_min, con
         const float ellipsis_width = baked->GetCharAdvance(font->EllipsisChar) * font_scale;
 
         // We can now claim the space between pos_max.x and ellipsis_max.x
+        // Render text while finding where to cut it, in a single pass. Text always needs clipping here, as text_size.x > pos_max.x - pos_min.x.
+        // (this is equivalent to measuring with CalcTextSizeA() then calling RenderTextClippedEx() with text_end_ellipsis)
         const float text_avail_width = ImMax((ImMax(pos_max.x, ellipsis_max_x) - ellipsis_width) - pos_min.x, 1.0f);
-        float text_size_clipped_x = font->CalcTextSizeA(font_size, text_avail_width, 0.0f, text, text_end_full, &text_end_ellipsis).x;
+        ImVec4 cpu_fine_clip_rect(pos_min.x, pos_min.y, pos_max.x, pos_max.y);
+        ImVec4 clip_rect = draw_list->_CmdHeader.ClipRect;
+        clip_rect.x = ImMax(clip_rect.x, cpu_fine_clip_rect.x);
+        clip_rect.y = ImMax(clip_rect.y, cpu_fine_clip_rect.y);
+        clip_rect.z = ImMin(clip_rect.z, cpu_fine_clip_rect.z);
+        clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect.w);
+        float text_size_clipped_x = ImFontRenderTextMeasured(font, draw_list, font_size, pos_min, GetColorU32(ImGuiCol_Text), clip_rect, text, text_end_full, text_avail_width, true, &text_end_ellipsis).x;
         while (text_end_ellipsis > text && ImCharIsBlankA(text_end_ellipsis[-1]))
         {
             // Trim trailing space before ellipsis (FIXME: Supporting non-ascii blanks would be nice, for this we need a function to backtrack in UTF-8 text)
+            // Blanks have no visible glyph, so the text rendered above is unaffected.
             text_end_ellipsis--;
             text_size_clipped_x -= font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, text_end_ellipsis, text_end_ellipsis + 1).x; // Ascii blanks are always 1 byte
         }
 
-        // Render text, render ellipsis
-        RenderTextClippedEx(draw_list, pos_min, pos_max, text, text_end_ellipsis, &text_size, ImVec2(0.0f, 0.0f));
-        ImVec4 cpu_fine_clip_rect(pos_min.x, pos_min.y, pos_max.x, pos_max.y);
+        // Render ellipsis
         ImVec2 ellipsis_pos = ImTrunc(ImVec2(pos_min.x + text_size_clipped_x, pos_min.y));
         font->RenderChar(draw_list, font_size, ellipsis_pos, GetColorU32(ImGuiCol_Text), font->EllipsisChar, &cpu_fine_clip_rect);
     }
@@ -4045,6 +4257,7 @@ void ImGui::RenderMouseCursor(ImVec2 base_pos, float base_scale, ImGuiMouseCurso
         if (!viewport->GetMainRect().Overlaps(ImRect(pos, pos + ImVec2(size.x + 2, size.y + 2) * scale)))
             continue;
         ImDrawList* draw_list = GetForegroundDrawList(viewport);
+        IM_FONTATLAS_SCOPED_LOCK(font_atlas); // Atlas may be shared with contexts in other threads
         ImTextureRef tex_ref = font_atlas->TexRef;
         draw_list->PushTexture(tex_ref);
         draw_list->AddImage(tex_ref, pos + ImVec2(1, 0) * scale, pos + (ImVec2(1, 0) + size) * scale, uv[2], uv[3], col_shadow);
@@ -4166,6 +4379,9 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     InputEventsNextEventId = 1;
 
     WindowsActiveCount = 0;
+    WindowsRefreshHitsCount = WindowsRefreshMissesCount = 0;
+    WindowsRefreshStyleHash = 0;
+    OcclusionCulledDrawListsCount = OcclusionCulledDrawCmdsCount = OcclusionCulledVtxCount = OcclusionCulledIdxCount = 0;
     WindowsBorderHoverPadding = 0.0f;
     CurrentWindow = NULL;
     HoveredWindow = NULL;
@@ -4449,7 +4665,6 @@ void ImGui::Shutdown()
             IM_DELETE(atlas);
         }
     }
-    g.DrawListSharedData.TempBuffer.clear();
 
     // Cleanup of other data are conditional on actually having initialized Dear ImGui.
     if (!g.Initialized)
@@ -5193,6 +5408,10 @@ static ImDrawList* GetViewportBgFgDrawList(ImGuiViewportP* viewport, size_t draw
     if (viewport->BgFgDrawListsLastFrame[drawlist_no] != g.FrameCount)
     {
         draw_list->_ResetForNewFrame();
+        if (g.IO.ConfigDrawListsDeferTessellation)
+            draw_list->Flags |= ImDrawListFlags_DeferTessellation; // Tessellated by RenderFinalizeDrawLists()
+        draw_list->VtxOrigin = ImTrunc(viewport->Pos + viewport->Size * 0.5f);
+        IM_FONTATLAS_SCOPED_LOCK(g.IO.Fonts); // Atlas may be shared with contexts in other threads
         draw_list->PushTexture(g.IO.Fonts->TexRef);
         draw_list->PushClipRect(viewport->Pos, viewport->Pos + viewport->Size, false);
         viewport->BgFgDrawListsLastFrame[drawlist_no] = g.FrameCount;
@@ -5510,6 +5729,8 @@ static void ImGui::UpdateTexturesNewFrame()
     const bool has_textures = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) != 0;
     for (ImFontAtlas* atlas : g.FontAtlases)
     {
+        if (atlas->Flags & ImFontAtlasFlags_SDF)
+            IM_ASSERT_USER_ERROR(has_textures && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasSdfTextures), "ImFontAtlasFlags_SDF requires a renderer backend with ImGuiBackendFlags_RendererHasTextures and ImGuiBackendFlags_RendererHasSdfTextures!");
         if (atlas->OwnerContext == &g)
         {
             ImFontAtlasUpdateNewFrame(atlas, g.FrameCount, has_textures);
@@ -5532,6 +5753,8 @@ static void ImGui::UpdateTexturesEndFrame()
     ImGuiContext& g = *GImGui;
     g.PlatformIO.Textures.resize(0);
     for (ImFontAtlas* atlas : g.FontAtlases)
+    {
+        IM_FONTATLAS_SCOPED_LOCK(atlas);
         for (ImTextureData* tex : atlas->TexList)
         {
             // We provide this information so backends can decide whether to destroy textures.
@@ -5539,6 +5762,7 @@ static void ImGui::UpdateTexturesEndFrame()
             tex->RefCount = (unsigned short)atlas->RefCount;
             g.PlatformIO.Textures.push_back(tex);
         }
+    }
     for (ImTextureData* tex : g.UserTextures)
         g.PlatformIO.Textures.push_back(tex);
 }
@@ -5591,6 +5815,16 @@ void ImGui::NewFrame()
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
+    g.WindowsRefreshHitsCount = g.WindowsRefreshMissesCount = 0;
+    g.TextSizeCache.HitsCount = g.TextSizeCache.MissesCount = 0;
+
+    // Discard word-wrap caches of text which wasn't displayed last frame
+    for (int n = 0; n < g.TextWrapCaches.GetMapSize(); n++)
+        if (ImGuiTextWrapCache* cache = g.TextWrapCaches.TryGetMapData(n))
+            if (cache->LastFrameUsed < g.FrameCount - 1)
+                g.TextWrapCaches.Remove(cache->ID, cache);
+    if (g.TextWrapCaches.GetAliveCount() == 0 && g.TextWrapCaches.GetMapSize() > 0)
+        g.TextWrapCaches.Clear(); // Remove() leaves keys in the map: drop them once all entries are gone
     g.MenusIdSubmittedThisFrame.resize(0);
 
     // Calculate frame-rate for the user, as a purely luxurious feature
@@ -5613,6 +5847,7 @@ void ImGui::NewFrame()
     // Setup current font and draw list shared data
     SetupDrawListSharedData();
     UpdateFontsNewFrame();
+    g.WindowsRefreshStyleHash = GetStyleRefreshHash(g.Style);
 
     g.WithinFrameScope = true;
 
@@ -6190,7 +6425,10 @@ void ImGui::EndFrame()
 
     // Unlock font atlas
     for (ImFontAtlas* atlas : g.FontAtlases)
+    {
+        IM_FONTATLAS_SCOPED_LOCK(atlas);
         atlas->Locked = false;
+    }
 
     // Clear Input data for next frame
     g.IO.MousePosPrev = g.IO.MousePos;
@@ -6249,6 +6487,7 @@ void ImGui::Render()
 
     // Setup ImDrawData structures for end-user
     g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
+    g.OcclusionCulledDrawListsCount = g.OcclusionCulledDrawCmdsCount = g.OcclusionCulledVtxCount = g.OcclusionCulledIdxCount = 0;
     for (ImGuiViewportP* viewport : g.Viewports)
     {
         FlattenDrawDataIntoSingleLayer(&viewport->DrawDataBuilder);
@@ -6257,16 +6496,22 @@ void ImGui::Render()
         if (viewport->BgFgDrawLists[1] != NULL)
             AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[0], GetForegroundDrawList(viewport));
 
-        // We call _PopUnusedDrawCmd() last thing, as RenderDimmedBackgrounds() rely on a valid command being there (especially in docking branch).
+        // Cull hidden draw lists before they get finalized
+        if (g.IO.ConfigDrawDataOcclusionCulling)
+            RenderOcclusionCulling(viewport);
+
         ImDrawData* draw_data = &viewport->DrawDataP;
         IM_ASSERT(draw_data->CmdLists.Size == draw_data->CmdListsCount);
-        for (ImDrawList* draw_list : draw_data->CmdLists)
-            draw_list->_PopUnusedDrawCmd();
-
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
     }
 
+    // Finalize all draw lists of all viewports, one task per draw list
+    RenderFinalizeDrawLists();
+    if (g.IO.ConfigDrawDataMergeDrawLists)
+        for (ImGuiViewportP* viewport : g.Viewports)
+            RenderMergeDrawLists(viewport);
+
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures)
         for (ImFontAtlas* atlas : g.FontAtlases)
@@ -6276,6 +6521,167 @@ void ImGui::Render()
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
 }
 
+// Call 'task_func(task_data, n)' for each n in [0, task_count), using platform_io.Platform_ParallelForFn when provided.
+// Tasks must be independent and not call any ImGui:: function: output is then identical to the serial path.
+void ImGui::ParallelFor(void (*task_func)(void* task_data, int task_idx), void* task_data, int task_count)
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx != NULL && ctx->PlatformIO.Platform_ParallelForFn != NULL && task_count > 1)
+        ctx->PlatformIO.Platform_ParallelForFn(ctx, task_func, task_data, task_count);
+    else
+        for (int n = 0; n < task_count; n++)
+            task_func(task_data, n);
+}
+
+static void RenderFinalizeDrawListTask(void* task_data, int task_idx)
+{
+    ImDrawList* draw_list = ((ImDrawList**)task_data)[task_idx];
+    draw_list->_PopUnusedDrawCmd();
+    draw_list->_TessellateDeferredShapes(); // Shapes recorded with ImDrawListFlags_DeferTessellation
+}
+
+// Finalize all draw lists to be rendered, in parallel if a job system is provided.
+// Order of ImDrawData::CmdLists[] was decided by the caller, tasks only access their own draw list and don't allocate memory.
+// We call _PopUnusedDrawCmd() last thing, as RenderDimmedBackgrounds() rely on a valid command being there (especially in docking branch).
+static void ImGui::RenderFinalizeDrawLists()
+{
+    ImGuiContext& g = *GImGui;
+    g.DrawListsToFinalize.resize(0);
+    for (ImGuiViewportP* viewport : g.Viewports)
+        for (ImDrawList* draw_list : viewport->DrawDataP.CmdLists)
+            g.DrawListsToFinalize.push_back(draw_list);
+    ParallelFor(RenderFinalizeDrawListTask, g.DrawListsToFinalize.Data, g.DrawListsToFinalize.Size);
+}
+
+static bool IsRectOccluded(const ImVector<ImRect>& occluders, const ImRect& rect)
+{
+    for (const ImRect& occluder_rect : occluders)
+        if (occluder_rect.Contains(rect))
+            return true;
+    return false;
+}
+
+// Remove draw lists and draw commands hidden behind opaque window backgrounds in front of them (io.ConfigDrawDataOcclusionCulling)
+// - Draw lists are visited front to back, accumulating their ImDrawList::_OccluderRect. A draw list or command is culled when its
+//   clip rectangle(s) are contained in one of those rectangles. This is conservative: we don't test against their union.
+// - Draw lists containing callbacks are never culled as a whole, callback commands are never culled.
+// - Culled commands are removed from the window draw list, _OcclusionCulledCmds prevents reusing it with a refresh policy.
+static void ImGui::RenderOcclusionCulling(ImGuiViewportP* viewport)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    ImVector<ImRect>& occluders = g.OcclusionCullingRects;
+    occluders.resize(0);
+    int culled_lists_count = 0;
+    for (int list_n = draw_data->CmdLists.Size - 1; list_n >= 0; list_n--)
+    {
+        ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        if (occluders.Size > 0)
+        {
+            // Cull whole draw list
+            ImRect bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+            bool has_callbacks = false;
+            for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+            {
+                has_callbacks |= (cmd.UserCallback != NULL);
+                if (cmd.ElemCount > 0)
+                    bounds.Add(ImRect(cmd.ClipRect));
+            }
+            if (!has_callbacks && (bounds.IsInverted() || IsRectOccluded(occluders, bounds)))
+            {
+                g.OcclusionCulledDrawListsCount++;
+                g.OcclusionCulledVtxCount += draw_list->VtxBuffer.Size;
+                g.OcclusionCulledIdxCount += draw_list->IdxBuffer.Size;
+                draw_data->TotalVtxCount -= draw_list->VtxBuffer.Size;
+                draw_data->TotalIdxCount -= draw_list->IdxBuffer.Size;
+                draw_data->CmdLists[list_n] = NULL;
+                culled_lists_count++;
+                continue;
+            }
+
+            // Cull individual draw commands
+            int cmd_write_n = 0;
+            for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+            {
+                const ImDrawCmd& cmd = draw_list->CmdBuffer.Data[cmd_n];
+                if (cmd.UserCallback == NULL && cmd.ElemCount > 0 && IsRectOccluded(occluders, ImRect(cmd.ClipRect)))
+                {
+                    g.OcclusionCulledDrawCmdsCount++;
+                    g.OcclusionCulledIdxCount += cmd.ElemCount;
+                    continue;
+                }
+                if (cmd_write_n != cmd_n)
+                    draw_list->CmdBuffer.Data[cmd_write_n] = cmd;
+                cmd_write_n++;
+            }
+            if (cmd_write_n < draw_list->CmdBuffer.Size)
+            {
+                draw_list->CmdBuffer.resize(cmd_write_n);
+                draw_list->_OcclusionCulledCmds = true;
+            }
+        }
+        if (draw_list->_OccluderRect.z > draw_list->_OccluderRect.x)
+            occluders.push_back(ImRect(draw_list->_OccluderRect));
+    }
+
+    // Remove culled draw lists, preserving order
+    if (culled_lists_count > 0)
+    {
+        int list_write_n = 0;
+        for (ImDrawList* draw_list : draw_data->CmdLists)
+            if (draw_list != NULL)
+                draw_data->CmdLists[list_write_n++] = draw_list;
+        draw_data->CmdLists.resize(list_write_n);
+        draw_data->CmdListsCount = list_write_n;
+    }
+}
+
+// Replace runs of consecutive draw lists in the viewport ImDrawData with merged copies (io.ConfigDrawDataMergeDrawLists)
+// - Merged draw lists are owned by the viewport and reused every frame. Draw lists which cannot be merged are left as-is.
+// - A run is only copied once a second draw list can be appended to it.
+static void ImGui::RenderMergeDrawLists(ImGuiViewportP* viewport)
+{
+    ImGuiContext& g = *GImGui;
+    ImDrawData* draw_data = &viewport->DrawDataP;
+    const bool has_vtx_offset = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset) != 0;
+    int merged_count = 0;
+    int out_count = 0;
+    bool prev_is_merged = false;
+    for (ImDrawList* src_list : draw_data->CmdLists)
+    {
+        if (out_count > 0)
+        {
+            ImDrawList* prev_list = draw_data->CmdLists[out_count - 1];
+            if (prev_is_merged && prev_list->_MergeDrawList(src_list, has_vtx_offset))
+                continue;
+            if (!prev_is_merged)
+            {
+                if (merged_count == viewport->MergedDrawLists.Size)
+                {
+                    ImDrawList* new_list = IM_NEW(ImDrawList)(&g.DrawListSharedData);
+                    new_list->_OwnerName = "##MergedDrawList";
+                    viewport->MergedDrawLists.push_back(new_list);
+                }
+                ImDrawList* merged_list = viewport->MergedDrawLists[merged_count];
+                merged_list->CmdBuffer.resize(0);
+                merged_list->IdxBuffer.resize(0);
+                merged_list->VtxBuffer.resize(0);
+                if (merged_list->_MergeDrawList(prev_list, has_vtx_offset) && merged_list->_MergeDrawList(src_list, has_vtx_offset))
+                {
+                    draw_data->CmdLists[out_count - 1] = merged_list;
+                    prev_is_merged = true;
+                    merged_count++;
+                    continue;
+                }
+            }
+        }
+        draw_data->CmdLists[out_count++] = src_list;
+        prev_is_merged = false;
+    }
+    draw_data->CmdLists.resize(out_count);
+    draw_data->CmdListsCount = out_count;
+}
+
 // Calculate text size. Text can be multi-line. Optionally ignore text after a ## marker.
 // CalcTextSize("") should return ImVec2(0.0f, g.FontSize)
 ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_text_after_double_hash, float wrap_width)
@@ -6292,6 +6698,53 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
+
+    // Lookup in cross-frame cache (io.ConfigTextSizeCache)
+    // We rely on the 64-bit text hash being unique and don't store/compare text contents.
+    ImGuiTextSizeCacheEntry* cache_entry = NULL;
+    if (g.IO.ConfigTextSizeCache)
+    {
+        ImGuiTextSizeCache* cache = &g.TextSizeCache;
+        if (cache->Entries.Size == 0)
+        {
+            cache->Entries.resize(IM_TEXT_SIZE_CACHE_SIZE);
+            memset(cache->Entries.Data, 0, (size_t)cache->Entries.size_in_bytes());
+        }
+        if (text_display_end == NULL)
+            text_display_end = text + ImStrlen(text);
+        ImU64 seed = (ImU64)(size_t)g.FontBaked;
+        seed = ImHashData64(&font_size, sizeof(font_size), seed);
+        seed = ImHashData64(&wrap_width, sizeof(wrap_width), seed);
+        const ImU64 hash = ImHashData64(text, (size_t)(text_display_end - text), seed);
+        const int generation = ImFontAtlasGetBakedGeneration(font->ContainerAtlas);
+        ImGuiTextSizeCacheEntry* set = &cache->Entries.Data[(hash >> 32) & (IM_TEXT_SIZE_CACHE_SIZE - IM_TEXT_SIZE_CACHE_WAYS)];
+        cache_entry = &set[0];
+        for (int n = 0; n < IM_TEXT_SIZE_CACHE_WAYS; n++)
+        {
+            ImGuiTextSizeCacheEntry* entry = &set[n];
+            if (entry->Generation != generation)
+            {
+                cache_entry = entry; // Prefer replacing invalidated entries
+                continue;
+            }
+            if (entry->Hash == hash && entry->FontBaked == g.FontBaked && entry->FontSize == font_size && entry->WrapWidth == wrap_width)
+            {
+                entry->LastFrameUsed = g.FrameCount;
+                cache->HitsCount++;
+                return entry->TextSize;
+            }
+            if (cache_entry->Generation == generation && entry->LastFrameUsed < cache_entry->LastFrameUsed)
+                cache_entry = entry;
+        }
+        cache->MissesCount++;
+        cache_entry->Hash = hash;
+        cache_entry->LastFrameUsed = g.FrameCount;
+        cache_entry->Generation = generation;
+        cache_entry->FontBaked = g.FontBaked;
+        cache_entry->FontSize = font_size;
+        cache_entry->WrapWidth = wrap_width;
+    }
+
     ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
@@ -6301,6 +6754,8 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     // - https://embarkstudios.github.io/rust-gpu/api/src/libm/math/ceilf.rs.html
     text_size.x = IM_TRUNC(text_size.x + 0.99999f);
 
+    if (cache_entry != NULL)
+        cache_entry->TextSize = text_size;
     return text_size;
 }
 
@@ -7406,6 +7861,21 @@ void ImGui::RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar
             if (window->DockIsActive || (flags & ImGuiWindowFlags_DockNodeHost))
                 bg_draw_list->ChannelsSetCurrent(DOCKING_HOST_DRAW_CHANNEL_BG);
             bg_draw_list->AddRectFilled(window->Pos + ImVec2(0, window->TitleBarHeight), window->Pos + window->Size, bg_col, window_rounding, (flags & ImGuiWindowFlags_NoTitleBar) ? 0 : ImDrawFlags_RoundCornersBottom);
+
+            // Opaque background hides what's behind it (io.ConfigDrawDataOcclusionCulling). Exclude rounded corners.
+            // A docking host draws multiple backgrounds, keep the largest one.
+            if ((bg_col & IM_COL32_A_MASK) == IM_COL32_A_MASK)
+            {
+                ImRect occluder_rect(window->Pos + ImVec2(0, window->TitleBarHeight), window->Pos + window->Size);
+                if (flags & ImGuiWindowFlags_NoTitleBar)
+                    occluder_rect.Min.y += window_rounding;
+                occluder_rect.Max.y -= window_rounding;
+                if (window_rounding > 0.0f)
+                    occluder_rect.Expand(-1.0f); // Anti-aliased fringe
+                occluder_rect.ClipWithFull(ImRect(bg_draw_list->_CmdHeader.ClipRect));
+                if (!occluder_rect.IsInverted() && occluder_rect.GetArea() > ImRect(bg_draw_list->_OccluderRect).GetArea())
+                    bg_draw_list->_OccluderRect = occluder_rect.ToVec4();
+            }
             if (window->DockIsActive || (flags & ImGuiWindowFlags_DockNodeHost))
                 bg_draw_list->ChannelsSetCurrent(DOCKING_HOST_DRAW_CHANNEL_FG);
         }
@@ -7600,27 +8070,112 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
     }
 }
 
+// Hash of style fields affecting the contents of a window, for ImGuiWindowRefreshFlags_RefreshOnChange. Called once per frame by NewFrame().
+// Hashing explicit fields: the structure has padding bytes, which are not initialized.
+static ImGuiID ImGui::GetStyleRefreshHash(const ImGuiStyle& style)
+{
+    // All fields from FontSizeBase to MouseCursorScale are 4 bytes types (float, ImVec2, enums): no padding in between.
+    ImGuiID seed = ImHashData(&style.FontSizeBase, offsetof(ImGuiStyle, AntiAliasedLines) - offsetof(ImGuiStyle, FontSizeBase));
+    const bool anti_aliased[3] = { style.AntiAliasedLines, style.AntiAliasedLinesUseTex, style.AntiAliasedFill };
+    seed = ImHashData(anti_aliased, sizeof(anti_aliased), seed);
+    seed = ImHashData(&style.CurveTessellationTol, sizeof(style.CurveTessellationTol), seed);
+    seed = ImHashData(&style.CircleTessellationMaxError, sizeof(style.CircleTessellationMaxError), seed);
+    seed = ImHashData(style.UserSizes, sizeof(style.UserSizes), seed);
+    seed = ImHashData(style.Colors, sizeof(style.Colors), seed);
+    return seed;
+}
+
+// Hash of global state affecting the contents of a window, for ImGuiWindowRefreshFlags_RefreshOnChange.
+// Style is hashed once per frame in NewFrame(), then we only need to hash current values of pushed style variables and colors.
+static ImGuiID GetWindowRefreshStateHash()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiID seed = g.WindowsRefreshStyleHash;
+    for (const ImGuiStyleMod& mod : g.StyleVarStack)
+    {
+        const ImGuiStyleVarInfo* var_info = ImGui::GetStyleVarInfo(mod.VarIdx);
+        seed = ImHashData(&mod.VarIdx, sizeof(mod.VarIdx), seed);
+        seed = ImHashData(var_info->GetVarPtr(&g.Style), var_info->Count * sizeof(float), seed);
+    }
+    for (const ImGuiColorMod& mod : g.ColorStack)
+    {
+        seed = ImHashData(&mod.Col, sizeof(mod.Col), seed);
+        seed = ImHashData(&g.Style.Colors[mod.Col], sizeof(ImVec4), seed);
+    }
+    seed = ImHashData(&g.Font, sizeof(g.Font), seed);
+    seed = ImHashData(&g.FontSize, sizeof(g.FontSize), seed);
+    if (ImTextureData* tex = g.Font ? g.Font->ContainerAtlas->TexData : NULL) // Glyphs UV are invalidated when the atlas texture is recreated.
+        seed = ImHashData(&tex->UniqueID, sizeof(tex->UniqueID), seed);
+    return seed;
+}
+
+// For ImGuiWindowRefreshFlags_RefreshOnInput
+static bool IsWindowReceivingInputsForRefresh(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.ActiveId != 0 && g.ActiveIdWindow && g.ActiveIdWindow->RootWindow == window->RootWindow)
+        return true;
+    if (g.MovingWindow && g.MovingWindow->RootWindow == window->RootWindow)
+        return true;
+    const bool is_hovered = g.HoveredWindow && (window->RootWindow == g.HoveredWindow->RootWindow || ImGui::IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window));
+    const bool is_focused = g.NavWindow && (window->RootWindow == g.NavWindow->RootWindow || ImGui::IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window));
+    if (is_hovered && (g.IO.MousePos.x != g.IO.MousePosPrev.x || g.IO.MousePos.y != g.IO.MousePosPrev.y || ImGui::IsAnyMouseDown()))
+        return true;
+    for (const ImGuiInputEvent& e : g.InputEventsTrail)
+    {
+        if (is_hovered && (e.Type == ImGuiInputEventType_MouseWheel || e.Type == ImGuiInputEventType_MouseButton))
+            return true;
+        if (is_focused && (e.Type == ImGuiInputEventType_Key || e.Type == ImGuiInputEventType_Text || e.Type == ImGuiInputEventType_Focus))
+            return true;
+    }
+    return false;
+}
+
 // [EXPERIMENTAL] Called by Begin(). NextWindowData is valid at this point.
 // This is designed as a toy/test-bed for
 void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
     window->SkipRefresh = false;
+    window->RefreshFlags = ImGuiWindowRefreshFlags_None;
     if ((g.NextWindowData.HasFlags & ImGuiNextWindowDataFlags_HasRefreshPolicy) == 0)
         return;
-    if (g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_TryToAvoidRefresh)
-    {
-        // FIXME-IDLE: Tests for e.g. mouse clicks or keyboard while focused.
+    const ImGuiWindowRefreshFlags refresh_flags = window->RefreshFlags = g.NextWindowData.RefreshFlagsVal;
+    if (refresh_flags & ImGuiWindowRefreshFlags_TryToAvoidRefresh)
+    {
+        // Refresh when any of the conditions below is met.
+        // Contents refreshed on last frame are not reused right away, as layout changes are generally only visible on the next frame (e.g. scrollbars, auto-fit, hovered state after inputs).
+        const bool settling = window->RefreshSettling;
+        const ImGuiID state_hash = (refresh_flags & ImGuiWindowRefreshFlags_RefreshOnChange) ? GetWindowRefreshStateHash() : 0;
+        window->RefreshSettling = false;
+        bool refresh = true;
         if (window->Appearing) // If currently appearing
+            window->RefreshSettling = true;
+        else if (window->Hidden) // If was hidden (previous frame)
+            window->RefreshSettling = true;
+        else if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnHover) && g.HoveredWindow && (window->RootWindow == g.HoveredWindow->RootWindow || IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window)))
+            window->RefreshSettling = true;
+        else if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnFocus) && g.NavWindow && (window->RootWindow == g.NavWindow->RootWindow || IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window)))
+            window->RefreshSettling = true;
+        else if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnInput) && IsWindowReceivingInputsForRefresh(window))
+            window->RefreshSettling = true;
+        else if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnChange) && (window->RefreshInvalidated || window->RefreshLastStateHash != state_hash))
+            window->RefreshSettling = true;
+        else if ((refresh_flags & ImGuiWindowRefreshFlags_RefreshOnChange) && (window->Pos != window->RefreshLastPos || window->Size != window->RefreshLastSize || window->Scroll != window->RefreshLastScroll || window->ScrollTarget.x != FLT_MAX || window->ScrollTarget.y != FLT_MAX))
+            window->RefreshSettling = true;
+        else if (!settling && !window->DrawListInst._OcclusionCulledCmds) // Commands culled by io.ConfigDrawDataOcclusionCulling are missing from our last output
+            refresh = false;
+
+        if (refresh)
+        {
+            window->RefreshInvalidated = false;
+            window->RefreshLastStateHash = state_hash;
+            window->RefreshMissesCount++;
+            g.WindowsRefreshMissesCount++;
             return;
-        if (window->Hidden) // If was hidden (previous frame)
-            return;
-        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnHover) && g.HoveredWindow)
-            if (window->RootWindow == g.HoveredWindow->RootWindow || IsWindowWithinBeginStackOf(g.HoveredWindow->RootWindow, window))
-                return;
-        if ((g.NextWindowData.RefreshFlagsVal & ImGuiWindowRefreshFlags_RefreshOnFocus) && g.NavWindow)
-            if (window->RootWindow == g.NavWindow->RootWindow || IsWindowWithinBeginStackOf(g.NavWindow->RootWindow, window))
-                return;
+        }
+        window->RefreshHitsCount++;
+        g.WindowsRefreshHitsCount++;
         window->DrawList = NULL;
         window->SkipRefresh = true;
     }
@@ -7872,6 +8427,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
         window->DrawList->_ResetForNewFrame();
+        if (g.IO.ConfigDrawListsDeferTessellation)
+            window->DrawList->Flags |= ImDrawListFlags_DeferTessellation; // Tessellated by RenderFinalizeDrawLists()
         window->DC.CurrentTableIdx = -1;
         if (flags & ImGuiWindowFlags_DockNodeHost)
         {
@@ -8297,7 +8854,13 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // Setup draw list and outer clipping rectangle
         IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0);
-        window->DrawList->PushTexture(g.Font->ContainerAtlas->TexRef);
+        window->DrawList->VtxOrigin = ImTrunc(window->Pos + window->Size * 0.5f); // Keep vertices close to origin for IMGUI_USE_COMPACT_DRAWVERT
+        {
+            // With IMGUI_ENABLE_THREAD_LOCAL_CONTEXT, another thread may have replaced the shared atlas texture since our last ImFontAtlasSyncDrawListSharedData() call.
+            IM_FONTATLAS_SCOPED_LOCK(g.DrawListSharedData.FontAtlas);
+            ImFontAtlasSyncDrawListSharedData(g.DrawListSharedData.FontAtlas, &g.DrawListSharedData);
+            window->DrawList->PushTexture(g.DrawListSharedData.FontAtlasTexRef); // == g.Font->ContainerAtlas->TexRef
+        }
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
         // Child windows can render their decoration (bg color, border, scrollbars, etc.) within their parent to save a draw call (since 1.71)
@@ -8386,6 +8949,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->DC.MenuBarAppending = false;
         window->DC.MenuColumns.Update(style.ItemSpacing.x, window_just_activated_by_user);
         window->DC.TreeDepth = 0;
+        window->DC.TextWrapCacheCount = 0;
         window->DC.TreeHasStackDataDepthMask = window->DC.TreeRecordsClippedNodesY2Mask = 0x00;
         window->DC.ChildWindows.resize(0);
         window->DC.StateStorage = &window->StateStorage;
@@ -8626,6 +9190,12 @@ void ImGui::End()
         IM_ASSERT(window->DrawList == NULL);
         window->DrawList = &window->DrawListInst;
     }
+    else if (window->RefreshFlags & ImGuiWindowRefreshFlags_RefreshOnChange)
+    {
+        window->RefreshLastPos = window->Pos;
+        window->RefreshLastSize = window->Size;
+        window->RefreshLastScroll = window->Scroll;
+    }
 
     // Stop logging
     if (g.LogWindow == window) // FIXME: add more options for scope of logging
@@ -9137,6 +9707,17 @@ void ImGui::SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags)
     g.NextWindowData.RefreshFlagsVal = flags;
 }
 
+void ImGui::InvalidateWindowRefresh(ImGuiWindow* window)
+{
+    window->RefreshInvalidated = true;
+}
+
+void ImGui::InvalidateWindowRefresh(const char* name)
+{
+    if (ImGuiWindow* window = FindWindowByName(name))
+        InvalidateWindowRefresh(window);
+}
+
 ImDrawList* ImGui::GetWindowDrawList()
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -9367,7 +9948,10 @@ void ImGui::UpdateFontsNewFrame()
     ImGuiContext& g = *GImGui;
     if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0)
         for (ImFontAtlas* atlas : g.FontAtlases)
+        {
+            IM_FONTATLAS_SCOPED_LOCK(atlas);
             atlas->Locked = true;
+        }
 
     if (g.Style._NextFrameFontSizeBase != 0.0f)
     {
@@ -9422,6 +10006,7 @@ void ImGui::RegisterFontAtlas(ImFontAtlas* atlas)
     ImGuiContext& g = *GImGui;
     if (g.FontAtlases.Size == 0)
         IM_ASSERT(atlas == g.IO.Fonts);
+    IM_FONTATLAS_SCOPED_LOCK(atlas);
     atlas->RefCount++;
     g.FontAtlases.push_back(atlas);
     ImFontAtlasAddDrawListSharedData(atlas, &g.DrawListSharedData);
@@ -9431,6 +10016,7 @@ void ImGui::UnregisterFontAtlas(ImFontAtlas* atlas)
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(atlas->RefCount > 0);
+    IM_FONTATLAS_SCOPED_LOCK(atlas);
     ImFontAtlasRemoveDrawListSharedData(atlas, &g.DrawListSharedData);
     g.FontAtlases.find_erase(atlas);
     atlas->RefCount--;
@@ -9458,8 +10044,12 @@ void ImGui::SetCurrentFont(ImFont* font, float font_size_before_scaling, float f
         IM_ASSERT(font->Scale > 0.0f);
 #endif
         ImFontAtlas* atlas = font->ContainerAtlas;
+        IM_FONTATLAS_SCOPED_LOCK(atlas);
+        if (g.DrawListSharedData.FontAtlas != atlas)
+            g.DrawListSharedData.FontAtlasTexRef = atlas->TexRef;
         g.DrawListSharedData.FontAtlas = atlas;
         g.DrawListSharedData.Font = font;
+        ImFontAtlasSyncDrawListSharedData(atlas, &g.DrawListSharedData);
         ImFontAtlasUpdateDrawListsSharedData(atlas);
         if (g.CurrentWindow != NULL)
             g.CurrentWindow->DrawList->_SetTexture(atlas->TexRef);
@@ -9507,10 +10097,18 @@ void ImGui::UpdateCurrentFontSize(float restore_font_size_after_scaling)
     // - We may support it better later and remove this rounding.
     final_size = GetRoundedFontSize(final_size);
     final_size = ImMax(1.0f, final_size);
-    if (g.Font != NULL && (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures))
-        g.Font->CurrentRasterizerDensity = g.FontRasterizerDensity;
     g.FontSize = final_size;
-    g.FontBaked = (g.Font != NULL && window != NULL) ? g.Font->GetFontBaked(final_size) : NULL;
+    if (g.Font != NULL)
+    {
+        IM_FONTATLAS_SCOPED_LOCK(g.Font->ContainerAtlas); // Font may be shared with other contexts
+        if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures)
+            g.Font->CurrentRasterizerDensity = g.FontRasterizerDensity;
+        g.FontBaked = (window != NULL) ? g.Font->GetFontBaked(final_size) : NULL;
+    }
+    else
+    {
+        g.FontBaked = NULL;
+    }
     g.FontBakedScale = (g.Font != NULL && window != NULL) ? (g.FontSize / g.FontBaked->Size) : 0.0f;
     g.DrawListSharedData.FontSize = g.FontSize;
     g.DrawListSharedData.FontScale = g.FontBakedScale;
@@ -21597,6 +22195,7 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
 
     BeginDisabled();
     CheckboxFlags("io.BackendFlags: RendererHasTextures", &io.BackendFlags, ImGuiBackendFlags_RendererHasTextures);
+    CheckboxFlags("io.BackendFlags: RendererHasSdfTextures", &io.BackendFlags, ImGuiBackendFlags_RendererHasSdfTextures);
     EndDisabled();
     ShowFontSelector("Font");
     //BeginDisabled((io.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0);
@@ -21695,6 +22294,8 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
     const int discarded_surface_sqrt = (int)sqrtf((float)atlas->Builder->RectsDiscardedSurface);
     Text("Packed rects: %d, area: about %d px ~%dx%d px", atlas->Builder->RectsPackedCount, atlas->Builder->RectsPackedSurface, packed_surface_sqrt, packed_surface_sqrt);
     Text("incl. Discarded rects: %d, area: about %d px ~%dx%d px", atlas->Builder->RectsDiscardedCount, atlas->Builder->RectsDiscardedSurface, discarded_surface_sqrt, discarded_surface_sqrt);
+    if (atlas->TexGlyphBudget > 0)
+        Text("Used rects area: %d px, budget: %d px (%d KB)", atlas->Builder->RectsUsedSurface, atlas->TexGlyphBudget / atlas->TexData->BytesPerPixel, atlas->TexGlyphBudget / 1024);
 
     ImFontAtlasRectId highlight_r_id = ImFontAtlasRectId_Invalid;
     if (TreeNode("Rects Index", "Rects Index (%d)", atlas->Builder->RectsPackedCount)) // <-- Use count of used rectangles
@@ -21715,7 +22316,7 @@ void ImGui::ShowFontAtlas(ImFontAtlas* atlas)
                     if (IsItemHovered())
                         highlight_r_id = id;
                     TableNextColumn();
-                    Image(atlas->TexRef, ImVec2(r.w, r.h), r.uv0, r.uv1);
+                    Image(r.TexRef, ImVec2(r.w, r.h), r.uv0, r.uv1);
                 }
             EndTable();
         }
@@ -21762,7 +22363,7 @@ void ImGui::DebugNodeTexture(ImTextureData* tex, int int_id, const ImFontAtlasRe
         PopStyleVar();
 
         char texid_desc[30];
-        Text("Status = %s (%d), Format = %s (%d), UseColors = %d", ImTextureDataGetStatusName(tex->Status), tex->Status, ImTextureDataGetFormatName(tex->Format), tex->Format, tex->UseColors);
+        Text("Status = %s (%d), Format = %s (%d), UseColors = %d, IsSdf = %d", ImTextureDataGetStatusName(tex->Status), tex->Status, ImTextureDataGetFormatName(tex->Format), tex->Format, tex->UseColors, tex->IsSdf);
         Text("TexID = %s, BackendUserData = %p", FormatTextureIDForDebugDisplay(texid_desc, IM_ARRAYSIZE(texid_desc), tex->TexID), tex->BackendUserData);
         TreePop();
     }
@@ -21797,7 +22398,14 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     }
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+    Text("%d bytes of vertex/index data (%d bytes per vertex)", io.MetricsRenderVertices * (int)sizeof(ImDrawVert) + io.MetricsRenderIndices * (int)sizeof(ImDrawIdx), (int)sizeof(ImDrawVert));
     Text("%d visible windows, %d current allocations", io.MetricsRenderWindows, g.DebugAllocInfo.TotalAllocCount - g.DebugAllocInfo.TotalFreeCount);
+    if (g.WindowsRefreshHitsCount + g.WindowsRefreshMissesCount > 0)
+        Text("Windows refresh policy: %d hits, %d misses (this frame)", g.WindowsRefreshHitsCount, g.WindowsRefreshMissesCount);
+    if (io.ConfigDrawDataOcclusionCulling)
+        Text("Occlusion culling: %d draw lists, %d draw commands, %d vertices, %d indices culled", g.OcclusionCulledDrawListsCount, g.OcclusionCulledDrawCmdsCount, g.OcclusionCulledVtxCount, g.OcclusionCulledIdxCount);
+    if (io.ConfigTextSizeCache)
+        Text("Text size cache: %d hits, %d misses (this frame)", g.TextSizeCache.HitsCount, g.TextSizeCache.MissesCount);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -22659,7 +23267,7 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
         {
             ImVec2 triangle[3];
             for (int n = 0; n < 3; n++, idx_n++)
-                triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos;
+                triangle[n] = ImDrawVertGetPos(&vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n], draw_list->VtxOrigin);
             total_area += ImTriangleArea(triangle[0], triangle[1], triangle[2]);
         }
 
@@ -22680,9 +23288,10 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, ImGuiViewportP* viewport, con
                 for (int n = 0; n < 3; n++, idx_i++)
                 {
                     const ImDrawVert& v = vtx_buffer[idx_buffer ? idx_buffer[idx_i] : idx_i];
-                    triangle[n] = v.pos;
+                    const ImVec2 v_uv = ImDrawVertGetUV(&v);
+                    triangle[n] = ImDrawVertGetPos(&v, draw_list->VtxOrigin);
                     buf_p += ImFormatString(buf_p, buf_end - buf_p, "%s %04d: pos (%8.2f,%8.2f), uv (%.6f,%.6f), col %08X\n",
-                        (n == 0) ? "Vert:" : "     ", idx_i, v.pos.x, v.pos.y, v.uv.x, v.uv.y, v.col);
+                        (n == 0) ? "Vert:" : "     ", idx_i, triangle[n].x, triangle[n].y, v_uv.x, v_uv.y, v.col);
                 }
 
                 Selectable(buf, false);
@@ -22716,7 +23325,7 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
 
         ImVec2 triangle[3];
         for (int n = 0; n < 3; n++, idx_n++)
-            vtxs_rect.Add((triangle[n] = vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n].pos));
+            vtxs_rect.Add((triangle[n] = ImDrawVertGetPos(&vtx_buffer[idx_buffer ? idx_buffer[idx_n] : idx_n], draw_list->VtxOrigin)));
         if (show_mesh)
             out_draw_list->AddPolyline(triangle, 3, IM_COL32(255, 255, 0, 255), ImDrawFlags_Closed, 1.0f); // In yellow: mesh triangles
     }
@@ -22871,6 +23480,7 @@ void ImGui::DebugNodeFont(ImFont* font)
             const int surface_sqrt = (int)ImSqrt((float)baked->MetricsTotalSurface);
             Text("Ascent: %f, Descent: %f, Ascent-Descent: %f", baked->Ascent, baked->Descent, baked->Ascent - baked->Descent);
             Text("Texture Area: about %d px ~%dx%d px", baked->MetricsTotalSurface, surface_sqrt, surface_sqrt);
+            Text("Codepoint Index: %d pages, %d bytes", baked->IndexPages.Size, baked->IndexPagesMap.size_in_bytes() + baked->IndexPages.size_in_bytes());
             for (int src_n = 0; src_n < font->Sources.Size; src_n++)
             {
                 ImFontConfig* src = font->Sources[src_n];
@@ -22891,6 +23501,7 @@ void ImGui::DebugNodeFont(ImFont* font)
 
 void ImGui::DebugNodeFontGlyphesForSrcMask(ImFont* font, ImFontBaked* baked, int src_mask)
 {
+    IM_FONTATLAS_SCOPED_LOCK(font->ContainerAtlas); // We keep ImFontGlyph* pointers around
     ImDrawList* draw_list = GetWindowDrawList();
     const ImU32 glyph_col = GetColorU32(ImGuiCol_Text);
     const float cell_size = baked->Size * 1;
@@ -22951,7 +23562,7 @@ void ImGui::DebugNodeFontGlyph(ImFont* font, const ImFontGlyph* glyph)
     if (glyph->PackId >= 0)
     {
         ImTextureRect* r = ImFontAtlasPackGetRect(font->ContainerAtlas, glyph->PackId);
-        Text("PackId: %d (%dx%d rect at %d,%d)", glyph->PackId, r->w, r->h, r->x, r->y);
+        Text("PackId: %d (%dx%d rect at %d,%d, page %d)", glyph->PackId, r->w, r->h, r->x, r->y, glyph->PageIdx);
     }
     Text("SourceIdx: %d", glyph->SourceIdx);
 }
@@ -23097,6 +23708,8 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
     BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    if (window->RefreshFlags != ImGuiWindowRefreshFlags_None)
+        BulletText("RefreshFlags: 0x%X, SkipRefresh: %d, Hits: %d, Misses: %d", window->RefreshFlags, window->SkipRefresh, window->RefreshHitsCount, window->RefreshMissesCount);
     for (int layer = 0; layer < ImGuiNavLayer_COUNT; layer++)
     {
         ImRect r = window->NavRectRel[layer];
@@ -170,16 +170,18 @@ struct ImDrawData;                  // All draw command lists required to render
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
-struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default, 12 bytes with IMGUI_USE_COMPACT_DRAWVERT. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
 struct ImFontAtlasBuilder;          // Opaque storage for building a ImFontAtlas
+struct ImFontAtlasGlyphCache;       // Opaque storage for a persistent glyph cache loaded by ImFontAtlas::LoadGlyphCache()
 struct ImFontAtlasRect;             // Output of ImFontAtlas::GetCustomRect() when using custom rectangles.
 struct ImFontBaked;                 // Baked data for a ImFont at a given size.
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
 struct ImFontGlyphRangesBuilder;    // Helper to build glyph ranges from text/string data
 struct ImFontLoader;                // Opaque interface to a font loading backend (stb_truetype, FreeType etc.).
+struct ImFontSharedFileData;        // Opaque storage for font file data shared between atlases by AddFontFromFileTTF()
 struct ImTextureData;               // Specs and pixel storage for a texture used by Dear ImGui.
 struct ImTextureRect;               // Coordinates of a rectangle within a texture.
 struct ImColor;                     // Helper functions to create a color that can be converted to either u32 or float4 (*OBSOLETE* please avoid using)
@@ -1761,6 +1763,7 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if io.ConfigNavMoveSetMousePos is set).
     ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
     ImGuiBackendFlags_RendererHasTextures   = 1 << 4,   // Backend Renderer supports ImTextureData requests to create/update/destroy textures. This enables incremental texture updates and texture reloads.
+    ImGuiBackendFlags_RendererHasSdfTextures= 1 << 5,   // Backend Renderer supports ImTextureData::IsSdf: alpha of those textures is a signed distance field, thresholded around 0.5 in the fragment shader. This enables ImFontAtlasFlags_SDF.
 
     // [BETA] Viewports
     ImGuiBackendFlags_PlatformHasViewports  = 1 << 10,  // Backend Platform supports multiple viewports.
@@ -2477,6 +2480,10 @@ struct ImGuiIO
     bool        ConfigWindowsCopyContentsWithCtrlC; // = false      // [EXPERIMENTAL] CTRL+C copy the contents of focused window into the clipboard. Experimental because: (1) has known issues with nested Begin/End pairs (2) text output quality varies (3) text output is in submission order rather than spatial order.
     bool        ConfigScrollbarScrollByPage;    // = true           // Enable scrolling page by page when clicking outside the scrollbar grab. When disabled, always scroll to clicked location. When enabled, Shift+Click scrolls to clicked location.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigDrawListsDeferTessellation;// = false         // [EXPERIMENTAL] Record lines/rectangles/circles/paths in draw lists and tessellate them during Render(), one task per draw list. Tasks run in parallel if platform_io.Platform_ParallelForFn is set. Text is always tessellated immediately.
+    bool        ConfigDrawDataOcclusionCulling; // = false          // [EXPERIMENTAL] During Render(), remove draw lists and draw commands fully hidden behind opaque window backgrounds in front of them. Culled draw lists are not tessellated nor output. Draw lists containing callbacks are never culled.
+    bool        ConfigTextSizeCache;            // = false          // [EXPERIMENTAL] Cache results of CalcTextSize() across frames, keyed by a hash of text, font and wrap width. Repeated measurements of unchanged labels become a hash lookup. Invalidated when baked fonts are discarded. Hits/misses are displayed in the Metrics window.
+    bool        ConfigDrawDataMergeDrawLists;   // = false          // [EXPERIMENTAL] After Render(), concatenate consecutive draw lists of each ImDrawData into merged draw lists, merging draw commands sharing the same clip rectangle and texture. Reduces the number of buffer uploads and draw calls for backends where they are expensive. Draw lists containing callbacks are not merged.
 
     // Inputs Behaviors
     // (other variables, ones which are expected to be tweaked within UI code, are exposed in ImGuiStyle)
@@ -3233,7 +3240,21 @@ struct ImDrawCmd
 };
 
 // Vertex layout
-#ifndef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#if defined(IMGUI_USE_COMPACT_DRAWVERT)
+#ifdef IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT
+#error "IMGUI_USE_COMPACT_DRAWVERT and IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT cannot be used together!"
+#endif
+// Compact vertex layout (12 bytes), enabled by defining IMGUI_USE_COMPACT_DRAWVERT in imconfig.h. Renderer backends need to support it.
+// - pos: signed 16-bit fixed point, relative to ImDrawList::VtxOrigin: position = VtxOrigin + pos / IM_DRAWVERT_POS_SCALE.
+// - uv: unsigned 16-bit normalized: uv = uv / 65535. Limited to the [0,1] range: tiled UV (e.g. AddImage() with uv_max > 1 and a repeating sampler) are not supported.
+#define IM_DRAWVERT_POS_SCALE   8.0f    // 1/8th of a pixel precision, covering +/- 4096 pixels around ImDrawList::VtxOrigin.
+struct ImDrawVert
+{
+    ImS16   pos[2];
+    ImU16   uv[2];
+    ImU32   col;
+};
+#elif !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImDrawVert
 {
     ImVec2  pos;
@@ -3256,6 +3277,29 @@ struct ImDrawCmdHeader
     unsigned int    VtxOffset;
 };
 
+// [Internal] For use by ImDrawList when using ImDrawListFlags_DeferTessellation
+enum ImDrawListDeferredShapeType
+{
+    ImDrawListDeferredShapeType_Polyline,
+    ImDrawListDeferredShapeType_ConvexPolyFilled,
+};
+
+// [Internal] For use by ImDrawList when using ImDrawListFlags_DeferTessellation
+// Indices and vertices are reserved when recording the shape, only vertices are written later.
+struct ImDrawListDeferredShape
+{
+    ImDrawListDeferredShapeType Type;
+    ImDrawListFlags Flags;          // Draw list flags at the time of recording
+    ImDrawFlags     DrawFlags;
+    ImU32           Col;
+    float           Thickness;
+    float           FringeScale;
+    ImVec4          Uvs;            // TexUvLines[] entry for texture-based lines, TexUvWhitePixel in (x,y) otherwise
+    int             PointsOffset;   // Offset in ImDrawList::_DeferredPoints[]
+    int             PointsCount;
+    int             VtxOffset;      // Offset in ImDrawList::VtxBuffer[] of reserved vertices
+};
+
 // [Internal] For use by ImDrawListSplitter
 struct ImDrawChannel
 {
@@ -3309,6 +3353,7 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_DeferTessellation       = 1 << 4,  // Record polylines and convex fills (lines, rectangles, circles, paths) and write their vertices later in _TessellateDeferredShapes(). Set on window and viewport background/foreground draw lists when 'io.ConfigDrawListsDeferTessellation' is enabled: Render() tessellates them.
 };
 
 // Draw command list
@@ -3327,6 +3372,7 @@ struct ImDrawList
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
+    ImVec2                  VtxOrigin;          // Origin of vertex positions with IMGUI_USE_COMPACT_DRAWVERT, renderer backends need to add it back. Must not be changed once vertices have been added. Unused by default vertex layout.
 
     // [Internal, used while building lists]
     unsigned int            _VtxCurrentIdx;     // [Internal] generally == VtxBuffer.Size unless we are past 64K vertices, in which case this gets reset to 0.
@@ -3341,6 +3387,11 @@ struct ImDrawList
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
+    ImVector<ImDrawListDeferredShape> _DeferredShapes; // [Internal] shapes recorded with ImDrawListFlags_DeferTessellation, waiting for tessellation
+    ImVector<ImVec2>        _DeferredPoints;    // [Internal] points of _DeferredShapes[]
+    ImVector<ImVec2>        _TempBuffer;        // [Internal] temporary write buffer. Also used by _TessellateDeferredShapes(), so it is allocated when recording
+    ImVec4                  _OccluderRect;      // [Internal] opaque area drawn by this list (window background) hiding everything behind it, for io.ConfigDrawDataOcclusionCulling. Empty if none.
+    bool                    _OcclusionCulledCmds; // [Internal] set by Render() when some commands were removed by io.ConfigDrawDataOcclusionCulling
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData().
     // (advanced: you may create and use your own ImDrawListSharedData so you can use ImDrawList without ImGui, but that's more involved)
@@ -3388,6 +3439,15 @@ struct ImDrawList
     IMGUI_API void  AddConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
     IMGUI_API void  AddConcavePolyFilled(const ImVec2* points, int num_points, ImU32 col);
 
+    // Batched primitives
+    // - Submit 'count' shapes from separate arrays (one entry per shape): buffers are reserved once and vertices are written in a tight loop.
+    // - Output is identical to calling AddLine(), AddRectFilled() with no rounding, or AddCircleFilled() with an explicit segment count, once per shape.
+    //   (except that with 16-bit indices, draw commands may be split at a different point when crossing 64K vertices)
+    // - For AddCircleFilledBatch(), 'num_segments' is shared by all circles. Use "num_segments == 0" to derive it from the largest radius.
+    IMGUI_API void  AddLineBatch(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness = 1.0f);
+    IMGUI_API void  AddRectFilledBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count);
+    IMGUI_API void  AddCircleFilledBatch(const ImVec2* centers, const float* radii, const ImU32* cols, int count, int num_segments = 0);
+
     // Image primitives
     // - Read FAQ to understand what ImTextureID/ImTextureRef are.
     // - "p_min" and "p_max" represent the upper-left and lower-right corners of the rectangle.
@@ -3445,7 +3505,11 @@ struct ImDrawList
     IMGUI_API void  PrimRect(const ImVec2& a, const ImVec2& b, ImU32 col);      // Axis aligned rectangle (composed of two triangles)
     IMGUI_API void  PrimRectUV(const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, ImU32 col);
     IMGUI_API void  PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col);
+#ifndef IMGUI_USE_COMPACT_DRAWVERT
     inline    void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)    { _VtxWritePtr->pos = pos; _VtxWritePtr->uv = uv; _VtxWritePtr->col = col; _VtxWritePtr++; _VtxCurrentIdx++; }
+#else
+    IMGUI_API void  PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col);
+#endif
     inline    void  PrimWriteIdx(ImDrawIdx idx)                                     { *_IdxWritePtr = idx; _IdxWritePtr++; }
     inline    void  PrimVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)         { PrimWriteIdx((ImDrawIdx)_VtxCurrentIdx); PrimWriteVtx(pos, uv, col); } // Write vertex with unique index
 
@@ -3473,6 +3537,10 @@ struct ImDrawList
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
+    IMGUI_API void  _PrimConvexPolyFilled(const ImVec2* points, int num_points, ImU32 col);
+    IMGUI_API void  _AddDeferredShape(ImDrawListDeferredShapeType type, const ImVec2* points, int num_points, ImU32 col, ImDrawFlags flags, float thickness, const ImVec4& uvs, int temp_count);
+    IMGUI_API void  _TessellateDeferredShapes();
+    IMGUI_API bool  _MergeDrawList(const ImDrawList* src_list, bool has_vtx_offset);
 };
 
 // All draw data to render a Dear ImGui frame
@@ -3559,6 +3627,7 @@ struct ImTextureData
     int                 UnusedFrames;           // w    r   // In order to facilitate handling Status==WantDestroy in some backend: this is a count successive frames where the texture was not used. Always >0 when Status==WantDestroy.
     unsigned short      RefCount;               // w    r   // Number of contexts using this texture. Used during backend shutdown.
     bool                UseColors;              // w    r   // Tell whether our texture data is known to use colors (rather than just white + alpha).
+    bool                IsSdf;                  // w    r   // Tell whether alpha is a signed distance field (ImFontAtlasFlags_SDF): coverage = saturate((alpha - 0.5) / fwidth(alpha) + 0.5). See ImTextureDataSampleSdf() for a CPU reference.
     bool                WantDestroyNextFrame;   // rw   -   // [Internal] Queued to set ImTextureStatus_WantDestroy next frame. May still be used in the current frame.
 
     // Functions
@@ -3617,6 +3686,7 @@ struct ImFontConfig
     ImFont*         DstFont;                // Target font (as we merging fonts, multiple ImFontConfig may target the same font)
     const ImFontLoader* FontLoader;         // Custom font backend for this source (other use one stored in ImFontAtlas)
     void*           FontLoaderData;         // Font loader opaque storage (per font config)
+    ImFontSharedFileData* FontDataShared;   // Reference to file data loaded by AddFontFromFileTTF(), possibly memory-mapped and shared with other atlases. FontData points into it.
 
     IMGUI_API ImFontConfig();
 };
@@ -3628,11 +3698,13 @@ struct ImFontGlyph
     unsigned int    Colored : 1;        // Flag to indicate glyph is colored and should generally ignore tinting (make it usable with no shift on little-endian as this is used in loops)
     unsigned int    Visible : 1;        // Flag to indicate glyph has no visible pixels (e.g. space). Allow early out when rendering.
     unsigned int    SourceIdx : 4;      // Index of source in parent font
-    unsigned int    Codepoint : 26;     // 0x0000..0x10FFFF
+    unsigned int    Codepoint : 21;     // 0x0000..0x10FFFF
+    unsigned int    PageIdx : 5;        // [Internal] Index of atlas texture page holding the glyph pixels. Always 0 unless using ImFontAtlasFlags_MultiPage.
     float           AdvanceX;           // Horizontal distance to advance cursor/layout position.
     float           X0, Y0, X1, Y1;     // Glyph corners. Offsets from current cursor/layout position.
-    float           U0, V0, U1, V1;     // Texture coordinates for the current value of ImFontAtlas->TexRef. Cached equivalent of calling GetCustomRect() with PackId.
+    float           U0, V0, U1, V1;     // Texture coordinates for the current value of ImFontAtlas->TexRef (of texture page PageIdx with ImFontAtlasFlags_MultiPage). Cached equivalent of calling GetCustomRect() with PackId.
     int             PackId;             // [Internal] ImFontAtlasRectId value (FIXME: Cold data, could be moved elsewhere?)
+    int             LastUsedFrame;      // [Internal] Last frame the glyph was looked up for rendering. Used to evict least recently used glyphs when over ImFontAtlas::TexGlyphBudget.
 
     ImFontGlyph()   { memset(this, 0, sizeof(*this)); PackId = -1; }
 };
@@ -3666,6 +3738,7 @@ struct ImFontAtlasRect
     unsigned short  x, y;               // Position (in current texture)
     unsigned short  w, h;               // Size
     ImVec2          uv0, uv1;           // UV coordinates (in current texture)
+    ImTextureRef    TexRef;             // Texture holding the rectangle. Always == atlas->TexRef unless using ImFontAtlasFlags_MultiPage.
 
     ImFontAtlasRect() { memset(this, 0, sizeof(*this)); }
 };
@@ -3677,6 +3750,9 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
     ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory, allow support for point/nearest filtering). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_BatchGlyphRasterization = 1 << 3, // [EXPERIMENTAL] Lay out newly loaded glyphs immediately but rasterize them as one batch during the next ImFontAtlasUpdateNewFrame() call, in parallel if platform_io.Platform_ParallelForFn is set. The batch is fork/join: NewFrame() blocks until all glyphs are rasterized, so this shortens hitches on multi-core machines but doesn't move the work off the frame. Glyphs are blank until then. Requires ImGuiBackendFlags_RendererHasTextures. Only supported by the stb_truetype loader.
+    ImFontAtlasFlags_MultiPage          = 1 << 4,   // [EXPERIMENTAL] Stop growing the texture once it reaches TexPageWidth x TexPageHeight, and add more textures ("pages") of that size instead of growing and repacking. Existing pages are never moved or re-uploaded, until reaching 32 pages: the emptiest page is then repacked, and it is an error (assert) if all pages are more than 3/4 full. Text rendering switches texture per glyph as needed. Requires ImGuiBackendFlags_RendererHasTextures.
+    ImFontAtlasFlags_SDF                = 1 << 5,   // [EXPERIMENTAL] Rasterize glyphs as signed distance fields, so a few baked sizes (powers of two, 32 minimum) serve every font size. Implies ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoBakedLines. Custom rectangles (AddCustomRect()) are not supported, as their pixels would be thresholded too. Requires ImGuiBackendFlags_RendererHasTextures + ImGuiBackendFlags_RendererHasSdfTextures. Only supported by the stb_truetype loader.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -3704,7 +3780,7 @@ struct ImFontAtlas
     IMGUI_API ~ImFontAtlas();
     IMGUI_API ImFont*           AddFont(const ImFontConfig* font_cfg);
     IMGUI_API ImFont*           AddFontDefault(const ImFontConfig* font_cfg = NULL);
-    IMGUI_API ImFont*           AddFontFromFileTTF(const char* filename, float size_pixels = 0.0f, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);
+    IMGUI_API ImFont*           AddFontFromFileTTF(const char* filename, float size_pixels = 0.0f, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // File is memory-mapped when supported, and shared by all atlases loading the same filename.
     IMGUI_API ImFont*           AddFontFromMemoryTTF(void* font_data, int font_data_size, float size_pixels = 0.0f, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // Note: Transfer ownership of 'ttf_data' to ImFontAtlas! Will be deleted after destruction of the atlas. Set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedTTF(const void* compressed_font_data, int compressed_font_data_size, float size_pixels = 0.0f, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL); // 'compressed_font_data' still owned by caller. Compress with binary_to_compressed_c.cpp.
     IMGUI_API ImFont*           AddFontFromMemoryCompressedBase85TTF(const char* compressed_font_data_base85, float size_pixels = 0.0f, const ImFontConfig* font_cfg = NULL, const ImWchar* glyph_ranges = NULL);              // 'compressed_font_data_base85' still owned by caller. Compress with binary_to_compressed_c.cpp with -base85 parameter.
@@ -3713,6 +3789,13 @@ struct ImFontAtlas
     IMGUI_API void              Clear();                    // Clear everything (input fonts, output glyphs/textures)
     IMGUI_API void              CompactCache();             // Compact cached glyphs and texture.
 
+    // [EXPERIMENTAL] Persistent glyph cache, to skip rasterizing glyphs already baked by a previous run.
+    // - Call LoadGlyphCache() after adding fonts (or before, it doesn't matter), and SaveGlyphCache() e.g. before shutdown.
+    // - Glyphs are looked up by font data, size, rasterizer density and font loader settings. Anything missing or mismatching is rasterized normally.
+    // - Return false if the file is missing or invalid/incompatible (in which case the current cache, if any, is kept).
+    IMGUI_API bool              LoadGlyphCache(const char* filename);
+    IMGUI_API bool              SaveGlyphCache(const char* filename);
+
     // As we are transitioning toward a new font system, we expect to obsolete those soon:
     IMGUI_API void              ClearInputData();           // [OBSOLETE] Clear input data (all ImFontConfig structures including sizes, TTF data, glyph ranges, etc.) = all the data used to build the texture and fonts.
     IMGUI_API void              ClearFonts();               // [OBSOLETE] Clear input+output font data (same as ClearInputData() + glyphs storage, UV coordinates).
@@ -3769,6 +3852,7 @@ struct ImFontAtlas
     //   - IT WILL INVALIDATE RECTANGLE DATA SUCH AS UV COORDINATES. Always use latest values from GetCustomRect().
     //   - UV coordinates are associated to the current texture identifier aka 'atlas->TexRef'. Both TexRef and UV coordinates are typically changed at the same time.
     // - If you render colored output into your custom rectangles: set 'atlas->TexPixelsUseColors = true' as this may help some backends decide of preferred texture format.
+    //   Also pass 'colored = true': with TexDesiredFormat == ImTextureFormat_Alpha8 + ImFontAtlasFlags_MultiPage, the rectangle is then packed into a separate ImTextureFormat_RGBA32 page (see ImFontAtlasRect::TexRef).
     // - Read docs/FONTS.md for more details about using colorful icons.
     // - Note: this API may be reworked further in order to facilitate supporting e.g. multi-monitor, varying DPI settings.
     // - (Pre-1.92 names) ------------> (1.92 names)
@@ -3777,7 +3861,7 @@ struct ImFontAtlas
     //   - AddCustomRectRegular()   --> Renamed to AddCustomRect()
     //   - AddCustomRectFontGlyph() --> Prefer using custom ImFontLoader inside ImFontConfig
     //   - ImFontAtlasCustomRect    --> Renamed to ImFontAtlasRect
-    IMGUI_API ImFontAtlasRectId AddCustomRect(int width, int height, ImFontAtlasRect* out_r = NULL);// Register a rectangle. Return -1 (ImFontAtlasRectId_Invalid) on error.
+    IMGUI_API ImFontAtlasRectId AddCustomRect(int width, int height, ImFontAtlasRect* out_r = NULL, bool colored = false); // Register a rectangle. Return -1 (ImFontAtlasRectId_Invalid) on error.
     IMGUI_API void              RemoveCustomRect(ImFontAtlasRectId id);                             // Unregister a rectangle. Existing pixels will stay in texture until resized / garbage collected.
     IMGUI_API bool              GetCustomRect(ImFontAtlasRectId id, ImFontAtlasRect* out_r) const;  // Get rectangle coordinates for current texture. Valid immediately, never store this (read above)!
 
@@ -3787,12 +3871,16 @@ struct ImFontAtlas
 
     // Input
     ImFontAtlasFlags            Flags;              // Build flags (see ImFontAtlasFlags_)
-    ImTextureFormat             TexDesiredFormat;   // Desired texture format (default to ImTextureFormat_RGBA32 but may be changed to ImTextureFormat_Alpha8).
+    ImTextureFormat             TexDesiredFormat;   // Desired texture format (default to ImTextureFormat_RGBA32 but may be changed to ImTextureFormat_Alpha8 to use 4x less texture memory and upload bandwidth, if your backend supports it, e.g. imgui_impl_opengl3, imgui_impl_vulkan, imgui_impl_sdlrenderer3). With ImFontAtlasFlags_MultiPage, colored glyphs then go to separate ImTextureFormat_RGBA32 pages, otherwise they lose their colors.
+                                                    // Cost of the first colored glyph: all pages share the same size, so the Alpha8 page is repacked to TexPageWidth x TexPageHeight and a RGBA32 page of that size is added (1 MB + 4 MB with default 1024x1024 pages). Lower TexPageWidth/TexPageHeight if few colored glyphs are expected.
     int                         TexGlyphPadding;    // FIXME: Should be called "TexPackPadding". Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0 (will also need to set AntiAliasedLinesUseTex = false).
     int                         TexMinWidth;        // Minimum desired texture width. Must be a power of two. Default to 512.
     int                         TexMinHeight;       // Minimum desired texture height. Must be a power of two. Default to 128.
     int                         TexMaxWidth;        // Maximum desired texture width. Must be a power of two. Default to 8192.
     int                         TexMaxHeight;       // Maximum desired texture height. Must be a power of two. Default to 8192.
+    int                         TexPageWidth;       // Texture page width when using ImFontAtlasFlags_MultiPage. Must be a power of two. Default to 1024.
+    int                         TexPageHeight;      // Texture page height when using ImFontAtlasFlags_MultiPage. Must be a power of two. Default to 1024.
+    int                         TexGlyphBudget;     // [EXPERIMENTAL] Texture memory budget in bytes for packed glyphs and rectangles. When exceeded, glyphs unused for a few frames are evicted (least recently used first) and reloaded on demand. With ImFontAtlasFlags_MultiPage, the budget applies to the size of all pages: least recently used pages holding only such glyphs are evicted and destroyed. Default to 0 (no budget). Requires ImGuiBackendFlags_RendererHasTextures.
     void*                       UserData;           // Store your own atlas related user-data (if e.g. you have multiple font atlas).
 
     // Output
@@ -3806,7 +3894,7 @@ struct ImFontAtlas
     ImTextureData*              TexData;            // Latest texture.
 
     // [Internal]
-    ImVector<ImTextureData*>    TexList;            // Texture list (most often TexList.Size == 1). TexData is always == TexList.back(). DO NOT USE DIRECTLY, USE GetDrawData().Textures[]/GetPlatformIO().Textures[] instead!
+    ImVector<ImTextureData*>    TexList;            // Texture list (most often TexList.Size == 1). TexData is always == TexList.back(), unless using ImFontAtlasFlags_MultiPage. DO NOT USE DIRECTLY, USE GetDrawData().Textures[]/GetPlatformIO().Textures[] instead!
     bool                        Locked;             // Marked as locked during ImGui::NewFrame()..EndFrame() scope if TexUpdates are not supported. Any attempt to modify the atlas will assert.
     bool                        RendererHasTextures;// Copy of (BackendFlags & ImGuiBackendFlags_RendererHasTextures) from supporting context.
     bool                        TexIsBuilt;         // Set when texture was built matching current font input. Mostly useful for legacy IsBuilt() call.
@@ -3818,8 +3906,10 @@ struct ImFontAtlas
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
     int                         TexNextUniqueID;    // Next value to be stored in TexData->UniqueID
     int                         FontNextUniqueID;   // Next value to be stored in ImFont->FontID
+    int                         BakedGeneration;    // Incremented when a baked font or glyph is discarded, invalidating data derived from them (e.g. io.ConfigTextSizeCache). Use ImFontAtlasGetBakedGeneration() to read.
     ImVector<ImDrawListSharedData*> DrawListSharedDatas; // List of users for this atlas. Typically one per Dear ImGui context.
     ImFontAtlasBuilder*         Builder;            // Opaque interface to our data that doesn't need to be public and may be discarded when rebuilding.
+    ImFontAtlasGlyphCache*      GlyphCache;         // Opaque storage for persistent glyph cache, see LoadGlyphCache().
     const ImFontLoader*         FontLoader;         // Font loader opaque interface (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE). Don't set directly!
     const char*                 FontLoaderName;     // Font loader name (for display e.g. in About box) == FontLoader->Name
     void*                       FontLoaderData;     // Font backend opaque storage
@@ -3844,18 +3934,32 @@ struct ImFontAtlas
     //typedef ImFontGlyphRangesBuilder  GlyphRangesBuilder;      // OBSOLETED in 1.67+
 };
 
+// Codepoints of a ImFontBaked are indexed by pages of IM_FONTBAKED_INDEX_PAGE_SIZE codepoints, only allocated for ranges where glyphs were requested.
+#define IM_FONTBAKED_INDEX_PAGE_SHIFT   6
+#define IM_FONTBAKED_INDEX_PAGE_SIZE    (1 << IM_FONTBAKED_INDEX_PAGE_SHIFT)
+#define IM_FONTBAKED_INDEX_PAGE_MASK    (IM_FONTBAKED_INDEX_PAGE_SIZE - 1)
+
+// [Internal] A page of the ImFontBaked codepoint index.
+struct ImFontBakedIndexPage
+{
+    float                       AdvanceX[IM_FONTBAKED_INDEX_PAGE_SIZE]; // Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI). -1.0f if not loaded yet.
+    ImU16                       Lookup[IM_FONTBAKED_INDEX_PAGE_SIZE];   // Index into Glyphs[]. 0xFFFF if not loaded yet, 0xFFFE if not found.
+};
+
 // Font runtime data for a given size
 // Important: pointers to ImFontBaked are only valid for the current frame.
+// With IMGUI_ENABLE_THREAD_LOCAL_CONTEXT and an atlas shared by contexts in different threads, loading a glyph from any thread may reallocate Glyphs[]:
+// ImFontGlyph* pointers are only valid while holding the atlas lock (see ImFontAtlasLock() in imgui_internal.h).
 struct ImFontBaked
 {
-    // [Internal] Members: Hot ~20/24 bytes (for CalcTextSize)
-    ImVector<float>             IndexAdvanceX;      // 12-16 // out // Sparse. Glyphs->AdvanceX in a directly indexable way (cache-friendly for CalcTextSize functions which only this info, and are often bottleneck in large UI).
+    // [Internal] Members: Hot ~36/44 bytes (for CalcTextSize)
+    ImVector<ImU16>             IndexPagesMap;      // 12-16 // out // Sparse. Index into IndexPages[] by (codepoint >> IM_FONTBAKED_INDEX_PAGE_SHIFT). 0 = shared empty page.
+    ImVector<ImFontBakedIndexPage> IndexPages;      // 12-16 // out // Pages indexing glyphs by Unicode code-point (AdvanceX[], Lookup[]). IndexPages[0] is always empty.
     float                       FallbackAdvanceX;   // 4     // out // FindGlyph(FallbackChar)->AdvanceX
     float                       Size;               // 4     // in  // Height of characters/line, set during loading (doesn't change after loading)
     float                       RasterizerDensity;  // 4     // in  // Density this is baked at
 
-    // [Internal] Members: Hot ~28/36 bytes (for RenderText loop)
-    ImVector<ImU16>             IndexLookup;        // 12-16 // out // Sparse. Index glyphs by Unicode code-point.
+    // [Internal] Members: Hot ~16/20 bytes (for RenderText loop)
     ImVector<ImFontGlyph>       Glyphs;             // 12-16 // out // All glyphs.
     int                         FallbackGlyphIndex; // 4     // out // Index of FontFallbackChar
 
@@ -3876,6 +3980,7 @@ struct ImFontBaked
     IMGUI_API ImFontGlyph*      FindGlyphNoFallback(ImWchar c);     // Return NULL if glyph doesn't exist
     IMGUI_API float             GetCharAdvance(ImWchar c);
     IMGUI_API bool              IsGlyphLoaded(ImWchar c);
+    IMGUI_API void              LoadGlyphs(const ImWchar* glyph_ranges); // Load all glyphs of 'glyph_ranges' at once (same format as ImFontConfig::GlyphRanges). Font loaders supporting it (imgui_freetype) render them in parallel if platform_io.Platform_ParallelForFn is set.
 };
 
 // Font flags
@@ -4106,6 +4211,14 @@ struct ImGuiPlatformIO
     // [Experimental] Configure decimal point e.g. '.' or ',' useful for some languages (e.g. German), generally pulled from *localeconv()->decimal_point
     ImWchar     Platform_LocaleDecimalPoint;     // '.'
 
+    // Optional: Run tasks in parallel, e.g. using your job system
+    // Must call 'task_func(task_data, n)' for each n in [0, task_count), possibly concurrently, and return once all calls are completed.
+    // Tasks are independent and don't call any ImGui:: function. (default to run all tasks on the calling thread)
+    // Used by Render() to finalize draw lists (and tessellate them when io.ConfigDrawListsDeferTessellation is enabled), and by ImDrawData::ScaleClipRects()/DeIndexAllBuffers().
+    // Used by NewFrame() to rasterize glyphs of atlases using ImFontAtlasFlags_BatchGlyphRasterization.
+    void        (*Platform_ParallelForFn)(ImGuiContext* ctx, void (*task_func)(void* task_data, int task_idx), void* task_data, int task_count);
+    void*       Platform_ParallelForUserData;
+
     //------------------------------------------------------------------
     // Input - Interface with Renderer Backend
     //------------------------------------------------------------------
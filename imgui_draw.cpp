@@ -14,6 +14,7 @@ Index of this file:
 // [SECTION] Helpers ShadeVertsXXX functions
 // [SECTION] ImFontConfig
 // [SECTION] ImFontAtlas, ImFontAtlasBuilder
+// [SECTION] ImFontAtlas: glyph cache
 // [SECTION] ImFontAtlas: backend for stb_truetype
 // [SECTION] ImFontAtlas: glyph ranges helpers
 // [SECTION] ImFontGlyphRangesBuilder
@@ -41,6 +42,9 @@ Index of this file:
 
 #include <stdio.h>      // vsnprintf, sscanf, printf
 #include <stdint.h>     // intptr_t
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#include <mutex>        // std::recursive_mutex
+#endif
 
 // Visual Studio warnings
 #ifdef _MSC_VER
@@ -137,8 +141,10 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Glyphs rasterized by ImFontAtlasBuildRasterizePendingGlyphs() tasks pass this as stbtt_fontinfo::userdata, as IM_ALLOC() may update context data.
+struct ImFontAtlasStbTrueTypeAllocator { ImGuiMemAllocFunc AllocFunc; ImGuiMemFreeFunc FreeFunc; void* UserData; };
+#define STBTT_malloc(x,u)   ((u) ? ((ImFontAtlasStbTrueTypeAllocator*)(u))->AllocFunc(x, ((ImFontAtlasStbTrueTypeAllocator*)(u))->UserData) : IM_ALLOC(x))
+#define STBTT_free(x,u)     ((u) ? ((ImFontAtlasStbTrueTypeAllocator*)(u))->FreeFunc(x, ((ImFontAtlasStbTrueTypeAllocator*)(u))->UserData) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -464,6 +470,10 @@ void ImDrawList::_ResetForNewFrame()
     _CallbacksDataBuf.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
+    _DeferredShapes.resize(0);
+    _DeferredPoints.resize(0);
+    _OccluderRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    _OcclusionCulledCmds = false;
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = _Data->InitialFringeScale;
 }
@@ -474,6 +484,7 @@ void ImDrawList::_ClearFreeMemory()
     IdxBuffer.clear();
     VtxBuffer.clear();
     Flags = ImDrawListFlags_None;
+    VtxOrigin = ImVec2(0.0f, 0.0f);
     _VtxCurrentIdx = 0;
     _VtxWritePtr = NULL;
     _IdxWritePtr = NULL;
@@ -482,6 +493,11 @@ void ImDrawList::_ClearFreeMemory()
     _CallbacksDataBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _DeferredShapes.clear();
+    _DeferredPoints.clear();
+    _TempBuffer.clear();
+    _OccluderRect = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    _OcclusionCulledCmds = false;
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
@@ -490,7 +506,17 @@ ImDrawList* ImDrawList::CloneOutput() const
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
     dst->VtxBuffer = VtxBuffer;
-    dst->Flags = Flags;
+    dst->Flags = Flags & ~ImDrawListFlags_DeferTessellation;
+    dst->VtxOrigin = VtxOrigin;
+
+    // Tessellate shapes recorded with ImDrawListFlags_DeferTessellation into the copy
+    if (_DeferredShapes.Size > 0)
+    {
+        dst->_DeferredShapes = _DeferredShapes;
+        dst->_DeferredPoints = _DeferredPoints;
+        dst->_TempBuffer.reserve_discard(_TempBuffer.Capacity);
+        dst->_TessellateDeferredShapes();
+    }
     return dst;
 }
 
@@ -751,10 +777,10 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv; _VtxWritePtr[3].col = col;
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[0], a.x, a.y, uv, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[1], b.x, b.y, uv, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[2], c.x, c.y, uv, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[3], d.x, d.y, uv, col, VtxOrigin);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -766,10 +792,10 @@ void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[0], a.x, a.y, uv_a, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[1], b.x, b.y, uv_b, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[2], c.x, c.y, uv_c, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[3], d.x, d.y, uv_d, col, VtxOrigin);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
@@ -780,15 +806,24 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
-    _VtxWritePtr[0].pos = a; _VtxWritePtr[0].uv = uv_a; _VtxWritePtr[0].col = col;
-    _VtxWritePtr[1].pos = b; _VtxWritePtr[1].uv = uv_b; _VtxWritePtr[1].col = col;
-    _VtxWritePtr[2].pos = c; _VtxWritePtr[2].uv = uv_c; _VtxWritePtr[2].col = col;
-    _VtxWritePtr[3].pos = d; _VtxWritePtr[3].uv = uv_d; _VtxWritePtr[3].col = col;
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[0], a.x, a.y, uv_a, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[1], b.x, b.y, uv_b, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[2], c.x, c.y, uv_c, col, VtxOrigin);
+    IM_DRAWVERT_WRITE(&_VtxWritePtr[3], d.x, d.y, uv_d, col, VtxOrigin);
     _VtxWritePtr += 4;
     _VtxCurrentIdx += 4;
     _IdxWritePtr += 6;
 }
 
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+void ImDrawList::PrimWriteVtx(const ImVec2& pos, const ImVec2& uv, ImU32 col)
+{
+    IM_DRAWVERT_WRITE(_VtxWritePtr, pos.x, pos.y, uv, col, VtxOrigin);
+    _VtxWritePtr++;
+    _VtxCurrentIdx++;
+}
+#endif
+
 // On AddPolyline() and AddConvexPolyFilled() we intentionally avoid using ImVec2 and superfluous function calls to optimize debug/non-inlined builds.
 // - Those macros expects l-values and need to be used as their own statement.
 // - Those macros are intentionally not surrounded by the 'do {} while (0)' idiom because even that translates to runtime with debug compilers.
@@ -796,24 +831,140 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_FIXNORMAL2F_MAX_INVLEN2          100.0f // 500.0f (see #4053, #3366)
 #define IM_FIXNORMAL2F(VX,VY)               { float d2 = VX*VX + VY*VY; if (d2 > 0.000001f) { float inv_len2 = 1.0f / d2; if (inv_len2 > IM_FIXNORMAL2F_MAX_INVLEN2) inv_len2 = IM_FIXNORMAL2F_MAX_INVLEN2; VX *= inv_len2; VY *= inv_len2; } } (void)0
 
-// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
-// We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
-void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
-{
-    if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
-        return;
+// Compute normals of 'count' segments, segment i going from points[i] to points[(i + 1) % points_count].
+// - The SSE path processes 4 segments at a time and is bit-exact with the scalar path: _mm_rsqrt_ps() matches the _mm_rsqrt_ss() used by ImRsqrt().
+static void ImDrawList_CalcSegmentNormals(const ImVec2* points, const int points_count, const int count, ImVec2* out_normals)
+{
+    int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+    // Last block must not read past 'points_count', the wrapping segment (if any) is handled by the scalar loop.
+    const __m128 zero = _mm_setzero_ps();
+    for (; i1 + 4 < points_count && i1 + 4 <= count; i1 += 4)
+    {
+        const __m128 p01 = _mm_loadu_ps(&points[i1].x);     // x0 y0 x1 y1
+        const __m128 p23 = _mm_loadu_ps(&points[i1 + 2].x); // x2 y2 x3 y3
+        const __m128 p12 = _mm_loadu_ps(&points[i1 + 1].x); // x1 y1 x2 y2
+        const __m128 p34 = _mm_loadu_ps(&points[i1 + 3].x); // x3 y3 x4 y4
+        const __m128 ax = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 ay = _mm_shuffle_ps(p01, p23, _MM_SHUFFLE(3, 1, 3, 1));
+        const __m128 bx = _mm_shuffle_ps(p12, p34, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 by = _mm_shuffle_ps(p12, p34, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 dx = _mm_sub_ps(bx, ax);
+        __m128 dy = _mm_sub_ps(by, ay);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        const __m128 mask = _mm_cmpgt_ps(d2, zero);
+        const __m128 inv_len = _mm_or_ps(_mm_and_ps(mask, _mm_rsqrt_ps(d2)), _mm_andnot_ps(mask, _mm_set1_ps(1.0f)));
+        dx = _mm_mul_ps(dx, inv_len);
+        dy = _mm_mul_ps(dy, inv_len);
+        const __m128 nx = dy;                       // Normal is (dy, -dx)
+        const __m128 ny = _mm_xor_ps(dx, _mm_set1_ps(-0.0f));
+        _mm_storeu_ps(&out_normals[i1].x, _mm_unpacklo_ps(nx, ny));
+        _mm_storeu_ps(&out_normals[i1 + 2].x, _mm_unpackhi_ps(nx, ny));
+    }
+#ifdef IMGUI_DEBUG_PARANOID
+    // Verify SSE output against the scalar path
+    for (int n = 0; n < i1; n++)
+    {
+        float dx = points[n + 1].x - points[n].x;
+        float dy = points[n + 1].y - points[n].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        IM_ASSERT(out_normals[n].x == dy && out_normals[n].y == -dx);
+    }
+#endif
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+// Compute averaged and length-fixed normals (miter direction) at each point, from the normals of the two adjacent segments.
+// - out_miters[i] is computed from normals[i - 1] and normals[i]. out_miters[0] is only computed when 'closed' is set (wrapping around).
+// - The SSE path processes 4 points at a time and is bit-exact with the scalar path.
+static void ImDrawList_CalcPointMiters(const ImVec2* normals, const int points_count, const bool closed, ImVec2* out_miters)
+{
+    if (closed)
+    {
+        float dm_x = (normals[points_count - 1].x + normals[0].x) * 0.5f;
+        float dm_y = (normals[points_count - 1].y + normals[0].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_miters[0].x = dm_x;
+        out_miters[0].y = dm_y;
+    }
+    int i = 1;
+#ifdef IMGUI_ENABLE_SSE
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 eps = _mm_set1_ps(0.000001f);
+    const __m128 max_inv_len2 = _mm_set1_ps(IM_FIXNORMAL2F_MAX_INVLEN2);
+    for (; i + 4 <= points_count; i += 4)
+    {
+        const __m128 n01 = _mm_loadu_ps(&normals[i - 1].x);
+        const __m128 n23 = _mm_loadu_ps(&normals[i + 1].x);
+        const __m128 n12 = _mm_loadu_ps(&normals[i].x);
+        const __m128 n34 = _mm_loadu_ps(&normals[i + 2].x);
+        __m128 dm_x = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(n01, n23, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(n12, n34, _MM_SHUFFLE(2, 0, 2, 0))), half);
+        __m128 dm_y = _mm_mul_ps(_mm_add_ps(_mm_shuffle_ps(n01, n23, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(n12, n34, _MM_SHUFFLE(3, 1, 3, 1))), half);
+        const __m128 d2 = _mm_add_ps(_mm_mul_ps(dm_x, dm_x), _mm_mul_ps(dm_y, dm_y));
+        const __m128 mask = _mm_cmpgt_ps(d2, eps);
+        __m128 inv_len2 = _mm_min_ps(_mm_div_ps(_mm_set1_ps(1.0f), d2), max_inv_len2);
+        inv_len2 = _mm_or_ps(_mm_and_ps(mask, inv_len2), _mm_andnot_ps(mask, _mm_set1_ps(1.0f)));
+        dm_x = _mm_mul_ps(dm_x, inv_len2);
+        dm_y = _mm_mul_ps(dm_y, inv_len2);
+        _mm_storeu_ps(&out_miters[i].x, _mm_unpacklo_ps(dm_x, dm_y));
+        _mm_storeu_ps(&out_miters[i + 2].x, _mm_unpackhi_ps(dm_x, dm_y));
+    }
+#ifdef IMGUI_DEBUG_PARANOID
+    // Verify SSE output against the scalar path
+    for (int n = 1; n < i; n++)
+    {
+        float dm_x = (normals[n - 1].x + normals[n].x) * 0.5f;
+        float dm_y = (normals[n - 1].y + normals[n].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        IM_ASSERT(out_miters[n].x == dm_x && out_miters[n].y == dm_y);
+    }
+#endif
+#endif
+    for (; i < points_count; i++)
+    {
+        float dm_x = (normals[i - 1].x + normals[i].x) * 0.5f;
+        float dm_y = (normals[i - 1].y + normals[i].y) * 0.5f;
+        IM_FIXNORMAL2F(dm_x, dm_y);
+        out_miters[i].x = dm_x;
+        out_miters[i].y = dm_y;
+    }
+}
+
+// Tessellation parameters for AddPolyline(), shared by index and vertex generation.
+struct ImDrawListPolylineParams
+{
+    bool        Closed;
+    bool        AntiAliased;
+    bool        UseTexture;
+    bool        ThickLine;
+    int         Count;              // Number of line segments
+    int         IntegerThickness;
+    float       Thickness;
+    int         IdxCount;
+    int         VtxCount;
+    int         TempCount;          // Number of temporary ImVec2 needed by ImDrawList_WritePolylineVtx()
+    ImVec4      Uvs;                // TexUvLines[] entry for texture-based lines, TexUvWhitePixel in (x,y) otherwise
+};
 
-    const bool closed = (flags & ImDrawFlags_Closed) != 0;
-    const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
-    const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
-    const bool thick_line = (thickness > _FringeScale);
+// 'data' may be NULL when the caller provides Uvs itself (see ImDrawList::_TessellateDeferredShapes()), Uvs are then left zero.
+static void ImDrawList_CalcPolylineParams(ImDrawListPolylineParams* p, const ImDrawListSharedData* data, ImDrawListFlags draw_list_flags, float fringe_scale, int points_count, ImDrawFlags flags, float thickness)
+{
+    p->Closed = (flags & ImDrawFlags_Closed) != 0;
+    p->AntiAliased = (draw_list_flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    p->Count = p->Closed ? points_count : points_count - 1; // The number of line segments we need to draw
+    p->ThickLine = (thickness > fringe_scale);
 
-    if (Flags & ImDrawListFlags_AntiAliasedLines)
+    if (p->AntiAliased)
     {
-        // Anti-aliased stroke
-        const float AA_SIZE = _FringeScale;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-
         // Thicknesses <1.0 should behave like thickness 1.0
         thickness = ImMax(thickness, 1.0f);
         const int integer_thickness = (int)thickness;
@@ -822,320 +973,535 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         // Do we want to draw this line using a texture?
         // - For now, only draw integer-width lines using textures to avoid issues with the way scaling occurs, could be improved.
         // - If AA_SIZE is not 1.0f we cannot use the texture path.
-        const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
+        p->UseTexture = (draw_list_flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (fringe_scale == 1.0f);
+        p->IntegerThickness = integer_thickness;
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!p->UseTexture || data == NULL || !(data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
 
-        const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
-        const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
-        PrimReserve(idx_count, vtx_count);
+        p->IdxCount = p->UseTexture ? (p->Count * 6) : (p->ThickLine ? p->Count * 18 : p->Count * 12);
+        p->VtxCount = p->UseTexture ? (points_count * 2) : (p->ThickLine ? points_count * 4 : points_count * 3);
+
+        // The first <points_count> items are normals at each line point, the next <points_count> items are averaged normals (miters),
+        // then after that there are either 2 or 4 temp points for each line point
+        p->TempCount = points_count * ((p->UseTexture || !p->ThickLine) ? 4 : 6);
+    }
+    else
+    {
+        p->UseTexture = false;
+        p->IntegerThickness = 0;
+        p->IdxCount = p->Count * 6;
+        p->VtxCount = p->Count * 4;    // FIXME-OPT: Not sharing edges
+        p->TempCount = 0;
+    }
+    p->Thickness = thickness;
+    if (data == NULL)
+        p->Uvs = ImVec4(0.0f, 0.0f, 0.0f, 0.0f);
+    else
+        p->Uvs = p->UseTexture ? data->TexUvLines[p->IntegerThickness] : ImVec4(data->TexUvWhitePixel.x, data->TexUvWhitePixel.y, 0.0f, 0.0f);
+}
+
+// Generate the indices to form a number of triangles for each line segment.
+// This takes points n and n+1, with the first point in a closed line being the final one (as n+1 wraps)
+static void ImDrawList_WritePolylineIdx(ImDrawIdx* idx_write, unsigned int vtx_base_idx, const int points_count, const ImDrawListPolylineParams& p)
+{
+    if (!p.AntiAliased)
+    {
+        // [PATH 4] Non texture-based, Non anti-aliased lines
+        for (int i1 = 0; i1 < p.Count; i1++)
+        {
+            const unsigned int idx = vtx_base_idx + i1 * 4;
+            idx_write[0] = (ImDrawIdx)(idx); idx_write[1] = (ImDrawIdx)(idx + 1); idx_write[2] = (ImDrawIdx)(idx + 2);
+            idx_write[3] = (ImDrawIdx)(idx); idx_write[4] = (ImDrawIdx)(idx + 2); idx_write[5] = (ImDrawIdx)(idx + 3);
+            idx_write += 6;
+        }
+        return;
+    }
+
+    const unsigned int vtx_stride = p.UseTexture ? 2 : p.ThickLine ? 4 : 3;
+    unsigned int idx1 = vtx_base_idx; // Vertex index for start of line segment
+    for (int i1 = 0; i1 < p.Count; i1++) // i1 is the first point of the line segment
+    {
+        const unsigned int idx2 = ((i1 + 1) == points_count) ? vtx_base_idx : (idx1 + vtx_stride); // Vertex index for end of segment
+        if (p.UseTexture)
+        {
+            // [PATH 1] Add indices for two triangles
+            idx_write[0] = (ImDrawIdx)(idx2 + 0); idx_write[1] = (ImDrawIdx)(idx1 + 0); idx_write[2] = (ImDrawIdx)(idx1 + 1); // Right tri
+            idx_write[3] = (ImDrawIdx)(idx2 + 1); idx_write[4] = (ImDrawIdx)(idx1 + 1); idx_write[5] = (ImDrawIdx)(idx2 + 0); // Left tri
+            idx_write += 6;
+        }
+        else if (!p.ThickLine)
+        {
+            // [PATH 2] Add indexes for four triangles
+            idx_write[0] = (ImDrawIdx)(idx2 + 0); idx_write[1] = (ImDrawIdx)(idx1 + 0); idx_write[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
+            idx_write[3] = (ImDrawIdx)(idx1 + 2); idx_write[4] = (ImDrawIdx)(idx2 + 2); idx_write[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
+            idx_write[6] = (ImDrawIdx)(idx2 + 1); idx_write[7] = (ImDrawIdx)(idx1 + 1); idx_write[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
+            idx_write[9] = (ImDrawIdx)(idx1 + 0); idx_write[10] = (ImDrawIdx)(idx2 + 0); idx_write[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
+            idx_write += 12;
+        }
+        else
+        {
+            // [PATH 3] Add indexes for six triangles
+            idx_write[0]  = (ImDrawIdx)(idx2 + 1); idx_write[1]  = (ImDrawIdx)(idx1 + 1); idx_write[2]  = (ImDrawIdx)(idx1 + 2);
+            idx_write[3]  = (ImDrawIdx)(idx1 + 2); idx_write[4]  = (ImDrawIdx)(idx2 + 2); idx_write[5]  = (ImDrawIdx)(idx2 + 1);
+            idx_write[6]  = (ImDrawIdx)(idx2 + 1); idx_write[7]  = (ImDrawIdx)(idx1 + 1); idx_write[8]  = (ImDrawIdx)(idx1 + 0);
+            idx_write[9]  = (ImDrawIdx)(idx1 + 0); idx_write[10] = (ImDrawIdx)(idx2 + 0); idx_write[11] = (ImDrawIdx)(idx2 + 1);
+            idx_write[12] = (ImDrawIdx)(idx2 + 2); idx_write[13] = (ImDrawIdx)(idx1 + 2); idx_write[14] = (ImDrawIdx)(idx1 + 3);
+            idx_write[15] = (ImDrawIdx)(idx1 + 3); idx_write[16] = (ImDrawIdx)(idx2 + 3); idx_write[17] = (ImDrawIdx)(idx2 + 2);
+            idx_write += 18;
+        }
+        idx1 = idx2;
+    }
+}
 
-        // Temporary buffer
-        // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
-        ImVec2* temp_points = temp_normals + points_count;
+// Generate the vertices for the line edges. 'temp_buffer' must hold at least 'p.TempCount' items.
+// Only reads its arguments, so ImDrawList::_TessellateDeferredShapes() may call it from another thread (see ImDrawListFlags_DeferTessellation).
+static void ImDrawList_WritePolylineVtx(ImDrawVert* vtx_write, const ImVec2& vtx_origin, ImVec2* temp_buffer, const ImVec2* points, const int points_count, ImU32 col, float fringe_scale, const ImDrawListPolylineParams& p)
+{
+    const ImVec2 opaque_uv(p.Uvs.x, p.Uvs.y);
+    const int count = p.Count;
+    const bool closed = p.Closed;
+    const float thickness = p.Thickness;
 
-        // Calculate normals (tangents) for each line segment
+    if (!p.AntiAliased)
+    {
+        // [PATH 4] Non texture-based, Non anti-aliased lines
         for (int i1 = 0; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
+            const ImVec2& p1 = points[i1];
+            const ImVec2& p2 = points[i2];
+
+            float dx = p2.x - p1.x;
+            float dy = p2.y - p1.y;
             IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
+            dx *= (thickness * 0.5f);
+            dy *= (thickness * 0.5f);
+
+            IM_DRAWVERT_WRITE(&vtx_write[0], p1.x + dy, p1.y - dx, opaque_uv, col, vtx_origin);
+            IM_DRAWVERT_WRITE(&vtx_write[1], p2.x + dy, p2.y - dx, opaque_uv, col, vtx_origin);
+            IM_DRAWVERT_WRITE(&vtx_write[2], p2.x - dy, p2.y + dx, opaque_uv, col, vtx_origin);
+            IM_DRAWVERT_WRITE(&vtx_write[3], p1.x - dy, p1.y + dx, opaque_uv, col, vtx_origin);
+            vtx_write += 4;
         }
-        if (!closed)
-            temp_normals[points_count - 1] = temp_normals[points_count - 2];
+        return;
+    }
 
-        // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
-        if (use_texture || !thick_line)
-        {
-            // [PATH 1] Texture-based lines (thick or non-thick)
-            // [PATH 2] Non texture-based lines (non-thick)
-
-            // The width of the geometry we need to draw - this is essentially <thickness> pixels for the line itself, plus "one pixel" for AA.
-            // - In the texture-based path, we don't use AA_SIZE here because the +1 is tied to the generated texture
-            //   (see ImFontAtlasBuildRenderLinesTexData() function), and so alternate values won't work without changes to that code.
-            // - In the non texture-based paths, we would allow AA_SIZE to potentially be != 1.0f with a patch (e.g. fringe_scale patch to
-            //   allow scaling geometry while preserving one-screen-pixel AA fringe).
-            const float half_draw_size = use_texture ? ((thickness * 0.5f) + 1) : AA_SIZE;
-
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
-            {
-                temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
-                temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
-                temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
-                temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
-            }
+    // Anti-aliased stroke
+    const float AA_SIZE = fringe_scale;
+    const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+    ImVec2* temp_normals = temp_buffer;
+    ImVec2* temp_miters = temp_normals + points_count;
+    ImVec2* temp_points = temp_miters + points_count;
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
-            {
-                const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                dm_x *= half_draw_size; // dm_x, dm_y are offset to the outer edge of the AA area
-                dm_y *= half_draw_size;
-
-                // Add temporary vertices for the outer edges
-                ImVec2* out_vtx = &temp_points[i2 * 2];
-                out_vtx[0].x = points[i2].x + dm_x;
-                out_vtx[0].y = points[i2].y + dm_y;
-                out_vtx[1].x = points[i2].x - dm_x;
-                out_vtx[1].y = points[i2].y - dm_y;
-
-                if (use_texture)
-                {
-                    // Add indices for two triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
-                    _IdxWritePtr += 6;
-                }
-                else
-                {
-                    // Add indexes for four triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
-                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
-                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
-                    _IdxWritePtr += 12;
-                }
+    // Calculate normals (tangents) for each line segment, then averaged normals for each point
+    ImDrawList_CalcSegmentNormals(points, points_count, count, temp_normals);
+    if (!closed)
+        temp_normals[points_count - 1] = temp_normals[points_count - 2];
+    ImDrawList_CalcPointMiters(temp_normals, points_count, closed, temp_miters);
 
-                idx1 = idx2;
-            }
+    // If we are drawing a one-pixel-wide line without a texture, or a textured line of any width, we only need 2 or 3 vertices per point
+    if (p.UseTexture || !p.ThickLine)
+    {
+        // [PATH 1] Texture-based lines (thick or non-thick)
+        // [PATH 2] Non texture-based lines (non-thick)
 
-            // Add vertices for each point on the line
-            if (use_texture)
-            {
-                // If we're using textures we only need to emit the left/right edge vertices
-                ImVec4 tex_uvs = _Data->TexUvLines[integer_thickness];
-                /*if (fractional_thickness != 0.0f) // Currently always zero when use_texture==false!
-                {
-                    const ImVec4 tex_uvs_1 = _Data->TexUvLines[integer_thickness + 1];
-                    tex_uvs.x = tex_uvs.x + (tex_uvs_1.x - tex_uvs.x) * fractional_thickness; // inlined ImLerp()
-                    tex_uvs.y = tex_uvs.y + (tex_uvs_1.y - tex_uvs.y) * fractional_thickness;
-                    tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
-                    tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
-                }*/
-                ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
-                ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
-                    _VtxWritePtr += 2;
-                }
-            }
-            else
-            {
-                // If we're not using a texture, we need the center vertex as well
-                for (int i = 0; i < points_count; i++)
-                {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
-                    _VtxWritePtr += 3;
-                }
-            }
+        // The width of the geometry we need to draw - this is essentially <thickness> pixels for the line itself, plus "one pixel" for AA.
+        // - In the texture-based path, we don't use AA_SIZE here because the +1 is tied to the generated texture
+        //   (see ImFontAtlasBuildRenderLinesTexData() function), and so alternate values won't work without changes to that code.
+        // - In the non texture-based paths, we would allow AA_SIZE to potentially be != 1.0f with a patch (e.g. fringe_scale patch to
+        //   allow scaling geometry while preserving one-screen-pixel AA fringe).
+        const float half_draw_size = p.UseTexture ? ((thickness * 0.5f) + 1) : AA_SIZE;
+
+        // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
+        if (!closed)
+        {
+            temp_points[0] = points[0] + temp_normals[0] * half_draw_size;
+            temp_points[1] = points[0] - temp_normals[0] * half_draw_size;
+            temp_points[(points_count-1)*2+0] = points[points_count-1] + temp_normals[points_count-1] * half_draw_size;
+            temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
         }
-        else
+
+        // Generate the vertices for the line edges
+        // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+        // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+        for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
         {
-            // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
-            const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
+
+            // Offset to the outer edge of the AA area
+            const float dm_x = temp_miters[i2].x * half_draw_size;
+            const float dm_y = temp_miters[i2].y * half_draw_size;
+
+            // Add temporary vertices for the outer edges
+            ImVec2* out_vtx = &temp_points[i2 * 2];
+            out_vtx[0].x = points[i2].x + dm_x;
+            out_vtx[0].y = points[i2].y + dm_y;
+            out_vtx[1].x = points[i2].x - dm_x;
+            out_vtx[1].y = points[i2].y - dm_y;
+        }
 
-            // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
-            if (!closed)
+        // Add vertices for each point on the line
+        if (p.UseTexture)
+        {
+            // If we're using textures we only need to emit the left/right edge vertices
+            ImVec4 tex_uvs = p.Uvs;
+            /*if (fractional_thickness != 0.0f) // Currently always zero when use_texture==false!
             {
-                const int points_last = points_count - 1;
-                temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
-                temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
-                temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-                temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
-                temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
-            }
-
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
-            // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+                const ImVec4 tex_uvs_1 = _Data->TexUvLines[integer_thickness + 1];
+                tex_uvs.x = tex_uvs.x + (tex_uvs_1.x - tex_uvs.x) * fractional_thickness; // inlined ImLerp()
+                tex_uvs.y = tex_uvs.y + (tex_uvs_1.y - tex_uvs.y) * fractional_thickness;
+                tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
+                tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
+            }*/
+            ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
+            ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
+            for (int i = 0; i < points_count; i++)
             {
-                const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
-
-                // Average normals
-                float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
-                float dm_y = (temp_normals[i1].y + temp_normals[i2].y) * 0.5f;
-                IM_FIXNORMAL2F(dm_x, dm_y);
-                float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
-                float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
-                float dm_in_x = dm_x * half_inner_thickness;
-                float dm_in_y = dm_y * half_inner_thickness;
-
-                // Add temporary vertices
-                ImVec2* out_vtx = &temp_points[i2 * 4];
-                out_vtx[0].x = points[i2].x + dm_out_x;
-                out_vtx[0].y = points[i2].y + dm_out_y;
-                out_vtx[1].x = points[i2].x + dm_in_x;
-                out_vtx[1].y = points[i2].y + dm_in_y;
-                out_vtx[2].x = points[i2].x - dm_in_x;
-                out_vtx[2].y = points[i2].y - dm_in_y;
-                out_vtx[3].x = points[i2].x - dm_out_x;
-                out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
-                _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
-                _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
-                _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
-                _IdxWritePtr[9]  = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1);
-                _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
-                _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
-                _IdxWritePtr += 18;
-
-                idx1 = idx2;
+                IM_DRAWVERT_WRITE(&vtx_write[0], temp_points[i * 2 + 0].x, temp_points[i * 2 + 0].y, tex_uv0, col, vtx_origin); // Left-side outer edge
+                IM_DRAWVERT_WRITE(&vtx_write[1], temp_points[i * 2 + 1].x, temp_points[i * 2 + 1].y, tex_uv1, col, vtx_origin); // Right-side outer edge
+                vtx_write += 2;
             }
-
-            // Add vertices
+        }
+        else
+        {
+            // If we're not using a texture, we need the center vertex as well
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
+                IM_DRAWVERT_WRITE(&vtx_write[0], points[i].x, points[i].y, opaque_uv, col, vtx_origin);                 // Center of line
+                IM_DRAWVERT_WRITE(&vtx_write[1], temp_points[i * 2 + 0].x, temp_points[i * 2 + 0].y, opaque_uv, col_trans, vtx_origin); // Left-side outer edge
+                IM_DRAWVERT_WRITE(&vtx_write[2], temp_points[i * 2 + 1].x, temp_points[i * 2 + 1].y, opaque_uv, col_trans, vtx_origin); // Right-side outer edge
+                vtx_write += 3;
             }
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
     {
-        // [PATH 4] Non texture-based, Non anti-aliased lines
-        const int idx_count = count * 6;
-        const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
-        PrimReserve(idx_count, vtx_count);
+        // [PATH 3] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
+        const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
-        for (int i1 = 0; i1 < count; i1++)
+        // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
+        if (!closed)
         {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            const ImVec2& p1 = points[i1];
-            const ImVec2& p2 = points[i2];
-
-            float dx = p2.x - p1.x;
-            float dy = p2.y - p1.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            dx *= (thickness * 0.5f);
-            dy *= (thickness * 0.5f);
+            const int points_last = points_count - 1;
+            temp_points[0] = points[0] + temp_normals[0] * (half_inner_thickness + AA_SIZE);
+            temp_points[1] = points[0] + temp_normals[0] * (half_inner_thickness);
+            temp_points[2] = points[0] - temp_normals[0] * (half_inner_thickness);
+            temp_points[3] = points[0] - temp_normals[0] * (half_inner_thickness + AA_SIZE);
+            temp_points[points_last * 4 + 0] = points[points_last] + temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
+            temp_points[points_last * 4 + 1] = points[points_last] + temp_normals[points_last] * (half_inner_thickness);
+            temp_points[points_last * 4 + 2] = points[points_last] - temp_normals[points_last] * (half_inner_thickness);
+            temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
+        }
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
-            _VtxWritePtr += 4;
+        // Generate the vertices for the line edges
+        // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+        // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
+        for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+        {
+            const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
+
+            // Averaged normals
+            const float dm_x = temp_miters[i2].x;
+            const float dm_y = temp_miters[i2].y;
+            float dm_out_x = dm_x * (half_inner_thickness + AA_SIZE);
+            float dm_out_y = dm_y * (half_inner_thickness + AA_SIZE);
+            float dm_in_x = dm_x * half_inner_thickness;
+            float dm_in_y = dm_y * half_inner_thickness;
+
+            // Add temporary vertices
+            ImVec2* out_vtx = &temp_points[i2 * 4];
+            out_vtx[0].x = points[i2].x + dm_out_x;
+            out_vtx[0].y = points[i2].y + dm_out_y;
+            out_vtx[1].x = points[i2].x + dm_in_x;
+            out_vtx[1].y = points[i2].y + dm_in_y;
+            out_vtx[2].x = points[i2].x - dm_in_x;
+            out_vtx[2].y = points[i2].y - dm_in_y;
+            out_vtx[3].x = points[i2].x - dm_out_x;
+            out_vtx[3].y = points[i2].y - dm_out_y;
+        }
 
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
-            _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx + 2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx + 3);
-            _IdxWritePtr += 6;
-            _VtxCurrentIdx += 4;
+        // Add vertices
+        for (int i = 0; i < points_count; i++)
+        {
+            IM_DRAWVERT_WRITE(&vtx_write[0], temp_points[i * 4 + 0].x, temp_points[i * 4 + 0].y, opaque_uv, col_trans, vtx_origin);
+            IM_DRAWVERT_WRITE(&vtx_write[1], temp_points[i * 4 + 1].x, temp_points[i * 4 + 1].y, opaque_uv, col, vtx_origin);
+            IM_DRAWVERT_WRITE(&vtx_write[2], temp_points[i * 4 + 2].x, temp_points[i * 4 + 2].y, opaque_uv, col, vtx_origin);
+            IM_DRAWVERT_WRITE(&vtx_write[3], temp_points[i * 4 + 3].x, temp_points[i * 4 + 3].y, opaque_uv, col_trans, vtx_origin);
+            vtx_write += 4;
         }
     }
 }
 
-// - We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
-// - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
-void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
+// We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
 {
-    if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
+    if (points_count < 2 || (col & IM_COL32_A_MASK) == 0)
         return;
 
-    const ImVec2 uv = _Data->TexUvWhitePixel;
-
-    if (Flags & ImDrawListFlags_AntiAliasedFill)
+    ImDrawListPolylineParams params;
+    ImDrawList_CalcPolylineParams(&params, _Data, Flags, _FringeScale, points_count, flags, thickness);
+    PrimReserve(params.IdxCount, params.VtxCount);
+    ImDrawList_WritePolylineIdx(_IdxWritePtr, _VtxCurrentIdx, points_count, params);
+    if (Flags & ImDrawListFlags_DeferTessellation)
     {
-        // Anti-aliased Fill
-        const float AA_SIZE = _FringeScale;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-        const int idx_count = (points_count - 2)*3 + points_count * 6;
-        const int vtx_count = (points_count * 2);
-        PrimReserve(idx_count, vtx_count);
+        _AddDeferredShape(ImDrawListDeferredShapeType_Polyline, points, points_count, col, flags, thickness, params.Uvs, params.TempCount);
+    }
+    else
+    {
+        _TempBuffer.reserve_discard(params.TempCount);
+        ImDrawList_WritePolylineVtx(_VtxWritePtr, VtxOrigin, _TempBuffer.Data, points, points_count, col, _FringeScale, params);
+    }
+    _IdxWritePtr += params.IdxCount;
+    _VtxWritePtr += params.VtxCount;
+    _VtxCurrentIdx += params.VtxCount;
+}
 
+static void ImDrawList_WriteConvexPolyFilledIdx(ImDrawIdx* idx_write, unsigned int vtx_base_idx, const int points_count, bool anti_aliased)
+{
+    if (anti_aliased)
+    {
         // Add indexes for fill
-        unsigned int vtx_inner_idx = _VtxCurrentIdx;
-        unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+        unsigned int vtx_inner_idx = vtx_base_idx;
+        unsigned int vtx_outer_idx = vtx_base_idx + 1;
         for (int i = 2; i < points_count; i++)
         {
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
-            _IdxWritePtr += 3;
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); idx_write[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+            idx_write += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        // Add indexes for fringes
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+            idx_write += 6;
+        }
+    }
+    else
+    {
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_base_idx); idx_write[1] = (ImDrawIdx)(vtx_base_idx + i - 1); idx_write[2] = (ImDrawIdx)(vtx_base_idx + i);
+            idx_write += 3;
         }
+    }
+}
 
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
+// 'temp_buffer' must hold at least 'points_count * 2' items when 'anti_aliased' is set.
+// Only reads its arguments, so ImDrawList::_TessellateDeferredShapes() may call it from another thread (see ImDrawListFlags_DeferTessellation).
+static void ImDrawList_WriteConvexPolyFilledVtx(ImDrawVert* vtx_write, const ImVec2& vtx_origin, ImVec2* temp_buffer, const ImVec2* points, const int points_count, ImU32 col, const ImVec2& uv, bool anti_aliased, float fringe_scale)
+{
+    if (anti_aliased)
+    {
+        // Anti-aliased Fill
+        const float AA_SIZE = fringe_scale;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+
+        // Compute normals, then averaged normals
+        ImVec2* temp_normals = temp_buffer;
+        ImVec2* temp_miters = temp_normals + points_count;
+        ImDrawList_CalcSegmentNormals(points, points_count, points_count, temp_normals);
+        ImDrawList_CalcPointMiters(temp_normals, points_count, true, temp_miters);
+
+        for (int i = 0; i < points_count; i++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+            const float dm_x = temp_miters[i].x * (AA_SIZE * 0.5f);
+            const float dm_y = temp_miters[i].y * (AA_SIZE * 0.5f);
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
+            IM_DRAWVERT_WRITE(&vtx_write[0], (points[i].x - dm_x), (points[i].y - dm_y), uv, col, vtx_origin);        // Inner
+            IM_DRAWVERT_WRITE(&vtx_write[1], (points[i].x + dm_x), (points[i].y + dm_y), uv, col_trans, vtx_origin);  // Outer
+            vtx_write += 2;
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
     {
         // Non Anti-aliased Fill
-        const int idx_count = (points_count - 2)*3;
-        const int vtx_count = points_count;
+        for (int i = 0; i < points_count; i++)
+        {
+            IM_DRAWVERT_WRITE(&vtx_write[0], points[i].x, points[i].y, uv, col, vtx_origin);
+            vtx_write++;
+        }
+    }
+}
+
+// - We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
+// - Filled shapes must always use clockwise winding order. The anti-aliasing fringe depends on it. Counter-clockwise shapes will have "inward" anti-aliasing.
+void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+{
+    if (points_count < 3 || (col & IM_COL32_A_MASK) == 0)
+        return;
+
+    if (Flags & ImDrawListFlags_DeferTessellation)
+    {
+        const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+        const int idx_count = anti_aliased ? (points_count - 2) * 3 + points_count * 6 : (points_count - 2) * 3;
+        const int vtx_count = anti_aliased ? points_count * 2 : points_count;
         PrimReserve(idx_count, vtx_count);
-        for (int i = 0; i < vtx_count; i++)
+        ImDrawList_WriteConvexPolyFilledIdx(_IdxWritePtr, _VtxCurrentIdx, points_count, anti_aliased);
+        const ImVec2 uv = _Data->TexUvWhitePixel;
+        _AddDeferredShape(ImDrawListDeferredShapeType_ConvexPolyFilled, points, points_count, col, ImDrawFlags_None, 0.0f, ImVec4(uv.x, uv.y, 0.0f, 0.0f), anti_aliased ? points_count * 2 : 0);
+        _IdxWritePtr += idx_count;
+        _VtxWritePtr += vtx_count;
+        _VtxCurrentIdx += vtx_count;
+        return;
+    }
+
+    if (Flags & ImDrawListFlags_AntiAliasedFill)
+        PrimReserve((points_count - 2) * 3 + points_count * 6, points_count * 2);
+    else
+        PrimReserve((points_count - 2) * 3, points_count);
+    _PrimConvexPolyFilled(points, points_count, col);
+}
+
+// Write vertices/indices for AddConvexPolyFilled(). Space must have been reserved with PrimReserve() beforehand.
+void ImDrawList::_PrimConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+{
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const int idx_count = anti_aliased ? (points_count - 2) * 3 + points_count * 6 : (points_count - 2) * 3;
+    const int vtx_count = anti_aliased ? points_count * 2 : points_count;
+    if (anti_aliased)
+        _TempBuffer.reserve_discard(points_count * 2);
+    ImDrawList_WriteConvexPolyFilledIdx(_IdxWritePtr, _VtxCurrentIdx, points_count, anti_aliased);
+    ImDrawList_WriteConvexPolyFilledVtx(_VtxWritePtr, VtxOrigin, _TempBuffer.Data, points, points_count, col, _Data->TexUvWhitePixel, anti_aliased, _FringeScale);
+    _IdxWritePtr += idx_count;
+    _VtxWritePtr += vtx_count;
+    _VtxCurrentIdx += vtx_count;
+}
+
+// Record a shape to be tessellated later by _TessellateDeferredShapes().
+// Indices have already been written by the caller: they don't depend on the shape geometry and this way ImDrawListSplitter may freely move them.
+void ImDrawList::_AddDeferredShape(ImDrawListDeferredShapeType type, const ImVec2* points, int points_count, ImU32 col, ImDrawFlags flags, float thickness, const ImVec4& uvs, int temp_count)
+{
+    _DeferredShapes.resize(_DeferredShapes.Size + 1);
+    ImDrawListDeferredShape& shape = _DeferredShapes.back();
+    shape.Type = type;
+    shape.Flags = Flags;
+    shape.DrawFlags = flags;
+    shape.Col = col;
+    shape.Thickness = thickness;
+    shape.FringeScale = _FringeScale;
+    shape.Uvs = uvs;
+    shape.PointsOffset = _DeferredPoints.Size;
+    shape.PointsCount = points_count;
+    shape.VtxOffset = (int)(_VtxWritePtr - VtxBuffer.Data);
+    _DeferredPoints.resize(_DeferredPoints.Size + points_count);
+    memcpy(_DeferredPoints.Data + shape.PointsOffset, points, (size_t)points_count * sizeof(ImVec2));
+
+    // Allocate temporary buffer now, so tessellation doesn't need to allocate (which may not be thread-safe)
+    if (_TempBuffer.Capacity < temp_count)
+        _TempBuffer.reserve_discard(temp_count);
+}
+
+// Tessellate shapes recorded with ImDrawListFlags_DeferTessellation, writing into the vertices reserved when recording.
+// - Called by ImGui::Render(), possibly from another thread: this only accesses this draw list (not _Data) and doesn't allocate memory.
+// - Also called before functions which need to read/alter vertices (e.g. ShadeVertsXXX functions), and by ImDrawData::AddDrawList()/CloneOutput().
+void ImDrawList::_TessellateDeferredShapes()
+{
+    if (_DeferredShapes.Size == 0)
+        return;
+    for (const ImDrawListDeferredShape& shape : _DeferredShapes)
+    {
+        ImDrawVert* vtx_write = VtxBuffer.Data + shape.VtxOffset;
+        const ImVec2* points = _DeferredPoints.Data + shape.PointsOffset;
+        if (shape.Type == ImDrawListDeferredShapeType_Polyline)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr++;
+            ImDrawListPolylineParams params;
+            ImDrawList_CalcPolylineParams(&params, NULL, shape.Flags, shape.FringeScale, shape.PointsCount, shape.DrawFlags, shape.Thickness); // Don't read shared data from another thread
+            params.Uvs = shape.Uvs;
+            ImDrawList_WritePolylineVtx(vtx_write, VtxOrigin, _TempBuffer.Data, points, shape.PointsCount, shape.Col, shape.FringeScale, params);
         }
-        for (int i = 2; i < points_count; i++)
+        else
         {
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + i - 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + i);
-            _IdxWritePtr += 3;
+            ImDrawList_WriteConvexPolyFilledVtx(vtx_write, VtxOrigin, _TempBuffer.Data, points, shape.PointsCount, shape.Col, ImVec2(shape.Uvs.x, shape.Uvs.y), (shape.Flags & ImDrawListFlags_AntiAliasedFill) != 0, shape.FringeScale);
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
+    _DeferredShapes.resize(0);
+    _DeferredPoints.resize(0);
+}
+
+// Append contents of another draw list, used by ImGui::Render() when io.ConfigDrawDataMergeDrawLists is set.
+// - Indices are rebased to our vertex buffer. With 16-bit indices, when vertices don't fit in the current 64K window
+//   we start a new window using ImDrawCmd::VtxOffset (requires ImGuiBackendFlags_RendererHasVtxOffset).
+// - Commands sharing the same clip rectangle and texture as our last command are merged into it.
+// - Return false and leave this draw list untouched if 'src_list' cannot be merged, in which case it needs to be rendered separately.
+bool ImDrawList::_MergeDrawList(const ImDrawList* src_list, bool has_vtx_offset)
+{
+    // Callbacks may rely on their parent draw list, don't merge them.
+    for (const ImDrawCmd& src_cmd : src_list->CmdBuffer)
+        if (src_cmd.UserCallback != NULL)
+            return false;
+
+    const int vtx_base = VtxBuffer.Size;
+    const unsigned int vtx_window = (CmdBuffer.Size > 0) ? CmdBuffer.back().VtxOffset : 0;
+    const bool rebase_idx = (sizeof(ImDrawIdx) == 4) || (vtx_base + src_list->VtxBuffer.Size - (int)vtx_window <= (1 << 16));
+    if (!rebase_idx && !has_vtx_offset)
+        return false;
+
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    // Positions are relative to VtxOrigin: rebase them to ours, which only works if they stay in range.
+    // Origins are always integer values so the offset is exact.
+    if (vtx_base == 0)
+        VtxOrigin = src_list->VtxOrigin;
+    const int vtx_origin_dx = (int)((src_list->VtxOrigin.x - VtxOrigin.x) * IM_DRAWVERT_POS_SCALE);
+    const int vtx_origin_dy = (int)((src_list->VtxOrigin.y - VtxOrigin.y) * IM_DRAWVERT_POS_SCALE);
+    if (vtx_origin_dx != 0 || vtx_origin_dy != 0)
+    {
+        int min_x = 32767, min_y = 32767, max_x = -32768, max_y = -32768;
+        for (const ImDrawVert& v : src_list->VtxBuffer)
+        {
+            min_x = ImMin(min_x, (int)v.pos[0]); max_x = ImMax(max_x, (int)v.pos[0]);
+            min_y = ImMin(min_y, (int)v.pos[1]); max_y = ImMax(max_y, (int)v.pos[1]);
+        }
+        if (src_list->VtxBuffer.Size > 0 && (min_x + vtx_origin_dx < -32768 || max_x + vtx_origin_dx > 32767 || min_y + vtx_origin_dy < -32768 || max_y + vtx_origin_dy > 32767))
+            return false;
+    }
+#endif
+
+    // Copy vertices
+    VtxBuffer.resize(vtx_base + src_list->VtxBuffer.Size);
+    if (src_list->VtxBuffer.Size > 0)
+        memcpy(VtxBuffer.Data + vtx_base, src_list->VtxBuffer.Data, (size_t)src_list->VtxBuffer.Size * sizeof(ImDrawVert));
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+    if (vtx_origin_dx != 0 || vtx_origin_dy != 0)
+        for (ImDrawVert* v = VtxBuffer.Data + vtx_base; v < VtxBuffer.Data + VtxBuffer.Size; v++)
+        {
+            v->pos[0] = (ImS16)(v->pos[0] + vtx_origin_dx);
+            v->pos[1] = (ImS16)(v->pos[1] + vtx_origin_dy);
+        }
+#endif
+
+    // Copy commands and indices
+    for (const ImDrawCmd& src_cmd : src_list->CmdBuffer)
+    {
+        if (src_cmd.ElemCount == 0)
+            continue;
+        ImDrawCmd cmd = src_cmd;
+        cmd.VtxOffset = rebase_idx ? vtx_window : vtx_base + src_cmd.VtxOffset;
+        cmd.IdxOffset = (unsigned int)IdxBuffer.Size;
+
+        const unsigned int idx_add = rebase_idx ? (vtx_base + src_cmd.VtxOffset - vtx_window) : 0;
+        const ImDrawIdx* idx_read = src_list->IdxBuffer.Data + src_cmd.IdxOffset;
+        IdxBuffer.resize(IdxBuffer.Size + (int)src_cmd.ElemCount);
+        ImDrawIdx* idx_write = IdxBuffer.Data + cmd.IdxOffset;
+        if (idx_add == 0)
+            memcpy(idx_write, idx_read, src_cmd.ElemCount * sizeof(ImDrawIdx));
+        else
+            for (unsigned int n = 0; n < src_cmd.ElemCount; n++)
+                idx_write[n] = (ImDrawIdx)(idx_read[n] + idx_add);
+
+        ImDrawCmd* prev_cmd = (CmdBuffer.Size > 0) ? &CmdBuffer.back() : NULL;
+        if (prev_cmd != NULL && ImDrawCmd_HeaderCompare(prev_cmd, &cmd) == 0) // Indices are always written sequentially here
+            prev_cmd->ElemCount += cmd.ElemCount;
+        else
+            CmdBuffer.push_back(cmd);
+    }
+    _VtxCurrentIdx = (unsigned int)(VtxBuffer.Size - (CmdBuffer.Size > 0 ? (int)CmdBuffer.back().VtxOffset : 0));
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+    return true;
 }
 
 void ImDrawList::_PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step)
@@ -1789,68 +2155,244 @@ void ImDrawList::AddImageRounded(ImTextureRef tex_ref, const ImVec2& p_min, cons
         PopTexture();
 }
 
-//-----------------------------------------------------------------------------
-// [SECTION] ImTriangulator, ImDrawList concave polygon fill
-//-----------------------------------------------------------------------------
-// Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity.
-// Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
-// Provided as a convenience for user but not used by main library.
-//-----------------------------------------------------------------------------
-// - ImTriangulator [Internal]
-// - AddConcavePolyFilled()
-//-----------------------------------------------------------------------------
-
-enum ImTriangulatorNodeType
-{
-    ImTriangulatorNodeType_Convex,
-    ImTriangulatorNodeType_Ear,
-    ImTriangulatorNodeType_Reflex
-};
-
-struct ImTriangulatorNode
+// Number of shapes we can submit with a single PrimReserve() call while staying within the range of 16-bit indices.
+static inline int ImDrawList_CalcBatchChunkSize(int count, int vtx_per_shape)
 {
-    ImTriangulatorNodeType  Type;
-    int                     Index;
-    ImVec2                  Pos;
-    ImTriangulatorNode*     Next;
-    ImTriangulatorNode*     Prev;
-
-    void    Unlink()        { Next->Prev = Prev; Prev->Next = Next; }
-};
+    if (sizeof(ImDrawIdx) != 2)
+        return count;
+    return ImMax(ImMin(count, ((1 << 16) - 1) / vtx_per_shape), 1);
+}
 
-struct ImTriangulatorNodeSpan
+// Same output as calling AddLine() for each line.
+// Each line is a 2 points open polyline tessellated by the same code as AddPolyline(), so they share their parameters.
+void ImDrawList::AddLineBatch(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness)
 {
-    ImTriangulatorNode**    Data = NULL;
-    int                     Size = 0;
+    if (count <= 0)
+        return;
 
-    void    push_back(ImTriangulatorNode* node) { Data[Size++] = node; }
-    void    find_erase_unsorted(int idx)        { for (int i = Size - 1; i >= 0; i--) if (Data[i]->Index == idx) { Data[i] = Data[Size - 1]; Size--; return; } }
-};
+    ImDrawListPolylineParams params;
+    ImDrawList_CalcPolylineParams(&params, _Data, Flags, _FringeScale, 2, ImDrawFlags_None, thickness);
+    _TempBuffer.reserve_discard(params.TempCount);
 
-struct ImTriangulator
-{
+    const int chunk_size = ImDrawList_CalcBatchChunkSize(count, params.VtxCount);
+    for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+    {
+        const int chunk_end = ImMin(chunk_start + chunk_size, count);
+        PrimReserve((chunk_end - chunk_start) * params.IdxCount, (chunk_end - chunk_start) * params.VtxCount);
+        int skipped_count = 0;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+            {
+                skipped_count++;
+                continue;
+            }
+            const ImVec2 points[2] = { ImVec2(p1[n].x + 0.5f, p1[n].y + 0.5f), ImVec2(p2[n].x + 0.5f, p2[n].y + 0.5f) }; // Same offset as AddLine()
+            ImDrawList_WritePolylineIdx(_IdxWritePtr, _VtxCurrentIdx, 2, params);
+            ImDrawList_WritePolylineVtx(_VtxWritePtr, VtxOrigin, _TempBuffer.Data, points, 2, col, _FringeScale, params);
+            _IdxWritePtr += params.IdxCount;
+            _VtxWritePtr += params.VtxCount;
+            _VtxCurrentIdx += params.VtxCount;
+        }
+
+        // Release space reserved for skipped (fully transparent) lines
+        if (skipped_count > 0)
+            PrimUnreserve(skipped_count * params.IdxCount, skipped_count * params.VtxCount);
+    }
+}
+
+// Same output as calling AddRectFilled() with no rounding for each rectangle.
+void ImDrawList::AddRectFilledBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count)
+{
+    if (count <= 0)
+        return;
+
+    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const int chunk_size = ImDrawList_CalcBatchChunkSize(count, 4);
+    for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+    {
+        const int chunk_end = ImMin(chunk_start + chunk_size, count);
+        PrimReserve((chunk_end - chunk_start) * 6, (chunk_end - chunk_start) * 4);
+        ImDrawVert* vtx_write = _VtxWritePtr;
+        ImDrawIdx* idx_write = _IdxWritePtr;
+        unsigned int idx = _VtxCurrentIdx;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            if ((col & IM_COL32_A_MASK) == 0)
+                continue;
+            const ImVec2 a = p_min[n];
+            const ImVec2 c = p_max[n];
+            idx_write[0] = (ImDrawIdx)idx; idx_write[1] = (ImDrawIdx)(idx + 1); idx_write[2] = (ImDrawIdx)(idx + 2);
+            idx_write[3] = (ImDrawIdx)idx; idx_write[4] = (ImDrawIdx)(idx + 2); idx_write[5] = (ImDrawIdx)(idx + 3);
+            IM_DRAWVERT_WRITE(&vtx_write[0], a.x, a.y, uv, col, VtxOrigin);
+            IM_DRAWVERT_WRITE(&vtx_write[1], c.x, a.y, uv, col, VtxOrigin);
+            IM_DRAWVERT_WRITE(&vtx_write[2], c.x, c.y, uv, col, VtxOrigin);
+            IM_DRAWVERT_WRITE(&vtx_write[3], a.x, c.y, uv, col, VtxOrigin);
+            vtx_write += 4;
+            idx_write += 6;
+            idx += 4;
+        }
+
+        // Release space reserved for skipped (fully transparent) rectangles
+        const int skipped_count = (chunk_end - chunk_start) - (int)(vtx_write - _VtxWritePtr) / 4;
+        _VtxWritePtr = vtx_write;
+        _IdxWritePtr = idx_write;
+        _VtxCurrentIdx = idx;
+        if (skipped_count > 0)
+            PrimUnreserve(skipped_count * 6, skipped_count * 4);
+    }
+}
+
+// Same output as calling AddCircleFilled() with an explicit segment count for each circle.
+// The unit circle is computed once and shared by all circles.
+void ImDrawList::AddCircleFilledBatch(const ImVec2* centers, const float* radii, const ImU32* cols, int count, int num_segments)
+{
+    if (count <= 0)
+        return;
+
+    if (num_segments <= 0)
+    {
+        float radius_max = 0.0f;
+        for (int n = 0; n < count; n++)
+            radius_max = ImMax(radius_max, radii[n]);
+        num_segments = _CalcCircleAutoSegmentCount(radius_max);
+    }
+    num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+
+    // Because we are filling a closed shape we remove 1 from the count of segments/points (same as AddCircleFilled() -> _PathArcToN())
+    // The unit circle followed by the points of the current circle are stored after the end of _Path, so a path being built by the caller is preserved.
+    const int points_count = num_segments;
+    const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+    const int path_size = _Path.Size;
+    _Path.resize(path_size + points_count * 2);
+    ImVec2* unit_points = _Path.Data + path_size;
+    ImVec2* points = unit_points + points_count;
+    for (int i = 0; i < points_count; i++)
+    {
+        const float a = ((float)i / (float)(points_count - 1)) * a_max;
+        unit_points[i] = ImVec2(ImCos(a), ImSin(a));
+    }
+
+    const bool anti_aliased = (Flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    const int vtx_per_circle = anti_aliased ? points_count * 2 : points_count;
+    const int idx_per_circle = anti_aliased ? (points_count - 2) * 3 + points_count * 6 : (points_count - 2) * 3;
+    const int chunk_size = ImDrawList_CalcBatchChunkSize(count, vtx_per_circle);
+    for (int chunk_start = 0; chunk_start < count; chunk_start += chunk_size)
+    {
+        const int chunk_end = ImMin(chunk_start + chunk_size, count);
+        PrimReserve((chunk_end - chunk_start) * idx_per_circle, (chunk_end - chunk_start) * vtx_per_circle);
+        int skipped_count = 0;
+        for (int n = chunk_start; n < chunk_end; n++)
+        {
+            const ImU32 col = cols[n];
+            const float radius = radii[n];
+            if ((col & IM_COL32_A_MASK) == 0 || radius < 0.5f)
+            {
+                skipped_count++;
+                continue;
+            }
+            const ImVec2 center = centers[n];
+            for (int i = 0; i < points_count; i++)
+            {
+                points[i].x = center.x + unit_points[i].x * radius;
+                points[i].y = center.y + unit_points[i].y * radius;
+            }
+            _PrimConvexPolyFilled(points, points_count, col);
+        }
+
+        // Release space reserved for skipped circles
+        if (skipped_count > 0)
+            PrimUnreserve(skipped_count * idx_per_circle, skipped_count * vtx_per_circle);
+    }
+    _Path.Size = path_size;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImTriangulator, ImDrawList concave polygon fill
+//-----------------------------------------------------------------------------
+// Triangulate concave polygons. Based on "Triangulation by Ear Clipping" paper, O(N^2) complexity in the worst case.
+// Reference: https://www.geometrictools.com/Documentation/TriangulationByEarClipping.pdf
+// Provided as a convenience for user but not used by main library.
+// Ear tests only need to look at reflex vertices, which we also store in a uniform grid over the polygon bounding box
+// so each test only visits reflex vertices near the candidate triangle. Output is the same as testing all of them.
+// Degenerated polygons (e.g. thousands of coincident points) may pile up reflexes in a few cells: tests overlapping
+// such a cell scan the reflex array instead, so a test never costs more than the plain scan plus a few cell lookups.
+//-----------------------------------------------------------------------------
+// - ImTriangulator [Internal]
+// - AddConcavePolyFilled()
+//-----------------------------------------------------------------------------
+
+enum ImTriangulatorNodeType
+{
+    ImTriangulatorNodeType_Convex,
+    ImTriangulatorNodeType_Ear,
+    ImTriangulatorNodeType_Reflex
+};
+
+struct ImTriangulatorNode
+{
+    ImTriangulatorNodeType  Type;
+    int                     Index;
+    ImVec2                  Pos;
+    ImTriangulatorNode*     Next;
+    ImTriangulatorNode*     Prev;
+    ImTriangulatorNode*     CellNext;       // Next/previous reflex node in same grid cell
+    ImTriangulatorNode*     CellPrev;
+    int                     SpanIndex;      // Index in ImTriangulator::_Ears or _Reflexes
+
+    void    Unlink()        { Next->Prev = Prev; Prev->Next = Next; }
+};
+
+struct ImTriangulatorNodeSpan
+{
+    ImTriangulatorNode**    Data = NULL;
+    int                     Size = 0;
+
+    void    push_back(ImTriangulatorNode* node)     { node->SpanIndex = Size; Data[Size++] = node; }
+    bool    find_erase_unsorted(ImTriangulatorNode* node) { int i = node->SpanIndex; if (i >= Size || Data[i] != node) return false; Data[i] = Data[--Size]; Data[i]->SpanIndex = i; return true; }
+};
+
+struct ImTriangulator
+{
     static int EstimateTriangleCount(int points_count)      { return (points_count < 3) ? 0 : points_count - 2; }
-    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * points_count * 2; }
+    static int EstimateGridCellsCount(int points_count)     { return ImMax(points_count / 2, 1); }
+    static int EstimateScratchBufferSize(int points_count)  { return sizeof(ImTriangulatorNode) * points_count + sizeof(ImTriangulatorNode*) * (points_count * 2 + EstimateGridCellsCount(points_count)) + sizeof(int) * EstimateGridCellsCount(points_count); }
 
     void    Init(const ImVec2* points, int points_count, void* scratch_buffer);
     void    GetNextTriangle(unsigned int out_triangle[3]);     // Return relative indexes for next triangle
 
     // Internal functions
     void    BuildNodes(const ImVec2* points, int points_count);
+    void    BuildGrid(const ImVec2* points, int points_count);
     void    BuildReflexes();
     void    BuildEars();
     void    FlipNodeList();
     bool    IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
+    bool    IsAnyCellReflexInTriangle(int cell_n, int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const;
     void    ReclassifyNode(ImTriangulatorNode* node);
+    void    AddReflex(ImTriangulatorNode* node);
+    void    RemoveReflex(ImTriangulatorNode* node);
+    int     GetGridCellX(float x) const { return ImClamp((int)((x - _GridMin.x) * _GridInvCellSize.x), 0, _GridSizeX - 1); }
+    int     GetGridCellY(float y) const { return ImClamp((int)((y - _GridMin.y) * _GridInvCellSize.y), 0, _GridSizeY - 1); }
 
     // Internal members
     int                     _TrianglesLeft = 0;
     ImTriangulatorNode*     _Nodes = NULL;
     ImTriangulatorNodeSpan  _Ears;
     ImTriangulatorNodeSpan  _Reflexes;
+    ImTriangulatorNode**    _GridCells = NULL;  // Linked list of reflex nodes for each cell
+    int*                    _GridCellsSize = NULL;      // Number of reflex nodes in each cell
+    int                     _GridCellMaxReflexes = 0;   // Ear tests overlapping a cell holding more reflex nodes than this scan _Reflexes instead
+    int                     _GridCrowdedCellsCount = 0; // Number of cells holding more than _GridCellMaxReflexes nodes
+    int                     _GridSizeX = 0;
+    int                     _GridSizeY = 0;
+    ImVec2                  _GridMin;
+    ImVec2                  _GridInvCellSize;
 };
 
-// Distribute storage for nodes, ears and reflexes.
+// Distribute storage for nodes, ears and reflexes grid.
 // FIXME-OPT: if everything is convex, we could report it to caller and let it switch to an convex renderer
 // (this would require first building reflexes to bail to convex if empty, without even building nodes)
 void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_buffer)
@@ -1860,7 +2402,10 @@ void ImTriangulator::Init(const ImVec2* points, int points_count, void* scratch_
     _Nodes         = (ImTriangulatorNode*)scratch_buffer;                          // points_count x Node
     _Ears.Data     = (ImTriangulatorNode**)(_Nodes + points_count);                // points_count x Node*
     _Reflexes.Data = (ImTriangulatorNode**)(_Nodes + points_count) + points_count; // points_count x Node*
+    _GridCells     = _Reflexes.Data + points_count;                                // EstimateGridCellsCount() x Node*
+    _GridCellsSize = (int*)(_GridCells + EstimateGridCellsCount(points_count));    // EstimateGridCellsCount() x int
     BuildNodes(points, points_count);
+    BuildGrid(points, points_count);
     BuildReflexes();
     BuildEars();
 }
@@ -1879,6 +2424,31 @@ void ImTriangulator::BuildNodes(const ImVec2* points, int points_count)
     _Nodes[points_count - 1].Next = _Nodes;
 }
 
+// Size grid cells to follow polygon aspect ratio, with roughly 2 points per cell.
+void ImTriangulator::BuildGrid(const ImVec2* points, int points_count)
+{
+    ImVec2 bb_min = points[0], bb_max = points[0];
+    for (int i = 1; i < points_count; i++)
+    {
+        bb_min = ImMin(bb_min, points[i]);
+        bb_max = ImMax(bb_max, points[i]);
+    }
+    const int cells_count = EstimateGridCellsCount(points_count);
+    const ImVec2 bb_size = bb_max - bb_min;
+    if (bb_size.x > 0.0f && bb_size.y > 0.0f)
+        _GridSizeX = ImClamp((int)ImSqrt(cells_count * bb_size.x / bb_size.y), 1, cells_count);
+    else
+        _GridSizeX = (bb_size.x > 0.0f) ? cells_count : 1;
+    _GridSizeY = cells_count / _GridSizeX;
+    _GridMin = bb_min;
+    _GridInvCellSize.x = (bb_size.x > 0.0f) ? _GridSizeX / bb_size.x : 0.0f;
+    _GridInvCellSize.y = (bb_size.y > 0.0f) ? _GridSizeY / bb_size.y : 0.0f;
+    memset(_GridCells, 0, sizeof(ImTriangulatorNode*) * _GridSizeX * _GridSizeY);
+    memset(_GridCellsSize, 0, sizeof(int) * _GridSizeX * _GridSizeY);
+    _GridCellMaxReflexes = ImMax(64, points_count / 8);
+    _GridCrowdedCellsCount = 0;
+}
+
 void ImTriangulator::BuildReflexes()
 {
     ImTriangulatorNode* n1 = _Nodes;
@@ -1887,7 +2457,7 @@ void ImTriangulator::BuildReflexes()
         if (ImTriangleIsClockwise(n1->Prev->Pos, n1->Pos, n1->Next->Pos))
             continue;
         n1->Type = ImTriangulatorNodeType_Reflex;
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     }
 }
 
@@ -1915,6 +2485,9 @@ void ImTriangulator::GetNextTriangle(unsigned int out_triangle[3])
         for (int i = _TrianglesLeft; i >= 0; i--, node = node->Next)
             node->Type = ImTriangulatorNodeType_Convex;
         _Reflexes.Size = 0;
+        _GridCrowdedCellsCount = 0;
+        memset(_GridCells, 0, sizeof(ImTriangulatorNode*) * _GridSizeX * _GridSizeY);
+        memset(_GridCellsSize, 0, sizeof(int) * _GridSizeX * _GridSizeY);
         BuildReflexes();
         BuildEars();
 
@@ -1965,19 +2538,80 @@ void ImTriangulator::FlipNodeList()
 }
 
 // A triangle is an ear is no other vertex is inside it. We can test reflexes vertices only (see reference algorithm)
+// Large triangles (common with degenerated or self-intersecting polygons) test all reflexes instead of visiting many grid cells,
+// so do triangles overlapping a crowded cell (only looked for when there is one).
 bool ImTriangulator::IsEar(int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
 {
-    ImTriangulatorNode** p_end = _Reflexes.Data + _Reflexes.Size;
-    for (ImTriangulatorNode** p = _Reflexes.Data; p < p_end; p++)
-    {
-        ImTriangulatorNode* reflex = *p;
-        if (reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
-            if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
-                return false;
+    const int cell_x0 = GetGridCellX(ImMin(ImMin(v0.x, v1.x), v2.x));
+    const int cell_x1 = GetGridCellX(ImMax(ImMax(v0.x, v1.x), v2.x));
+    const int cell_y0 = GetGridCellY(ImMin(ImMin(v0.y, v1.y), v2.y));
+    const int cell_y1 = GetGridCellY(ImMax(ImMax(v0.y, v1.y), v2.y));
+    bool use_grid = (cell_x1 - cell_x0 + 1) * (cell_y1 - cell_y0 + 1) <= _Reflexes.Size;
+    for (int cell_y = cell_y0; cell_y <= cell_y1 && use_grid && _GridCrowdedCellsCount > 0; cell_y++)
+        for (int cell_x = cell_x0; cell_x <= cell_x1 && use_grid; cell_x++)
+            use_grid = _GridCellsSize[cell_y * _GridSizeX + cell_x] <= _GridCellMaxReflexes;
+    if (!use_grid)
+    {
+        ImTriangulatorNode** p_end = _Reflexes.Data + _Reflexes.Size;
+        for (ImTriangulatorNode** p = _Reflexes.Data; p < p_end; p++)
+        {
+            ImTriangulatorNode* reflex = *p;
+            if (reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
+                if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
+                    return false;
+        }
+        return true;
     }
+
+    // Visit cell containing the triangle center first, it is the most likely to contain a reflex inside the triangle.
+    const int center_cell_n = GetGridCellY((v0.y + v1.y + v2.y) * (1.0f / 3.0f)) * _GridSizeX + GetGridCellX((v0.x + v1.x + v2.x) * (1.0f / 3.0f));
+    if (IsAnyCellReflexInTriangle(center_cell_n, i0, i1, i2, v0, v1, v2))
+        return false;
+    for (int cell_y = cell_y0; cell_y <= cell_y1; cell_y++)
+        for (int cell_x = cell_x0; cell_x <= cell_x1; cell_x++)
+            if (cell_y * _GridSizeX + cell_x != center_cell_n && IsAnyCellReflexInTriangle(cell_y * _GridSizeX + cell_x, i0, i1, i2, v0, v1, v2))
+                return false;
     return true;
 }
 
+bool ImTriangulator::IsAnyCellReflexInTriangle(int cell_n, int i0, int i1, int i2, const ImVec2& v0, const ImVec2& v1, const ImVec2& v2) const
+{
+    for (const ImTriangulatorNode* reflex = _GridCells[cell_n]; reflex != NULL; reflex = reflex->CellNext)
+        if (reflex->Index != i0 && reflex->Index != i1 && reflex->Index != i2)
+            if (ImTriangleContainsPoint(v0, v1, v2, reflex->Pos))
+                return true;
+    return false;
+}
+
+void ImTriangulator::AddReflex(ImTriangulatorNode* node)
+{
+    _Reflexes.push_back(node);
+    const int cell_n = GetGridCellY(node->Pos.y) * _GridSizeX + GetGridCellX(node->Pos.x);
+    ImTriangulatorNode** cell = &_GridCells[cell_n];
+    if (++_GridCellsSize[cell_n] == _GridCellMaxReflexes + 1)
+        _GridCrowdedCellsCount++;
+    node->CellPrev = NULL;
+    node->CellNext = *cell;
+    if (*cell != NULL)
+        (*cell)->CellPrev = node;
+    *cell = node;
+}
+
+void ImTriangulator::RemoveReflex(ImTriangulatorNode* node)
+{
+    if (!_Reflexes.find_erase_unsorted(node))
+        return;
+    const int cell_n = GetGridCellY(node->Pos.y) * _GridSizeX + GetGridCellX(node->Pos.x);
+    if (_GridCellsSize[cell_n]-- == _GridCellMaxReflexes + 1)
+        _GridCrowdedCellsCount--;
+    if (node->CellPrev != NULL)
+        node->CellPrev->CellNext = node->CellNext;
+    else
+        _GridCells[cell_n] = node->CellNext;
+    if (node->CellNext != NULL)
+        node->CellNext->CellPrev = node->CellPrev;
+}
+
 void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
 {
     // Classify node
@@ -1995,11 +2629,11 @@ void ImTriangulator::ReclassifyNode(ImTriangulatorNode* n1)
     if (type == n1->Type)
         return;
     if (n1->Type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.find_erase_unsorted(n1->Index);
+        RemoveReflex(n1);
     else if (n1->Type == ImTriangulatorNodeType_Ear)
-        _Ears.find_erase_unsorted(n1->Index);
+        _Ears.find_erase_unsorted(n1);
     if (type == ImTriangulatorNodeType_Reflex)
-        _Reflexes.push_back(n1);
+        AddReflex(n1);
     else if (type == ImTriangulatorNodeType_Ear)
         _Ears.push_back(n1);
     n1->Type = type;
@@ -2031,8 +2665,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
         unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
 
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
+        _TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        triangulator.Init(points, points_count, _TempBuffer.Data);
         while (triangulator._TrianglesLeft > 0)
         {
             triangulator.GetNextTriangle(triangle);
@@ -2040,34 +2674,21 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _IdxWritePtr += 3;
         }
 
-        // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
-        for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
-        {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
-        }
+        // Compute normals, then averaged normals
+        _TempBuffer.reserve_discard(points_count * 2);
+        ImVec2* temp_normals = _TempBuffer.Data;
+        ImVec2* temp_miters = temp_normals + points_count;
+        ImDrawList_CalcSegmentNormals(points, points_count, points_count, temp_normals);
+        ImDrawList_CalcPointMiters(temp_normals, points_count, true, temp_miters);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            // Average normals
-            const ImVec2& n0 = temp_normals[i0];
-            const ImVec2& n1 = temp_normals[i1];
-            float dm_x = (n0.x + n1.x) * 0.5f;
-            float dm_y = (n0.y + n1.y) * 0.5f;
-            IM_FIXNORMAL2F(dm_x, dm_y);
-            dm_x *= AA_SIZE * 0.5f;
-            dm_y *= AA_SIZE * 0.5f;
+            const float dm_x = temp_miters[i1].x * (AA_SIZE * 0.5f);
+            const float dm_y = temp_miters[i1].y * (AA_SIZE * 0.5f);
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
+            IM_DRAWVERT_WRITE(&_VtxWritePtr[0], (points[i1].x - dm_x), (points[i1].y - dm_y), uv, col, VtxOrigin);        // Inner
+            IM_DRAWVERT_WRITE(&_VtxWritePtr[1], (points[i1].x + dm_x), (points[i1].y + dm_y), uv, col_trans, VtxOrigin);  // Outer
             _VtxWritePtr += 2;
 
             // Add indexes for fringes
@@ -2085,11 +2706,11 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         PrimReserve(idx_count, vtx_count);
         for (int i = 0; i < vtx_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
+            IM_DRAWVERT_WRITE(&_VtxWritePtr[0], points[i].x, points[i].y, uv, col, VtxOrigin);
             _VtxWritePtr++;
         }
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
+        _TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        triangulator.Init(points, points_count, _TempBuffer.Data);
         while (triangulator._TrianglesLeft > 0)
         {
             triangulator.GetNextTriangle(triangle);
@@ -2310,36 +2931,62 @@ void ImDrawData::AddDrawList(ImDrawList* draw_list)
 {
     IM_ASSERT(CmdLists.Size == CmdListsCount);
     draw_list->_PopUnusedDrawCmd();
+    draw_list->_TessellateDeferredShapes(); // Render() only tessellates the draw lists it added itself
     ImGui::AddDrawListToDrawDataEx(this, &CmdLists, draw_list);
 }
 
+// VtxBuffer was grown by the caller: write de-indexed vertices after existing ones, then move them to the front.
+static void ImDrawData_DeIndexBufferTask(void* task_data, int task_idx)
+{
+    ImDrawList* draw_list = ((ImDrawList**)task_data)[task_idx];
+    const int idx_count = draw_list->IdxBuffer.Size;
+    if (idx_count == 0)
+        return;
+    ImDrawVert* src = draw_list->VtxBuffer.Data;
+    ImDrawVert* dst = src + draw_list->VtxBuffer.Size - idx_count;
+    for (int j = 0; j < idx_count; j++)
+        dst[j] = src[draw_list->IdxBuffer.Data[j]];
+    memmove(src, dst, (size_t)idx_count * sizeof(ImDrawVert));
+    draw_list->VtxBuffer.resize(idx_count);
+    draw_list->IdxBuffer.resize(0);
+}
+
 // For backward compatibility: convert all buffers from indexed to de-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
+// One task per draw list, run in parallel if the current context has a platform_io.Platform_ParallelForFn handler.
 void ImDrawData::DeIndexAllBuffers()
 {
-    ImVector<ImDrawVert> new_vtx_buffer;
+    // Grow buffers first so tasks don't allocate memory
+    for (int i = 0; i < CmdListsCount; i++)
+        if (!CmdLists[i]->IdxBuffer.empty())
+            CmdLists[i]->VtxBuffer.resize(CmdLists[i]->VtxBuffer.Size + CmdLists[i]->IdxBuffer.Size);
+    ImGui::ParallelFor(ImDrawData_DeIndexBufferTask, CmdLists.Data, CmdListsCount);
     TotalVtxCount = TotalIdxCount = 0;
     for (int i = 0; i < CmdListsCount; i++)
-    {
-        ImDrawList* cmd_list = CmdLists[i];
-        if (cmd_list->IdxBuffer.empty())
-            continue;
-        new_vtx_buffer.resize(cmd_list->IdxBuffer.Size);
-        for (int j = 0; j < cmd_list->IdxBuffer.Size; j++)
-            new_vtx_buffer[j] = cmd_list->VtxBuffer[cmd_list->IdxBuffer[j]];
-        cmd_list->VtxBuffer.swap(new_vtx_buffer);
-        cmd_list->IdxBuffer.resize(0);
-        TotalVtxCount += cmd_list->VtxBuffer.Size;
-    }
+        TotalVtxCount += CmdLists[i]->VtxBuffer.Size;
+}
+
+struct ImDrawDataScaleClipRectsTask
+{
+    ImDrawList**    CmdLists;
+    ImVec2          FbScale;
+};
+
+static void ImDrawData_ScaleClipRectsTask(void* task_data, int task_idx)
+{
+    ImDrawDataScaleClipRectsTask* task = (ImDrawDataScaleClipRectsTask*)task_data;
+    const ImVec2 fb_scale = task->FbScale;
+    for (ImDrawCmd& cmd : task->CmdLists[task_idx]->CmdBuffer)
+        cmd.ClipRect = ImVec4(cmd.ClipRect.x * fb_scale.x, cmd.ClipRect.y * fb_scale.y, cmd.ClipRect.z * fb_scale.x, cmd.ClipRect.w * fb_scale.y);
 }
 
 // Helper to scale the ClipRect field of each ImDrawCmd.
 // Use if your final output buffer is at a different scale than draw_data->DisplaySize,
 // or if there is a difference between your window resolution and framebuffer resolution.
+// One task per draw list, run in parallel if the current context has a platform_io.Platform_ParallelForFn handler.
 void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 {
-    for (ImDrawList* draw_list : CmdLists)
-        for (ImDrawCmd& cmd : draw_list->CmdBuffer)
-            cmd.ClipRect = ImVec4(cmd.ClipRect.x * fb_scale.x, cmd.ClipRect.y * fb_scale.y, cmd.ClipRect.z * fb_scale.x, cmd.ClipRect.w * fb_scale.y);
+    ImDrawDataScaleClipRectsTask task = { CmdLists.Data, fb_scale };
+    ImGui::ParallelFor(ImDrawData_ScaleClipRectsTask, &task, CmdLists.Size);
 }
 
 //-----------------------------------------------------------------------------
@@ -2349,6 +2996,7 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    draw_list->_TessellateDeferredShapes();
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
@@ -2359,9 +3007,10 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
     const int col_delta_r = ((int)(col1 >> IM_COL32_R_SHIFT) & 0xFF) - col0_r;
     const int col_delta_g = ((int)(col1 >> IM_COL32_G_SHIFT) & 0xFF) - col0_g;
     const int col_delta_b = ((int)(col1 >> IM_COL32_B_SHIFT) & 0xFF) - col0_b;
+    const ImVec2 vtx_origin = draw_list->VtxOrigin;
     for (ImDrawVert* vert = vert_start; vert < vert_end; vert++)
     {
-        float d = ImDot(vert->pos - gradient_p0, gradient_extent);
+        float d = ImDot(ImDrawVertGetPos(vert, vtx_origin) - gradient_p0, gradient_extent);
         float t = ImClamp(d * gradient_inv_length2, 0.0f, 1.0f);
         int r = (int)(col0_r + col_delta_r * t);
         int g = (int)(col0_g + col_delta_g * t);
@@ -2373,6 +3022,7 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    draw_list->_TessellateDeferredShapes();
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -2381,26 +3031,29 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
 
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
+    const ImVec2 vtx_origin = draw_list->VtxOrigin;
     if (clamp)
     {
         const ImVec2 min = ImMin(uv_a, uv_b);
         const ImVec2 max = ImMax(uv_a, uv_b);
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = ImClamp(uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale), min, max);
+            ImDrawVertSetUV(vertex, ImClamp(uv_a + ImMul(ImDrawVertGetPos(vertex, vtx_origin) - a, scale), min, max));
     }
     else
     {
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-            vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
+            ImDrawVertSetUV(vertex, uv_a + ImMul(ImDrawVertGetPos(vertex, vtx_origin) - a, scale));
     }
 }
 
 void ImGui::ShadeVertsTransformPos(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& pivot_in, float cos_a, float sin_a, const ImVec2& pivot_out)
 {
+    draw_list->_TessellateDeferredShapes();
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
     ImDrawVert* vert_end = draw_list->VtxBuffer.Data + vert_end_idx;
+    const ImVec2 vtx_origin = draw_list->VtxOrigin;
     for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
-        vertex->pos = ImRotate(vertex->pos- pivot_in, cos_a, sin_a) + pivot_out;
+        ImDrawVertSetPos(vertex, ImRotate(ImDrawVertGetPos(vertex, vtx_origin) - pivot_in, cos_a, sin_a) + pivot_out, vtx_origin);
 }
 
 //-----------------------------------------------------------------------------
@@ -2461,6 +3114,30 @@ const char* ImTextureDataGetFormatName(ImTextureFormat format)
     return "N/A";
 }
 
+// Reference implementation of what ImGuiBackendFlags_RendererHasSdfTextures backends output for a texture with IsSdf set.
+// 'texels_per_pixel' is the screen-space derivative of the texture coordinates, in texels (what fwidth() approximates in a shader).
+float ImTextureDataSampleSdf(ImTextureData* tex, ImVec2 uv, float texels_per_pixel)
+{
+    IM_ASSERT(tex->Pixels != NULL);
+    const int alpha_offset = (tex->Format == ImTextureFormat_RGBA32) ? 3 : 0;
+    const float fx = ImClamp(uv.x * tex->Width - 0.5f, 0.0f, (float)(tex->Width - 1));
+    const float fy = ImClamp(uv.y * tex->Height - 0.5f, 0.0f, (float)(tex->Height - 1));
+    const int x0 = (int)fx, y0 = (int)fy;
+    const int x1 = ImMin(x0 + 1, tex->Width - 1), y1 = ImMin(y0 + 1, tex->Height - 1);
+    const float tx = fx - x0, ty = fy - y0;
+    const float a00 = ((const unsigned char*)tex->GetPixelsAt(x0, y0))[alpha_offset];
+    const float a10 = ((const unsigned char*)tex->GetPixelsAt(x1, y0))[alpha_offset];
+    const float a01 = ((const unsigned char*)tex->GetPixelsAt(x0, y1))[alpha_offset];
+    const float a11 = ((const unsigned char*)tex->GetPixelsAt(x1, y1))[alpha_offset];
+    const float d = ImLerp(ImLerp(a00, a10, tx), ImLerp(a01, a11, tx), ty) / 255.0f;
+    if (!tex->IsSdf)
+        return d;
+
+    // Distance field changes by ONEDGE/PADDING units per texel
+    const float w = ((float)IM_FONTATLAS_SDF_ONEDGE_VALUE / IM_FONTATLAS_SDF_PADDING / 255.0f) * texels_per_pixel;
+    return ImSaturate((d - 0.5f) / ImMax(w, 1.0f / 1024.0f) + 0.5f);
+}
+
 void ImTextureData::Create(ImTextureFormat format, int w, int h)
 {
     DestroyPixels();
@@ -2511,6 +3188,9 @@ void ImTextureData::DestroyPixels()
 // - ImFontAtlas::AddFont()
 // - ImFontAtlas::AddFontDefault()
 // - ImFontAtlas::AddFontFromFileTTF()
+// - ImFontAtlasSharedFileDataAcquire()
+// - ImFontAtlasSharedFileDataAddRef()
+// - ImFontAtlasSharedFileDataRelease()
 // - ImFontAtlas::AddFontFromMemoryTTF()
 // - ImFontAtlas::AddFontFromMemoryCompressedTTF()
 // - ImFontAtlas::AddFontFromMemoryCompressedBase85TTF()
@@ -2564,7 +3244,7 @@ void ImTextureData::DestroyPixels()
 // - ImFontAtlasPackAddRect()
 // - ImFontAtlasPackGetRect()
 //-----------------------------------------------------------------------------
-// - ImFontBaked_BuildGrowIndex()
+// - ImFontBaked_BuildGetIndexPage()
 // - ImFontBaked_BuildLoadGlyph()
 // - ImFontAtlasDebugLogTextureRequests()
 //-----------------------------------------------------------------------------
@@ -2626,6 +3306,35 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
 #define IM_FONTGLYPH_INDEX_UNUSED           ((ImU16)-1) // 0xFFFF
 #define IM_FONTGLYPH_INDEX_NOT_FOUND        ((ImU16)-2) // 0xFFFE
 
+static void ImFontBaked_BuildAddIndexPage(ImFontBaked* baked)
+{
+    IM_ASSERT(baked->IndexPages.Size < 0xFFFF);
+    if (baked->IndexPages.Size == baked->IndexPages.Capacity)
+        baked->IndexPages.reserve(baked->IndexPages.Size + ImMax(baked->IndexPages.Size / 2, 1)); // Default ImVector growth would allocate 8 pages ahead
+    baked->IndexPages.resize(baked->IndexPages.Size + 1);
+    ImFontBakedIndexPage* page = &baked->IndexPages.back();
+    for (float& advance_x : page->AdvanceX)
+        advance_x = -1.0f;
+    memset(page->Lookup, 0xFF, sizeof(page->Lookup)); // IM_FONTGLYPH_INDEX_UNUSED
+}
+
+// Return index page holding 'codepoint', allocating it if needed.
+// IndexPages[0] is kept empty and shared by all unallocated entries of IndexPagesMap[], so readers only need to check IndexPagesMap.Size.
+static ImFontBakedIndexPage* ImFontBaked_BuildGetIndexPage(ImFontBaked* baked, unsigned int codepoint)
+{
+    const int page_n = (int)(codepoint >> IM_FONTBAKED_INDEX_PAGE_SHIFT);
+    if (page_n >= baked->IndexPagesMap.Size)
+        baked->IndexPagesMap.resize(page_n + 1, 0);
+    if (baked->IndexPagesMap.Data[page_n] == 0)
+    {
+        if (baked->IndexPages.Size == 0)
+            ImFontBaked_BuildAddIndexPage(baked); // Shared empty page
+        baked->IndexPagesMap.Data[page_n] = (ImU16)baked->IndexPages.Size;
+        ImFontBaked_BuildAddIndexPage(baked);
+    }
+    return &baked->IndexPages.Data[baked->IndexPagesMap.Data[page_n]];
+}
+
 ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
@@ -2635,9 +3344,12 @@ ImFontAtlas::ImFontAtlas()
     TexMinHeight = 128;
     TexMaxWidth = 8192;
     TexMaxHeight = 8192;
+    TexPageWidth = 1024;
+    TexPageHeight = 1024;
     RendererHasTextures = false; // Assumed false by default, as apps can call e.g Atlas::Build() after backend init and before ImGui can update.
     TexNextUniqueID = 1;
     FontNextUniqueID = 1;
+    BakedGeneration = 1;
     Builder = NULL;
 }
 
@@ -2649,6 +3361,7 @@ ImFontAtlas::~ImFontAtlas()
     ClearTexData();
     TexList.clear_delete();
     TexData = NULL;
+    ImFontAtlasGlyphCacheDestroy(this);
 }
 
 void ImFontAtlas::Clear()
@@ -2773,6 +3486,10 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
         builder->BakedDiscardedCount = 0;
     }
 
+    // Evict least recently used glyphs when over budget
+    if (atlas->TexGlyphBudget > 0 && atlas->RendererHasTextures)
+        ImFontAtlasBuildEvictGlyphs(atlas, 2);
+
     // Update texture status
     for (int tex_n = 0; tex_n < atlas->TexList.Size; tex_n++)
     {
@@ -2821,6 +3538,10 @@ void ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool rendere
             tex_n--;
         }
     }
+
+    // Rasterize glyphs loaded during the previous frame (ImFontAtlasFlags_BatchGlyphRasterization)
+    if (builder->PendingGlyphs.Size > 0)
+        ImFontAtlasBuildRasterizePendingGlyphs(atlas);
 }
 
 void ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch, unsigned char* dst_pixels, ImTextureFormat dst_fmt, int dst_pitch, int w, int h)
@@ -2863,7 +3584,8 @@ void ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFo
 void ImFontAtlasTextureBlockPostProcess(ImFontAtlasPostProcessData* data)
 {
     // Multiply operator (legacy)
-    if (data->FontSrc->RasterizerMultiply != 1.0f)
+    // (not applied to signed distance fields: it would move the glyph outline)
+    if (data->FontSrc->RasterizerMultiply != 1.0f && !(data->FontAtlas->Flags & ImFontAtlasFlags_SDF))
         ImFontAtlasTextureBlockPostProcessMultiply(data, data->FontSrc->RasterizerMultiply);
 }
 
@@ -3034,7 +3756,14 @@ ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg_in)
     font->Sources.push_back(font_cfg);
     ImFontAtlasBuildUpdatePointers(this); // Pointers to Sources are otherwise dangling after we called Sources.push_back().
 
-    if (font_cfg->FontDataOwnedByAtlas == false)
+    if (font_cfg->FontDataShared != NULL)
+    {
+        // Shared file data: hold a reference instead of a copy
+        IM_ASSERT(font_cfg->FontData == font_cfg->FontDataShared->Data && font_cfg->FontDataSize == (int)font_cfg->FontDataShared->DataSize);
+        ImFontAtlasSharedFileDataAddRef(font_cfg->FontDataShared);
+        font_cfg->FontDataOwnedByAtlas = true;
+    }
+    else if (font_cfg->FontDataOwnedByAtlas == false)
     {
         font_cfg->FontDataOwnedByAtlas = true;
         font_cfg->FontData = ImMemdup(font_cfg->FontData, (size_t)font_cfg->FontDataSize);
@@ -3125,9 +3854,8 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas!");
-    size_t data_size = 0;
-    void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
-    if (!data)
+    ImFontSharedFileData* shared_data = ImFontAtlasSharedFileDataAcquire(filename);
+    if (!shared_data)
     {
         if (font_cfg_template == NULL || (font_cfg_template->Flags & ImFontFlags_NoLoadError) == 0)
         {
@@ -3144,7 +3872,82 @@ ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels,
         for (p = filename + ImStrlen(filename); p > filename && p[-1] != '/' && p[-1] != '\\'; p--) {}
         ImFormatString(font_cfg.Name, IM_ARRAYSIZE(font_cfg.Name), "%s", p);
     }
-    return AddFontFromMemoryTTF(data, (int)data_size, size_pixels, &font_cfg, glyph_ranges);
+    font_cfg.FontDataShared = shared_data;
+    ImFont* font = AddFontFromMemoryTTF(shared_data->Data, (int)shared_data->DataSize, size_pixels, &font_cfg, glyph_ranges);
+    ImFontAtlasSharedFileDataRelease(shared_data); // Font source holds its own reference
+    return font;
+}
+
+// Font files are shared by all atlases in the process, which may be used from multiple threads with IMGUI_ENABLE_THREAD_LOCAL_CONTEXT.
+static ImFontSharedFileData* GFontSharedFileDataList = NULL;
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+static std::mutex GFontSharedFileDataMutex;
+#define IM_FONTSHAREDFILEDATA_SCOPED_LOCK()   std::lock_guard<std::mutex> shared_file_data_lock(GFontSharedFileDataMutex)
+#else
+#define IM_FONTSHAREDFILEDATA_SCOPED_LOCK()   ((void)0)
+#endif
+
+ImFontSharedFileData* ImFontAtlasSharedFileDataAcquire(const char* filename)
+{
+    IM_FONTSHAREDFILEDATA_SCOPED_LOCK();
+    const ImU64 file_id = ImFileGetUniqueId(filename);
+    for (ImFontSharedFileData* shared_data = GFontSharedFileDataList; shared_data != NULL; shared_data = shared_data->Next)
+        if ((file_id != 0) ? (shared_data->FileId == file_id) : (shared_data->FileId == 0 && strcmp(shared_data->Filename, filename) == 0))
+        {
+            shared_data->RefCount++;
+            return shared_data;
+        }
+
+    // Prefer mapping file, so untouched pages (e.g. unused glyphs of a large CJK font) are never read and all processes share them.
+    size_t data_size = 0;
+    bool data_is_mapped = true;
+    void* data = ImFileMapToMemory(filename, &data_size);
+    if (data == NULL)
+    {
+        data_is_mapped = false;
+        data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
+    }
+    if (data == NULL)
+        return NULL;
+    IMGUI_DEBUG_LOG_FONT("[font] Loaded \"%s\" (%d bytes, %s)\n", filename, (int)data_size, data_is_mapped ? "mapped" : "heap");
+
+    ImFontSharedFileData* shared_data = IM_NEW(ImFontSharedFileData)();
+    shared_data->Next = GFontSharedFileDataList;
+    shared_data->Filename = ImStrdup(filename);
+    shared_data->FileId = file_id;
+    shared_data->Data = data;
+    shared_data->DataSize = data_size;
+    shared_data->RefCount = 1;
+    shared_data->DataIsMapped = data_is_mapped;
+    GFontSharedFileDataList = shared_data;
+    return shared_data;
+}
+
+void ImFontAtlasSharedFileDataAddRef(ImFontSharedFileData* shared_data)
+{
+    IM_FONTSHAREDFILEDATA_SCOPED_LOCK();
+    IM_ASSERT(shared_data->RefCount > 0);
+    shared_data->RefCount++;
+}
+
+void ImFontAtlasSharedFileDataRelease(ImFontSharedFileData* shared_data)
+{
+    IM_FONTSHAREDFILEDATA_SCOPED_LOCK();
+    IM_ASSERT(shared_data->RefCount > 0);
+    if (--shared_data->RefCount > 0)
+        return;
+    for (ImFontSharedFileData** p = &GFontSharedFileDataList; *p != NULL; p = &(*p)->Next)
+        if (*p == shared_data)
+        {
+            *p = shared_data->Next;
+            break;
+        }
+    if (shared_data->DataIsMapped)
+        ImFileUnmap(shared_data->Data, shared_data->DataSize);
+    else
+        IM_FREE(shared_data->Data);
+    IM_FREE(shared_data->Filename);
+    IM_DELETE(shared_data);
 }
 
 // NB: Transfer ownership of 'ttf_data' to ImFontAtlas, unless font_cfg_template->FontDataOwnedByAtlas == false. Owned TTF buffer will be deleted after Build().
@@ -3240,15 +4043,16 @@ void ImFontAtlas::RemoveFont(ImFont* font)
 }
 
 // At it is common to do an AddCustomRect() followed by a GetCustomRect(), we provide an optional 'ImFontAtlasRect* out_r = NULL' argument to retrieve the info straight away.
-ImFontAtlasRectId ImFontAtlas::AddCustomRect(int width, int height, ImFontAtlasRect* out_r)
+ImFontAtlasRectId ImFontAtlas::AddCustomRect(int width, int height, ImFontAtlasRect* out_r, bool colored)
 {
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
+    IM_ASSERT((Flags & ImFontAtlasFlags_SDF) == 0 && "Custom rectangles are not supported with ImFontAtlasFlags_SDF: the whole texture is rendered as a signed distance field.");
 
     if (Builder == NULL)
         ImFontAtlasBuildInit(this);
 
-    ImFontAtlasRectId r_id = ImFontAtlasPackAddRect(this, width, height);
+    ImFontAtlasRectId r_id = ImFontAtlasPackAddRect(this, width, height, NULL, colored);
     if (r_id == ImFontAtlasRectId_Invalid)
         return ImFontAtlasRectId_Invalid;
     if (out_r != NULL)
@@ -3257,7 +4061,7 @@ ImFontAtlasRectId ImFontAtlas::AddCustomRect(int width, int height, ImFontAtlasR
     if (RendererHasTextures)
     {
         ImTextureRect* r = ImFontAtlasPackGetRect(this, r_id);
-        ImFontAtlasTextureBlockQueueUpload(this, TexData, r->x, r->y, r->w, r->h);
+        ImFontAtlasTextureBlockQueueUpload(this, ImFontAtlasPackGetRectTexture(this, r_id), r->x, r->y, r->w, r->h);
     }
     return r_id;
 }
@@ -3291,6 +4095,7 @@ ImFontAtlasRectId ImFontAtlas::AddCustomRectFontGlyphForSize(ImFont* font, float
     IM_ASSERT(font != NULL);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
+    IM_ASSERT((Flags & ImFontAtlasFlags_SDF) == 0 && "Custom rectangles are not supported with ImFontAtlasFlags_SDF: the whole texture is rendered as a signed distance field.");
 
     ImFontBaked* baked = font->GetFontBaked(font_size);
 
@@ -3299,7 +4104,7 @@ ImFontAtlasRectId ImFontAtlas::AddCustomRectFontGlyphForSize(ImFont* font, float
         return ImFontAtlasRectId_Invalid;
     ImTextureRect* r = ImFontAtlasPackGetRect(this, r_id);
     if (RendererHasTextures)
-        ImFontAtlasTextureBlockQueueUpload(this, TexData, r->x, r->y, r->w, r->h);
+        ImFontAtlasTextureBlockQueueUpload(this, ImFontAtlasPackGetRectTexture(this, r_id), r->x, r->y, r->w, r->h);
 
     if (baked->IsGlyphLoaded(codepoint))
         ImFontAtlasBakedDiscardFontGlyph(this, font, baked, baked->FindGlyph(codepoint));
@@ -3333,6 +4138,7 @@ bool ImFontAtlas::GetCustomRect(ImFontAtlasRectId id, ImFontAtlasRect* out_r) co
     out_r->h = r->h;
     out_r->uv0 = ImVec2((float)(r->x), (float)(r->y)) * TexUvScale;
     out_r->uv1 = ImVec2((float)(r->x + r->w), (float)(r->y + r->h)) * TexUvScale;
+    out_r->TexRef = ImFontAtlasPackGetRectTexture((ImFontAtlas*)this, id)->GetTexRef();
     return true;
 }
 
@@ -3383,6 +4189,13 @@ void ImFontAtlasBuildMain(ImFontAtlas* atlas)
 
 void ImFontAtlasBuildGetOversampleFactors(ImFontConfig* src, ImFontBaked* baked, int* out_oversample_h, int* out_oversample_v)
 {
+    // Signed distance fields are sampled with bilinear filtering and don't need oversampling
+    if (baked->ContainerFont->ContainerAtlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        *out_oversample_h = *out_oversample_v = 1;
+        return;
+    }
+
     // Automatically disable horizontal oversampling over size 36
     const float raster_size = baked->Size * baked->RasterizerDensity * src->RasterizerDensity;
     *out_oversample_h = (src->OversampleH != 0) ? src->OversampleH : (raster_size > 36.0f || src->PixelSnapH) ? 1 : 2;
@@ -3425,12 +4238,7 @@ void ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas)
         if (font->EllipsisChar != 0)
             baked->FindGlyph(font->EllipsisChar);
         for (ImFontConfig* src : font->Sources)
-        {
-            const ImWchar* ranges = src->GlyphRanges ? src->GlyphRanges : atlas->GetGlyphRangesDefault();
-            for (; ranges[0]; ranges += 2)
-                for (unsigned int c = ranges[0]; c <= ranges[1] && c <= IM_UNICODE_CODEPOINT_MAX; c++) //-V560
-                    baked->FindGlyph((ImWchar)c);
-        }
+            baked->LoadGlyphs(src->GlyphRanges ? src->GlyphRanges : atlas->GetGlyphRangesDefault());
     }
 }
 
@@ -3482,8 +4290,9 @@ static void ImFontAtlasBuildUpdateBasicTexData(ImFontAtlas* atlas)
     bool add_and_draw = (atlas->GetCustomRect(builder->PackIdMouseCursors, &r) == false);
     if (add_and_draw)
     {
-        builder->PackIdMouseCursors = atlas->AddCustomRect(pack_size.x, pack_size.y, &r);
+        builder->PackIdMouseCursors = ImFontAtlasPackAddRect(atlas, pack_size.x, pack_size.y); // Not AddCustomRect(): the white pixel is also valid in signed distance fields (ImFontAtlasFlags_SDF)
         IM_ASSERT(builder->PackIdMouseCursors != ImFontAtlasRectId_Invalid);
+        atlas->GetCustomRect(builder->PackIdMouseCursors, &r);
 
         // Draw to texture
         if (atlas->Flags & ImFontAtlasFlags_NoMouseCursors)
@@ -3591,6 +4400,7 @@ void ImFontAtlasFontDestroyOutput(ImFontAtlas* atlas, ImFont* font)
     font->ClearOutputData();
     for (ImFontConfig* src : font->Sources)
     {
+        ImFontAtlasBuildDiscardPendingGlyphs(atlas, src);
         const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
         if (loader && loader->FontSrcDestroy != NULL)
             loader->FontSrcDestroy(atlas, src);
@@ -3622,10 +4432,17 @@ void ImFontAtlasFontSourceAddToFont(ImFontAtlas* atlas, ImFont* font, ImFontConf
 
 void ImFontAtlasFontDestroySourceData(ImFontAtlas* atlas, ImFontConfig* src)
 {
-    IM_UNUSED(atlas);
-    if (src->FontDataOwnedByAtlas)
+    ImFontAtlasBuildDiscardPendingGlyphs(atlas, src);
+    if (ImFontAtlasGlyphCache* cache = atlas->GlyphCache) // Address may be reused by another font: forget its hash
+        for (int n = cache->FontDataHashes.Size - 1; n >= 0; n--)
+            if (cache->FontDataHashes[n].FontData == src->FontData)
+                cache->FontDataHashes.erase(&cache->FontDataHashes[n]);
+    if (src->FontDataShared)
+        ImFontAtlasSharedFileDataRelease(src->FontDataShared);
+    else if (src->FontDataOwnedByAtlas)
         IM_FREE(src->FontData);
     src->FontData = NULL;
+    src->FontDataShared = NULL;
     if (src->GlyphExcludeRanges)
         IM_FREE((void*)src->GlyphExcludeRanges);
     src->GlyphExcludeRanges = NULL;
@@ -3647,9 +4464,10 @@ static ImFontGlyph* ImFontAtlasBuildSetupFontBakedEllipsis(ImFontAtlas* atlas, I
     ImFontAtlasRectId dot_r_id = dot_glyph->PackId; // Deep copy to avoid invalidation of glyphs and rect pointers
     ImTextureRect* dot_r = ImFontAtlasPackGetRect(atlas, dot_r_id);
     const int dot_spacing = 1;
-    const float dot_step = (dot_glyph->X1 - dot_glyph->X0) + dot_spacing;
+    const int dot_overlap = (atlas->Flags & ImFontAtlasFlags_SDF) ? IM_FONTATLAS_SDF_PADDING * 2 : 0; // Signed distance fields: overlap padding between dots
+    const float dot_step = (dot_glyph->X1 - dot_glyph->X0) + dot_spacing - dot_overlap;
 
-    ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, (dot_r->w * 3 + dot_spacing * 2), dot_r->h);
+    ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, (dot_r->w * 3 + (dot_spacing - dot_overlap) * 2), dot_r->h);
     ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
 
     ImFontGlyph glyph_in = {};
@@ -3658,7 +4476,7 @@ static ImFontGlyph* ImFontAtlasBuildSetupFontBakedEllipsis(ImFontAtlas* atlas, I
     glyph->AdvanceX = ImMax(dot_glyph->AdvanceX, dot_glyph->X0 + dot_step * 3.0f - dot_spacing); // FIXME: Slightly odd for normally mono-space fonts but since this is used for trailing contents.
     glyph->X0 = dot_glyph->X0;
     glyph->Y0 = dot_glyph->Y0;
-    glyph->X1 = dot_glyph->X0 + dot_step * 3 - dot_spacing;
+    glyph->X1 = dot_glyph->X0 + dot_step * 3 - dot_spacing + dot_overlap;
     glyph->Y1 = dot_glyph->Y1;
     glyph->Visible = true;
     glyph->PackId = pack_id;
@@ -3667,11 +4485,29 @@ static ImFontGlyph* ImFontAtlasBuildSetupFontBakedEllipsis(ImFontAtlas* atlas, I
 
     // Copy to texture, post-process and queue update for backend
     // FIXME-NEWATLAS-V2: Dot glyph is already post-processed as this point, so this would damage it.
+    ImFontAtlasBuildRasterizePendingGlyphs(atlas); // Dot glyph may not be rasterized yet (ImFontAtlasFlags_BatchGlyphRasterization)
     dot_r = ImFontAtlasPackGetRect(atlas, dot_r_id);
-    ImTextureData* tex = atlas->TexData;
+    ImTextureData* src_tex = ImFontAtlasPackGetRectTexture(atlas, dot_r_id); // May be an older page (ImFontAtlasFlags_MultiPage)
+    ImTextureData* dst_tex = ImFontAtlasPackGetRectTexture(atlas, pack_id);
     for (int n = 0; n < 3; n++)
-        ImFontAtlasTextureBlockCopy(tex, dot_r->x, dot_r->y, tex, r->x + (dot_r->w + dot_spacing) * n, r->y, dot_r->w, dot_r->h);
-    ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
+    {
+        const int dst_x = r->x + (dot_r->w + dot_spacing - dot_overlap) * n;
+        if (n == 0 || dot_overlap == 0)
+        {
+            ImFontAtlasTextureBlockCopy(src_tex, dot_r->x, dot_r->y, dst_tex, dst_x, r->y, dot_r->w, dot_r->h);
+            continue;
+        }
+        // Union of overlapping distance fields
+        const int row_bytes = dot_r->w * dst_tex->BytesPerPixel;
+        for (int y = 0; y < dot_r->h; y++)
+        {
+            const unsigned char* src_p = (const unsigned char*)src_tex->GetPixelsAt(dot_r->x, dot_r->y + y);
+            unsigned char* dst_p = (unsigned char*)dst_tex->GetPixelsAt(dst_x, r->y + y);
+            for (int i = 0; i < row_bytes; i++)
+                dst_p[i] = ImMax(dst_p[i], src_p[i]);
+        }
+    }
+    ImFontAtlasTextureBlockQueueUpload(atlas, dst_tex, r->x, r->y, r->w, r->h);
 
     return glyph;
 }
@@ -3751,6 +4587,20 @@ void ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas* atlas, ImFont* font, Im
     }
 }
 
+// Invalidate data derived from baked fonts, stored by contexts using this atlas (e.g. io.ConfigTextSizeCache)
+static void ImFontAtlasBuildNotifyBakedChanged(ImFontAtlas* atlas)
+{
+    atlas->BakedGeneration++;
+}
+
+// Contexts sharing the atlas may discard baked fonts from other threads: read once per lookup, and store the value read
+// alongside the derived data, so it is invalidated by a discard happening while it is being computed.
+int ImFontAtlasGetBakedGeneration(ImFontAtlas* atlas)
+{
+    IM_FONTATLAS_SCOPED_LOCK(atlas);
+    return atlas->BakedGeneration;
+}
+
 void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph)
 {
     if (glyph->PackId != ImFontAtlasRectId_Invalid)
@@ -3762,8 +4612,10 @@ void ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBa
     IM_ASSERT(font->FallbackChar != c && font->EllipsisChar != c); // Unsupported for simplicity
     IM_ASSERT(glyph >= baked->Glyphs.Data && glyph < baked->Glyphs.Data + baked->Glyphs.Size);
     IM_UNUSED(font);
-    baked->IndexLookup[c] = IM_FONTGLYPH_INDEX_UNUSED;
-    baked->IndexAdvanceX[c] = baked->FallbackAdvanceX;
+    ImFontBakedIndexPage* index_page = ImFontBaked_BuildGetIndexPage(baked, c);
+    index_page->Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK] = IM_FONTGLYPH_INDEX_UNUSED;
+    index_page->AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] = baked->FallbackAdvanceX;
+    ImFontAtlasBuildNotifyBakedChanged(atlas);
 }
 
 ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_size, float font_rasterizer_density, ImGuiID baked_id)
@@ -3792,6 +4644,8 @@ ImFontBaked* ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font, float font_si
             loader->FontBakedInit(atlas, src, baked, loader_data_p);
         loader_data_p += loader->FontBakedSrcLoaderDataSize;
     }
+    if (atlas->GlyphCache)
+        ImFontAtlasGlyphCacheBindBaked(atlas, baked);
 
     ImFontAtlasBuildSetupFontBakedBlanks(atlas, baked);
     return baked;
@@ -3848,11 +4702,14 @@ void ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* bake
         IM_FREE(baked->FontLoaderDatas);
         baked->FontLoaderDatas = NULL;
     }
+    if (atlas->GlyphCache)
+        atlas->GlyphCache->BakedMap.SetInt(baked->BakedId, 0);
     builder->BakedMap.SetVoidPtr(baked->BakedId, NULL);
     builder->BakedDiscardedCount++;
     baked->ClearOutputData();
     baked->WantDestroy = true;
     font->LastBaked = NULL;
+    ImFontAtlasBuildNotifyBakedChanged(atlas);
 }
 
 // use unused_frames==0 to discard everything.
@@ -3885,73 +4742,315 @@ void ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames)
     }
 }
 
-// Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
-void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
+// Remove glyphs which are not indexed anymore (e.g. evicted) from Glyphs[], so reloading them doesn't accumulate stale entries.
+// This invalidates ImFontGlyph* pointers into that baked font.
+static void ImFontAtlasBakedCompactGlyphs(ImFontBaked* baked)
 {
-    IM_ASSERT(!atlas->DrawListSharedDatas.contains(data));
-    atlas->DrawListSharedDatas.push_back(data);
+    const int fallback_glyph_index = baked->FallbackGlyphIndex;
+    int dst_n = 0;
+    for (int src_n = 0; src_n < baked->Glyphs.Size; src_n++)
+    {
+        const ImFontGlyph* glyph = &baked->Glyphs.Data[src_n];
+        ImU16* index_lookup = &ImFontBaked_BuildGetIndexPage(baked, glyph->Codepoint)->Lookup[glyph->Codepoint & IM_FONTBAKED_INDEX_PAGE_MASK];
+        const bool is_indexed = (*index_lookup == src_n);
+        if (!is_indexed && src_n != fallback_glyph_index)
+            continue;
+        if (is_indexed)
+            *index_lookup = (ImU16)dst_n;
+        if (src_n == fallback_glyph_index)
+            baked->FallbackGlyphIndex = dst_n;
+        if (dst_n != src_n)
+            baked->Glyphs.Data[dst_n] = *glyph;
+        dst_n++;
+    }
+    baked->Glyphs.resize(dst_n);
 }
 
-void ImFontAtlasRemoveDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
+static int IMGUI_CDECL ImFontAtlasBuildEvictGlyphsCompare(const void* lhs, const void* rhs)
 {
-    IM_ASSERT(atlas->DrawListSharedDatas.contains(data));
-    atlas->DrawListSharedDatas.find_erase(data);
+    const ImU64 a = *(const ImU64*)lhs;
+    const ImU64 b = *(const ImU64*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
 }
 
-// Update texture identifier in all active draw lists
-void ImFontAtlasUpdateDrawListsTextures(ImFontAtlas* atlas, ImTextureRef old_tex, ImTextureRef new_tex)
+// Collect glyphs which may be evicted, sorted by last used frame, oldest first: (LastUsedFrame << 32) | (baked_n << 16) | glyph_n
+static void ImFontAtlasBuildCollectEvictableGlyphs(ImFontAtlas* atlas, int unused_frames, ImVector<ImU64>* out_candidates)
 {
-    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
-        for (ImDrawList* draw_list : shared_data->DrawLists)
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    IM_ASSERT(builder->BakedPool.Size <= 0xFFFF);
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+    {
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        ImFont* font = baked->ContainerFont;
+        if (baked->WantDestroy || (font->Flags & ImFontFlags_LockBakedSizes))
+            continue;
+        for (int glyph_n = 0; glyph_n < baked->Glyphs.Size; glyph_n++)
         {
-            // Replace in command-buffer
-            // (there is not need to replace in ImDrawListSplitter: current channel is in ImDrawList's CmdBuffer[],
-            //  other channels will be on SetCurrentChannel() which already needs to compare CmdHeader anyhow)
-            if (draw_list->CmdBuffer.Size > 0 && draw_list->_CmdHeader.TexRef == old_tex)
-                draw_list->_SetTexture(new_tex);
-
-            // Replace in stack
-            for (ImTextureRef& stacked_tex : draw_list->_TextureStack)
-                if (stacked_tex == old_tex)
-                    stacked_tex = new_tex;
+            const ImFontGlyph* glyph = &baked->Glyphs.Data[glyph_n];
+            if (glyph->PackId == ImFontAtlasRectId_Invalid || glyph->LastUsedFrame + unused_frames > builder->FrameCount)
+                continue;
+            const ImWchar c = (ImWchar)glyph->Codepoint;
+            if (glyph_n == baked->FallbackGlyphIndex || c == font->FallbackChar || c == font->EllipsisChar || ImFontBaked_BuildGetIndexPage(baked, c)->Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK] != glyph_n)
+                continue;
+            out_candidates->push_back(((ImU64)(ImU32)glyph->LastUsedFrame << 32) | ((ImU64)baked_n << 16) | (ImU32)glyph_n);
         }
+    }
+    ImQsort(out_candidates->Data, (size_t)out_candidates->Size, sizeof(ImU64), ImFontAtlasBuildEvictGlyphsCompare);
 }
 
-// Update texture coordinates in all draw list shared context
-// FIXME-NEWATLAS FIXME-OPT: Doesn't seem necessary to update for all, only one bound to current context?
-void ImFontAtlasUpdateDrawListsSharedData(ImFontAtlas* atlas)
+// Evict glyph collected by ImFontAtlasBuildCollectEvictableGlyphs(). Caller needs to call ImFontAtlasBakedCompactGlyphs() on the baked font afterwards.
+static void ImFontAtlasBuildEvictGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImFontGlyph* glyph)
 {
-    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
-        if (shared_data->FontAtlas == atlas)
-        {
-            shared_data->TexUvWhitePixel = atlas->TexUvWhitePixel;
-            shared_data->TexUvLines = atlas->TexUvLines;
-        }
+    if (ImTextureRect* r = ImFontAtlasPackGetRectSafe(atlas, glyph->PackId))
+        baked->MetricsTotalSurface -= r->w * r->h;
+    ImFontAtlasPackDiscardRect(atlas, glyph->PackId);
+    glyph->PackId = ImFontAtlasRectId_Invalid;
+    ImFontBaked_BuildGetIndexPage(baked, glyph->Codepoint)->Lookup[glyph->Codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = IM_FONTGLYPH_INDEX_UNUSED; // Keep AdvanceX[]: the reloaded glyph will be identical.
 }
 
-// Set current texture. This is mostly called from AddTexture() + to handle a failed resize.
-static void ImFontAtlasBuildSetTexture(ImFontAtlas* atlas, ImTextureData* tex)
+// Remove an empty page (ImFontAtlasFlags_MultiPage). Its texture is destroyed next frame, following pages are shifted down.
+static void ImFontAtlasTextureRemovePage(ImFontAtlas* atlas, int page_idx)
 {
-    ImTextureRef old_tex_ref = atlas->TexRef;
-    atlas->TexData = tex;
-    atlas->TexUvScale = ImVec2(1.0f / tex->Width, 1.0f / tex->Height);
-    atlas->TexRef._TexData = tex;
-    //atlas->TexRef._TexID = tex->TexID; // <-- We intentionally don't do that. It would be misleading and betray promise that both fields aren't set.
-    ImFontAtlasUpdateDrawListsTextures(atlas, old_tex_ref, atlas->TexRef);
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    IM_ASSERT(page_idx != builder->PageCurrent && page_idx != builder->PageCurrentColor);
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: removing page %d (Texture #%03d).\n", atlas->TexData->UniqueID, page_idx, builder->Pages[page_idx].Tex->UniqueID);
+    builder->Pages[page_idx].Tex->WantDestroyNextFrame = true;
+    builder->Pages.erase(builder->Pages.Data + page_idx);
+    for (ImU8& rect_page : builder->RectsPage)
+        if (rect_page > page_idx)
+            rect_page--; // Rectangles left in the removed page are all discarded ones, they don't matter
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+        for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
+            if (glyph.PageIdx > (unsigned int)page_idx)
+                glyph.PageIdx--;
+    if (builder->PageCurrent > page_idx)
+        builder->PageCurrent--;
+    if (builder->PageCurrentColor > page_idx)
+        builder->PageCurrentColor--;
 }
 
-// Create a new texture, discard previous one
-ImTextureData* ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h)
+// ImFontAtlasFlags_MultiPage: pages all have the same size and are never shrunk, so evicting glyphs only lowers texture memory by removing pages.
+// Evict all glyphs of least recently used pages which only hold evictable glyphs (no custom rectangles, no glyph used during last 'unused_frames' frames), then remove those pages.
+static void ImFontAtlasBuildEvictPages(ImFontAtlas* atlas, int unused_frames)
 {
-    ImTextureData* old_tex = atlas->TexData;
-    ImTextureData* new_tex;
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    int pages_size = 0;
+    for (ImFontAtlasPage& page : builder->Pages)
+        pages_size += page.Tex->GetSizeInBytes();
+    if (pages_size <= atlas->TexGlyphBudget)
+        return; // Unlike the single page case, retry every frame while over budget: a page becomes evictable once its last glyphs get old, without any new glyph being loaded.
+
+    ImVector<ImU64> candidates;
+    ImFontAtlasBuildCollectEvictableGlyphs(atlas, unused_frames, &candidates);
+
+    // Count evictable glyphs per page. Candidates are sorted so we end up with the most recent frame of each page.
+    ImVector<int> pages_evictable_count;
+    ImVector<int> pages_last_used_frame;
+    pages_evictable_count.resize(builder->Pages.Size, 0);
+    pages_last_used_frame.resize(builder->Pages.Size, 0);
+    for (ImU64 candidate : candidates)
+    {
+        const ImFontGlyph* glyph = &builder->BakedPool[(int)((candidate >> 16) & 0xFFFF)].Glyphs.Data[(int)(candidate & 0xFFFF)];
+        pages_evictable_count[glyph->PageIdx]++;
+        pages_last_used_frame[glyph->PageIdx] = (int)(candidate >> 32);
+    }
+
+    // Select pages to remove, least recently used first: (LastUsedFrame << 32) | page_n
+    // Skip current pages, and the page owning rectangles shared by all pages.
+    const int shared_count = (builder->PackIdLinesTexData != ImFontAtlasRectId_Invalid ? 1 : 0) + (builder->PackIdMouseCursors != ImFontAtlasRectId_Invalid ? 1 : 0);
+    const ImFontAtlasRectId shared_id = (builder->PackIdLinesTexData != ImFontAtlasRectId_Invalid) ? builder->PackIdLinesTexData : builder->PackIdMouseCursors;
+    const int shared_owner_page = (shared_id != ImFontAtlasRectId_Invalid) ? builder->RectsPage[builder->Rects.index_from_ptr(ImFontAtlasPackGetRect(atlas, shared_id))] : -1;
+    ImVector<ImU64> pages_order;
+    for (int page_n = 0; page_n < builder->Pages.Size; page_n++)
+        if (page_n != builder->PageCurrent && page_n != builder->PageCurrentColor && page_n != shared_owner_page && pages_evictable_count[page_n] == builder->Pages[page_n].RectsCount - shared_count)
+            pages_order.push_back(((ImU64)(ImU32)pages_last_used_frame[page_n] << 32) | (ImU32)page_n);
+    ImQsort(pages_order.Data, (size_t)pages_order.Size, sizeof(ImU64), ImFontAtlasBuildEvictGlyphsCompare);
+    ImBitVector pages_removed;
+    pages_removed.Create(builder->Pages.Size);
+    int removed_count = 0;
+    for (int order_n = 0; order_n < pages_order.Size && pages_size > atlas->TexGlyphBudget; order_n++, removed_count++)
+    {
+        const int page_n = (int)(pages_order[order_n] & 0xFFFFFFFF);
+        pages_removed.SetBit(page_n);
+        pages_size -= builder->Pages[page_n].Tex->GetSizeInBytes();
+    }
+
+    // Evict their glyphs, then remove them (highest index first, so lower indices stay valid)
+    ImBitVector baked_evicted;
+    baked_evicted.Create(builder->BakedPool.Size);
+    int evicted_count = 0;
+    for (ImU64 candidate : candidates)
+    {
+        const int baked_n = (int)((candidate >> 16) & 0xFFFF);
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        ImFontGlyph* glyph = &baked->Glyphs.Data[(int)(candidate & 0xFFFF)];
+        if (!pages_removed.TestBit(glyph->PageIdx))
+            continue;
+        ImFontAtlasBuildEvictGlyph(atlas, baked, glyph);
+        baked_evicted.SetBit(baked_n);
+        evicted_count++;
+    }
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size && evicted_count > 0; baked_n++)
+        if (baked_evicted.TestBit(baked_n))
+            ImFontAtlasBakedCompactGlyphs(&builder->BakedPool[baked_n]);
+    for (int page_n = builder->Pages.Size - 1; page_n >= 0; page_n--)
+        if (pages_removed.TestBit(page_n))
+            ImFontAtlasTextureRemovePage(atlas, page_n);
+    IMGUI_DEBUG_LOG_FONT("[font] Evicted %d glyphs, removed %d pages, now using %d bytes out of %d bytes budget.\n", evicted_count, removed_count, pages_size, atlas->TexGlyphBudget);
+}
+
+// Evict least recently used glyphs until texture memory used by packed rectangles fits within ImFontAtlas::TexGlyphBudget.
+// - Evicted glyphs keep their index AdvanceX[] entry so CalcTextSize() is unaffected, and are reloaded by FindGlyph() when rendered again.
+// - Freed texture space is reclaimed by the next repack.
+// - With ImFontAtlasFlags_MultiPage, evict whole pages instead so texture memory goes down, see ImFontAtlasBuildEvictPages().
+// - Called between frames as it invalidates ImFontGlyph* pointers.
+void ImFontAtlasBuildEvictGlyphs(ImFontAtlas* atlas, int unused_frames)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if (builder->Pages.Size > 1)
+    {
+        ImFontAtlasBuildEvictPages(atlas, unused_frames);
+        return;
+    }
+    const int budget_surface = atlas->TexGlyphBudget / atlas->TexData->BytesPerPixel;
+    if (builder->RectsUsedSurface <= budget_surface || builder->RectsUsedSurface <= builder->RectsUsedSurfaceLastEvict)
+        return;
+    ImVector<ImU64> candidates;
+    ImFontAtlasBuildCollectEvictableGlyphs(atlas, unused_frames, &candidates);
 
-    // FIXME: Cannot reuse texture because old UV may have been used already (unless we remap UV).
-    /*if (old_tex != NULL && old_tex->Status == ImTextureStatus_WantCreate)
+    // Evict down to 75% of budget, so we don't need to evict again every time a few glyphs are loaded
+    const int target_surface = budget_surface - budget_surface / 4;
+    ImBitVector baked_evicted;
+    baked_evicted.Create(builder->BakedPool.Size);
+    int evicted_count = 0;
+    for (int candidate_n = 0; candidate_n < candidates.Size && builder->RectsUsedSurface > target_surface; candidate_n++, evicted_count++)
     {
-        // Reuse texture not yet used by backend.
-        IM_ASSERT(old_tex->TexID == ImTextureID_Invalid && old_tex->BackendUserData == NULL);
-        old_tex->DestroyPixels();
+        const int baked_n = (int)((candidates[candidate_n] >> 16) & 0xFFFF);
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        ImFontAtlasBuildEvictGlyph(atlas, baked, &baked->Glyphs.Data[(int)(candidates[candidate_n] & 0xFFFF)]);
+        baked_evicted.SetBit(baked_n);
+    }
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size && evicted_count > 0; baked_n++)
+        if (baked_evicted.TestBit(baked_n))
+            ImFontAtlasBakedCompactGlyphs(&builder->BakedPool[baked_n]);
+    builder->RectsUsedSurfaceLastEvict = builder->RectsUsedSurface;
+    IMGUI_DEBUG_LOG_FONT("[font] Evicted %d glyphs, now using %d px out of %d px budget.\n", evicted_count, builder->RectsUsedSurface, budget_surface);
+}
+
+// Those functions are designed to facilitate changing the underlying structures for ImFontAtlas to store an array of ImDrawListSharedData*
+void ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
+{
+    IM_ASSERT(!atlas->DrawListSharedDatas.contains(data));
+    atlas->DrawListSharedDatas.push_back(data);
+    if (data->FontAtlas == NULL || data->FontAtlas == atlas)
+        data->FontAtlasTexRef = atlas->TexRef;
+}
+
+void ImFontAtlasRemoveDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data)
+{
+    IM_ASSERT(atlas->DrawListSharedDatas.contains(data));
+    atlas->DrawListSharedDatas.find_erase(data);
+}
+
+// With IMGUI_ENABLE_THREAD_LOCAL_CONTEXT, draw lists of other contexts may be in use by other threads:
+// they are not updated right away, instead they are updated from their own thread by ImFontAtlasSyncDrawListSharedData().
+static inline bool ImFontAtlasCanUpdateDrawListSharedData(ImDrawListSharedData* shared_data)
+{
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    return shared_data->Context == NULL || shared_data->Context == GImGui;
+#else
+    IM_UNUSED(shared_data);
+    return true;
+#endif
+}
+
+static void ImFontAtlasUpdateDrawListSharedDataTextures(ImDrawListSharedData* shared_data, ImTextureRef old_tex, ImTextureRef new_tex)
+{
+    for (ImDrawList* draw_list : shared_data->DrawLists)
+    {
+        // Replace in command-buffer
+        // (there is not need to replace in ImDrawListSplitter: current channel is in ImDrawList's CmdBuffer[],
+        //  other channels will be on SetCurrentChannel() which already needs to compare CmdHeader anyhow)
+        if (draw_list->CmdBuffer.Size > 0 && draw_list->_CmdHeader.TexRef == old_tex)
+            draw_list->_SetTexture(new_tex);
+
+        // Replace in stack
+        for (ImTextureRef& stacked_tex : draw_list->_TextureStack)
+            if (stacked_tex == old_tex)
+                stacked_tex = new_tex;
+    }
+    if (shared_data->FontAtlasTexRef == old_tex)
+        shared_data->FontAtlasTexRef = new_tex;
+}
+
+// Update texture identifier in all active draw lists
+void ImFontAtlasUpdateDrawListsTextures(ImFontAtlas* atlas, ImTextureRef old_tex, ImTextureRef new_tex)
+{
+    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
+        if (ImFontAtlasCanUpdateDrawListSharedData(shared_data))
+            ImFontAtlasUpdateDrawListSharedDataTextures(shared_data, old_tex, new_tex);
+}
+
+static void ImFontAtlasUpdateDrawListSharedDataUvs(ImFontAtlas* atlas, ImDrawListSharedData* shared_data)
+{
+    shared_data->TexUvWhitePixel = atlas->TexUvWhitePixel;
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    memcpy(shared_data->TexUvLinesCopy, atlas->TexUvLines, sizeof(atlas->TexUvLines));
+    shared_data->TexUvLines = shared_data->TexUvLinesCopy;
+#else
+    shared_data->TexUvLines = atlas->TexUvLines;
+#endif
+}
+
+// Update texture coordinates in all draw list shared context
+// FIXME-NEWATLAS FIXME-OPT: Doesn't seem necessary to update for all, only one bound to current context?
+void ImFontAtlasUpdateDrawListsSharedData(ImFontAtlas* atlas)
+{
+    for (ImDrawListSharedData* shared_data : atlas->DrawListSharedDatas)
+        if (shared_data->FontAtlas == atlas && ImFontAtlasCanUpdateDrawListSharedData(shared_data))
+            ImFontAtlasUpdateDrawListSharedDataUvs(atlas, shared_data);
+}
+
+// Apply atlas texture changes made by other threads to a draw list shared context and its draw lists. No-op unless IMGUI_ENABLE_THREAD_LOCAL_CONTEXT is defined.
+void ImFontAtlasSyncDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* shared_data)
+{
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    IM_FONTATLAS_SCOPED_LOCK(atlas);
+    if (shared_data->FontAtlas != atlas || shared_data->FontAtlasTexRef == atlas->TexRef)
+        return;
+    ImFontAtlasUpdateDrawListSharedDataTextures(shared_data, shared_data->FontAtlasTexRef, atlas->TexRef);
+    ImFontAtlasUpdateDrawListSharedDataUvs(atlas, shared_data);
+#else
+    IM_UNUSED(atlas);
+    IM_UNUSED(shared_data);
+#endif
+}
+
+// Set current texture. This is mostly called from AddTexture() + to handle a failed resize.
+static void ImFontAtlasBuildSetTexture(ImFontAtlas* atlas, ImTextureData* tex)
+{
+    ImTextureRef old_tex_ref = atlas->TexRef;
+    atlas->TexData = tex;
+    atlas->TexUvScale = ImVec2(1.0f / tex->Width, 1.0f / tex->Height);
+    atlas->TexRef._TexData = tex;
+    //atlas->TexRef._TexID = tex->TexID; // <-- We intentionally don't do that. It would be misleading and betray promise that both fields aren't set.
+    if (atlas->Builder != NULL && atlas->Builder->Pages.Size > 0)
+        atlas->Builder->Pages[atlas->Builder->PageCurrent].Tex = tex;
+    ImFontAtlasUpdateDrawListsTextures(atlas, old_tex_ref, atlas->TexRef);
+}
+
+// Create a new texture, discard previous one
+ImTextureData* ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h)
+{
+    ImTextureData* old_tex = atlas->TexData;
+    ImTextureData* new_tex;
+
+    // FIXME: Cannot reuse texture because old UV may have been used already (unless we remap UV).
+    /*if (old_tex != NULL && old_tex->Status == ImTextureStatus_WantCreate)
+    {
+        // Reuse texture not yet used by backend.
+        IM_ASSERT(old_tex->TexID == ImTextureID_Invalid && old_tex->BackendUserData == NULL);
+        old_tex->DestroyPixels();
         old_tex->Updates.clear();
         new_tex = old_tex;
         old_tex = NULL;
@@ -3972,6 +5071,7 @@ ImTextureData* ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h)
 
     new_tex->Create(atlas->TexDesiredFormat, w, h);
     new_tex->Status = ImTextureStatus_WantCreate;
+    new_tex->IsSdf = (atlas->Flags & ImFontAtlasFlags_SDF) != 0; // Whole texture, which is why AddCustomRect() asserts with ImFontAtlasFlags_SDF
     atlas->TexIsBuilt = false;
 
     ImFontAtlasBuildSetTexture(atlas, new_tex);
@@ -4009,10 +5109,14 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
     // FIXME-NEWATLAS: This is unstable because packing order is based on RectsIndex
     // FIXME-NEWATLAS-V2: Repacking in batch would be beneficial to packing heuristic, and fix stability.
     // FIXME-NEWATLAS-TESTS: Test calling RepackTexture with size too small to fits existing rects.
+    IM_ASSERT(builder->Pages.Size == 1 && "Cannot repack multiple texture pages.");
+    const int old_page_rects_count = builder->Pages[builder->PageCurrent].RectsCount;
     ImFontAtlasPackInit(atlas);
     ImVector<ImTextureRect> old_rects;
+    ImVector<ImU8> old_rects_page;
     ImVector<ImFontAtlasRectEntry> old_index = builder->RectsIndex;
     old_rects.swap(builder->Rects);
+    old_rects_page.swap(builder->RectsPage);
 
     for (ImFontAtlasRectEntry& index_entry : builder->RectsIndex)
     {
@@ -4029,7 +5133,9 @@ void ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w, int h)
             IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: resize failed. Will grow.\n", new_tex->UniqueID);
             new_tex->WantDestroyNextFrame = true;
             builder->Rects.swap(old_rects);
+            builder->RectsPage.swap(old_rects_page);
             builder->RectsIndex = old_index;
+            builder->Pages[builder->PageCurrent].RectsCount = old_page_rects_count;
             ImFontAtlasBuildSetTexture(atlas, old_tex);
             ImFontAtlasTextureGrow(atlas, w, h); // Recurse
             return;
@@ -4067,6 +5173,8 @@ void ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_tex_w, int old_tex_h)
 {
     //ImFontAtlasDebugWriteTexToDisk(atlas->TexData, "Before Grow");
     ImFontAtlasBuilder* builder = atlas->Builder;
+    if (builder->Pages.Size > 1)
+        return; // ImFontAtlasFlags_MultiPage: pages all have the same size
     if (old_tex_w == -1)
         old_tex_w = atlas->TexData->Width;
     if (old_tex_h == -1)
@@ -4089,12 +5197,29 @@ void ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_tex_w, int old_tex_h)
     new_tex_h = ImMax(new_tex_h, ImUpperPowerOfTwo(builder->MaxRectSize.y + pack_padding));
     new_tex_w = ImClamp(new_tex_w, atlas->TexMinWidth, atlas->TexMaxWidth);
     new_tex_h = ImClamp(new_tex_h, atlas->TexMinHeight, atlas->TexMaxHeight);
+    if ((atlas->Flags & ImFontAtlasFlags_MultiPage) && atlas->RendererHasTextures)
+    {
+        IM_ASSERT(ImIsPowerOfTwo(atlas->TexPageWidth) && ImIsPowerOfTwo(atlas->TexPageHeight));
+        new_tex_w = ImMax(ImMin(new_tex_w, atlas->TexPageWidth), old_tex_w);
+        new_tex_h = ImMax(ImMin(new_tex_h, atlas->TexPageHeight), old_tex_h);
+    }
     if (new_tex_w == old_tex_w && new_tex_h == old_tex_h)
         return;
 
     ImFontAtlasTextureRepack(atlas, new_tex_w, new_tex_h);
 }
 
+// With ImFontAtlasFlags_MultiPage, textures stop growing at TexPageWidth x TexPageHeight (or TexMaxWidth x TexMaxHeight if smaller).
+static bool ImFontAtlasTextureIsPageFull(ImFontAtlas* atlas)
+{
+    if ((atlas->Flags & ImFontAtlasFlags_MultiPage) == 0 || !atlas->RendererHasTextures)
+        return false;
+    ImTextureData* tex = atlas->TexData;
+    if (atlas->Builder->Pages.Size > 1)
+        return true;
+    return tex->Width >= ImMin(atlas->TexPageWidth, atlas->TexMaxWidth) && tex->Height >= ImMin(atlas->TexPageHeight, atlas->TexMaxHeight);
+}
+
 void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
 {
     // Can some baked contents be ditched?
@@ -4102,6 +5227,13 @@ void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontAtlasBuildDiscardBakes(atlas, 2);
 
+    // With ImFontAtlasFlags_MultiPage: once texture reached page size, switch to another page instead of growing or repacking.
+    if (ImFontAtlasTextureIsPageFull(atlas))
+    {
+        ImFontAtlasTextureAddPage(atlas);
+        return;
+    }
+
     // Currently using a heuristic for repack without growing.
     if (builder->RectsDiscardedSurface < builder->RectsPackedSurface * 0.20f)
         ImFontAtlasTextureGrow(atlas);
@@ -4109,6 +5241,239 @@ void ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas)
         ImFontAtlasTextureRepack(atlas, atlas->TexData->Width, atlas->TexData->Height);
 }
 
+// Find an empty page of given format to reuse (e.g. emptied by ImFontAtlasBuildDiscardBakes()), otherwise create a new one of same size as current page.
+// Return -1 when reaching IM_FONTATLAS_PAGES_MAX.
+static int ImFontAtlasTextureFindOrAddEmptyPage(ImFontAtlas* atlas, ImTextureFormat format)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* cur_tex = atlas->TexData;
+    const int shared_count = (builder->PackIdLinesTexData != ImFontAtlasRectId_Invalid ? 1 : 0) + (builder->PackIdMouseCursors != ImFontAtlasRectId_Invalid ? 1 : 0);
+    for (int n = 0; n < builder->Pages.Size; n++)
+    {
+        ImFontAtlasPage& page = builder->Pages[n];
+        if (n == builder->PageCurrent || n == builder->PageCurrentColor || page.RectsCount != shared_count || page.Tex->Format != format)
+            continue;
+
+        // Reuse empty page. Clear it as stale pixels may bleed into new rectangles.
+        memset(page.Tex->Pixels, 0, (size_t)page.Tex->GetSizeInBytes());
+        ImFontAtlasTextureBlockQueueUpload(atlas, page.Tex, 0, 0, page.Tex->Width, page.Tex->Height);
+        IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: reusing empty page %d (Texture #%03d, %s).\n", cur_tex->UniqueID, n, page.Tex->UniqueID, ImTextureDataGetFormatName(format));
+        return n;
+    }
+    if (builder->Pages.Size >= IM_FONTATLAS_PAGES_MAX)
+    {
+        IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: reached IM_FONTATLAS_PAGES_MAX.\n", cur_tex->UniqueID);
+        return -1;
+    }
+
+    ImTextureData* new_tex = IM_NEW(ImTextureData)();
+    new_tex->UniqueID = atlas->TexNextUniqueID++;
+    new_tex->Create(format, cur_tex->Width, cur_tex->Height);
+    new_tex->Status = ImTextureStatus_WantCreate;
+    new_tex->UseColors = cur_tex->UseColors;
+    new_tex->IsSdf = cur_tex->IsSdf;
+    atlas->TexList.push_back(new_tex);
+    ImFontAtlasPage page = { new_tex, 0 };
+    builder->Pages.push_back(page);
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: adding page %d (Texture #%03d: %dx%d, %s).\n", cur_tex->UniqueID, builder->Pages.Size - 1, new_tex->UniqueID, new_tex->Width, new_tex->Height, ImTextureDataGetFormatName(format));
+    return builder->Pages.Size - 1;
+}
+
+// Pack rectangles shared by all pages (white pixel, mouse cursors, lines) into an empty page, at the same location they have in 'src_tex'.
+static void ImFontAtlasPackSharedRects(ImFontAtlas* atlas, stbrp_context* pack_context, ImTextureData* src_tex, int page_idx)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* dst_tex = builder->Pages[page_idx].Tex;
+    const ImFontAtlasRectId shared_ids[] = { builder->PackIdLinesTexData, builder->PackIdMouseCursors }; // Same order as ImFontAtlasBuildInit()
+    const int pack_padding = atlas->TexGlyphPadding;
+    for (ImFontAtlasRectId shared_id : shared_ids)
+    {
+        if (shared_id == ImFontAtlasRectId_Invalid)
+            continue;
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, shared_id);
+        stbrp_rect pack_r = {};
+        pack_r.w = r->w + pack_padding;
+        pack_r.h = r->h + pack_padding;
+        stbrp_pack_rects(pack_context, &pack_r, 1);
+        IM_ASSERT(pack_r.was_packed && pack_r.x == r->x && pack_r.y == r->y);
+        ImFontAtlasTextureBlockConvert((const unsigned char*)src_tex->GetPixelsAt(r->x, r->y), src_tex->Format, src_tex->GetPitch(), (unsigned char*)dst_tex->GetPixelsAt(r->x, r->y), dst_tex->Format, dst_tex->GetPitch(), r->w, r->h);
+        ImFontAtlasTextureBlockQueueUpload(atlas, dst_tex, r->x, r->y, r->w, r->h);
+        builder->MaxRectBounds.x = ImMax(builder->MaxRectBounds.x, r->x + r->w + pack_padding);
+        builder->MaxRectBounds.y = ImMax(builder->MaxRectBounds.y, r->y + r->h + pack_padding);
+        builder->Pages[page_idx].RectsCount++;
+    }
+}
+
+// Repack the page with least used surface into a new texture of same size, and switch packing to it (ImFontAtlasFlags_MultiPage).
+// - Called when reaching IM_FONTATLAS_PAGES_MAX. Pages are otherwise never repacked, so this reclaims space left by
+//   glyphs evicted by ImFontAtlasBuildEvictGlyphs() and by discarded rectangles in partially emptied pages.
+// - Like ImFontAtlasTextureRepack(), the old texture is destroyed next frame so draw commands already using it stay valid.
+// - Return false when every page is more than 3/4 full: loading more glyphs then fails with "Out of texture memory" (see IM_FONTATLAS_PAGES_MAX).
+static bool ImFontAtlasTextureRepackEmptiestPage(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* cur_tex = atlas->TexData;
+    const int pack_padding = atlas->TexGlyphPadding;
+
+    // Find page with least used surface (not counting rectangles shared by all pages, which are the same in every page)
+    ImVector<int> pages_surface;
+    pages_surface.resize(builder->Pages.Size, 0);
+    for (int rect_n = 0; rect_n < builder->Rects.Size; rect_n++)
+        if (builder->Rects[rect_n].w != 0)
+            pages_surface[builder->RectsPage[rect_n]] += (builder->Rects[rect_n].w + pack_padding) * (builder->Rects[rect_n].h + pack_padding);
+    int page_idx = -1;
+    for (int n = 0; n < builder->Pages.Size; n++)
+        if (n != builder->PageCurrentColor && builder->Pages[n].Tex->Format == cur_tex->Format && (page_idx == -1 || pages_surface[n] < pages_surface[page_idx]))
+            page_idx = n;
+    const int page_surface = cur_tex->Width * cur_tex->Height;
+    if (page_idx == -1 || pages_surface[page_idx] > page_surface - page_surface / 4)
+    {
+        IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: reached IM_FONTATLAS_PAGES_MAX with all pages more than 3/4 full.\n", cur_tex->UniqueID);
+        return false;
+    }
+
+    // Collect rectangles of the page, skipping shared ones which are packed first at their fixed location
+    ImTextureData* old_tex = builder->Pages[page_idx].Tex;
+    const int shared_lines_idx = (builder->PackIdLinesTexData != ImFontAtlasRectId_Invalid) ? ImFontAtlasRectId_GetIndex(builder->PackIdLinesTexData) : -1;
+    const int shared_cursors_idx = (builder->PackIdMouseCursors != ImFontAtlasRectId_Invalid) ? ImFontAtlasRectId_GetIndex(builder->PackIdMouseCursors) : -1;
+    ImVector<stbrp_rect> pack_rects;
+    for (int index_n = 0; index_n < builder->RectsIndex.Size; index_n++)
+    {
+        const ImFontAtlasRectEntry& index_entry = builder->RectsIndex[index_n];
+        if (!index_entry.IsUsed || index_n == shared_lines_idx || index_n == shared_cursors_idx || builder->RectsPage[index_entry.TargetIndex] != page_idx)
+            continue;
+        const ImTextureRect& r = builder->Rects[index_entry.TargetIndex];
+        stbrp_rect pack_r = {};
+        pack_r.id = index_n;
+        pack_r.w = r.w + pack_padding;
+        pack_r.h = r.h + pack_padding;
+        pack_rects.push_back(pack_r);
+    }
+
+    // Try packing into a scratch context first (shared rectangles first, in the same order as ImFontAtlasPackSharedRects()), so nothing changes on failure
+    {
+        ImVector<stbrp_node_im> pack_nodes;
+        pack_nodes.resize(old_tex->Width / 2);
+        stbrp_context pack_context;
+        stbrp_init_target(&pack_context, old_tex->Width, old_tex->Height, pack_nodes.Data, pack_nodes.Size);
+        const ImFontAtlasRectId shared_ids[] = { builder->PackIdLinesTexData, builder->PackIdMouseCursors };
+        for (ImFontAtlasRectId shared_id : shared_ids)
+            if (shared_id != ImFontAtlasRectId_Invalid)
+            {
+                ImTextureRect* r = ImFontAtlasPackGetRect(atlas, shared_id);
+                stbrp_rect pack_r = {};
+                pack_r.w = r->w + pack_padding;
+                pack_r.h = r->h + pack_padding;
+                stbrp_pack_rects(&pack_context, &pack_r, 1);
+            }
+        stbrp_pack_rects(&pack_context, pack_rects.Data, pack_rects.Size);
+        for (const stbrp_rect& pack_r : pack_rects)
+            if (!pack_r.was_packed)
+            {
+                IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: failed repacking page %d.\n", cur_tex->UniqueID, page_idx);
+                return false;
+            }
+    }
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: reached IM_FONTATLAS_PAGES_MAX, repacking page %d (%d%% used).\n", cur_tex->UniqueID, page_idx, pages_surface[page_idx] * 100 / page_surface);
+
+    // Replace page texture and switch current page to it
+    ImTextureData* new_tex = IM_NEW(ImTextureData)();
+    new_tex->UniqueID = atlas->TexNextUniqueID++;
+    new_tex->Create(old_tex->Format, old_tex->Width, old_tex->Height);
+    new_tex->Status = ImTextureStatus_WantCreate;
+    new_tex->UseColors = old_tex->UseColors;
+    new_tex->IsSdf = old_tex->IsSdf;
+    atlas->TexList.push_back(new_tex);
+    old_tex->WantDestroyNextFrame = true;
+    if (old_tex != cur_tex)
+        ImFontAtlasUpdateDrawListsTextures(atlas, old_tex->GetTexRef(), new_tex->GetTexRef());
+    builder->PageCurrent = page_idx;
+    ImFontAtlasBuildSetTexture(atlas, new_tex);
+    atlas->TexIsBuilt = false;
+
+    // Pack for real (same result as above), copy pixels
+    ImFontAtlasPackInit(atlas);
+    ImFontAtlasPackSharedRects(atlas, (stbrp_context*)(void*)&builder->PackContext, old_tex, page_idx);
+    stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContext, pack_rects.Data, pack_rects.Size);
+    for (const stbrp_rect& pack_r : pack_rects)
+    {
+        IM_ASSERT(pack_r.was_packed);
+        ImTextureRect* r = &builder->Rects[builder->RectsIndex[pack_r.id].TargetIndex];
+        ImFontAtlasTextureBlockCopy(old_tex, r->x, r->y, new_tex, pack_r.x, pack_r.y, r->w, r->h);
+        r->x = (unsigned short)pack_r.x;
+        r->y = (unsigned short)pack_r.y;
+        builder->MaxRectBounds.x = ImMax(builder->MaxRectBounds.x, r->x + r->w + pack_padding);
+        builder->MaxRectBounds.y = ImMax(builder->MaxRectBounds.y, r->y + r->h + pack_padding);
+        builder->RectsPackedCount++;
+        builder->RectsPackedSurface += pack_r.w * pack_r.h;
+        builder->Pages[page_idx].RectsCount++;
+    }
+
+    // Patch glyphs UV
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+        for (ImFontGlyph& glyph : builder->BakedPool[baked_n].Glyphs)
+            if (glyph.PackId != ImFontAtlasRectId_Invalid && glyph.PageIdx == (unsigned int)page_idx)
+            {
+                ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+                glyph.U0 = (r->x) * atlas->TexUvScale.x;
+                glyph.V0 = (r->y) * atlas->TexUvScale.y;
+                glyph.U1 = (r->x + r->w) * atlas->TexUvScale.x;
+                glyph.V1 = (r->y + r->h) * atlas->TexUvScale.y;
+            }
+    return true;
+}
+
+// Switch packing to an empty page (ImFontAtlasFlags_MultiPage), without touching other pages.
+// - Reuse a page emptied by ImFontAtlasBuildDiscardBakes() if any, otherwise create a new one of same size as current page.
+// - Rectangles shared by all pages (white pixel, mouse cursors, lines) are packed first at the same location they have in other pages.
+// - When reaching IM_FONTATLAS_PAGES_MAX, repack the emptiest page instead (see ImFontAtlasTextureRepackEmptiestPage()).
+void ImFontAtlasTextureAddPage(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    ImTextureData* old_tex = atlas->TexData;
+    const int page_idx = ImFontAtlasTextureFindOrAddEmptyPage(atlas, old_tex->Format);
+    if (page_idx == -1)
+    {
+        ImFontAtlasTextureRepackEmptiestPage(atlas);
+        return;
+    }
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: page %d full, switching to page %d.\n", old_tex->UniqueID, builder->PageCurrent, page_idx);
+    atlas->TexIsBuilt = false;
+
+    // Switch current page. Draw commands already using other pages stay valid.
+    builder->PageCurrent = page_idx;
+    ImFontAtlasBuildSetTexture(atlas, builder->Pages[page_idx].Tex);
+    ImFontAtlasPackInit(atlas);
+    ImFontAtlasPackSharedRects(atlas, (stbrp_context*)(void*)&builder->PackContext, old_tex, page_idx);
+}
+
+// Switch packing of colored rectangles to an empty ImTextureFormat_RGBA32 page, when atlas->TexDesiredFormat == ImTextureFormat_Alpha8.
+// - Requires ImFontAtlasFlags_MultiPage. The first time, current page is grown to full page size so all pages keep the same size.
+//   Rectangles shared by all pages are at the same UV in every page, which a color page of a different size would break.
+//   This means a single colored glyph costs a full-size Alpha8 repack + a full-size RGBA32 page (1 MB + 4 MB with default TexPageWidth/TexPageHeight).
+// - The color page never becomes atlas->TexData: it is only referenced by the glyphs and custom rectangles it holds.
+// - Return false when a color page cannot be added: caller then packs into the ImTextureFormat_Alpha8 page and colors are lost.
+bool ImFontAtlasTextureAddColorPage(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if ((atlas->Flags & ImFontAtlasFlags_MultiPage) == 0 || !atlas->RendererHasTextures || atlas->TexData->Format != ImTextureFormat_Alpha8 || builder->LockDisableResize)
+        return false;
+    if (builder->Pages.Size == 1 && !ImFontAtlasTextureIsPageFull(atlas))
+        ImFontAtlasTextureRepack(atlas, ImMax(ImMin(atlas->TexPageWidth, atlas->TexMaxWidth), atlas->TexData->Width), ImMax(ImMin(atlas->TexPageHeight, atlas->TexMaxHeight), atlas->TexData->Height));
+
+    const int page_idx = ImFontAtlasTextureFindOrAddEmptyPage(atlas, ImTextureFormat_RGBA32);
+    if (page_idx == -1)
+        return false;
+    IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: packing colored rectangles into page %d.\n", atlas->TexData->UniqueID, page_idx);
+    ImTextureData* tex = builder->Pages[page_idx].Tex;
+    builder->PageCurrentColor = page_idx;
+    builder->PackNodesColor.resize(tex->Width / 2);
+    stbrp_init_target((stbrp_context*)(void*)&builder->PackContextColor, tex->Width, tex->Height, builder->PackNodesColor.Data, builder->PackNodesColor.Size);
+    builder->Pages[page_idx].RectsCount = 0;
+    ImFontAtlasPackSharedRects(atlas, (stbrp_context*)(void*)&builder->PackContextColor, atlas->TexData, page_idx);
+    return true;
+}
+
 ImVec2i ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas)
 {
     int min_w = ImUpperPowerOfTwo(atlas->TexMinWidth);
@@ -4163,6 +5528,8 @@ void ImFontAtlasTextureCompact(ImFontAtlas* atlas)
 {
     ImFontAtlasBuilder* builder = atlas->Builder;
     ImFontAtlasBuildDiscardBakes(atlas, 1);
+    if (builder->Pages.Size > 1)
+        return; // ImFontAtlasFlags_MultiPage: pages are never repacked, emptied pages get reused by ImFontAtlasTextureAddPage().
 
     ImTextureData* old_tex = atlas->TexData;
     ImVec2i old_tex_size = ImVec2i(old_tex->Width, old_tex->Height);
@@ -4192,11 +5559,23 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 #endif
     }
 
+    // Signed distance fields don't work with baked lines and mouse cursors, which are rendered with plain coverage
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        IM_ASSERT(atlas->FontLoader->SupportsSdf && "ImFontAtlasFlags_SDF is not supported by this font loader!");
+        atlas->Flags |= ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoBakedLines;
+    }
+
     // Create initial texture size
     if (atlas->TexData == NULL || atlas->TexData->Pixels == NULL)
         ImFontAtlasTextureAdd(atlas, ImUpperPowerOfTwo(atlas->TexMinWidth), ImUpperPowerOfTwo(atlas->TexMinHeight));
 
     atlas->Builder = IM_NEW(ImFontAtlasBuilder)();
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    atlas->Builder->Mutex = IM_NEW(std::recursive_mutex)();
+#endif
+    ImFontAtlasPage first_page = { atlas->TexData, 0 };
+    atlas->Builder->Pages.push_back(first_page);
     if (atlas->FontLoader->LoaderInit)
         atlas->FontLoader->LoaderInit(atlas);
 
@@ -4227,10 +5606,41 @@ void ImFontAtlasBuildDestroy(ImFontAtlas* atlas)
         atlas->FontLoader->LoaderShutdown(atlas);
         IM_ASSERT(atlas->FontLoaderData == NULL);
     }
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    if (atlas->Builder)
+        IM_DELETE((std::recursive_mutex*)atlas->Builder->Mutex);
+#endif
+    if (atlas->Builder)
+        for (ImFontAtlasPage& page : atlas->Builder->Pages)
+            if (page.Tex != atlas->TexData)
+                page.Tex->WantDestroyNextFrame = true; // ImFontAtlasFlags_MultiPage: only keep current page
     IM_DELETE(atlas->Builder);
     atlas->Builder = NULL;
 }
 
+// With IMGUI_ENABLE_THREAD_LOCAL_CONTEXT, contexts running in different threads may share an atlas.
+// All accesses to fonts/glyphs data done by ImFont/ImFontBaked functions are then serialized by this lock.
+// Building/clearing the atlas and ImFontAtlasUpdateNewFrame() are not covered and must be done while no other thread is using the atlas.
+void ImFontAtlasLock(ImFontAtlas* atlas)
+{
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    if (atlas->Builder != NULL)
+        ((std::recursive_mutex*)atlas->Builder->Mutex)->lock();
+#else
+    IM_UNUSED(atlas);
+#endif
+}
+
+void ImFontAtlasUnlock(ImFontAtlas* atlas)
+{
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    if (atlas->Builder != NULL)
+        ((std::recursive_mutex*)atlas->Builder->Mutex)->unlock();
+#else
+    IM_UNUSED(atlas);
+#endif
+}
+
 void ImFontAtlasPackInit(ImFontAtlas * atlas)
 {
     ImTextureData* tex = atlas->TexData;
@@ -4244,6 +5654,7 @@ void ImFontAtlasPackInit(ImFontAtlas * atlas)
     builder->RectsPackedSurface = builder->RectsPackedCount = 0;
     builder->MaxRectSize = ImVec2i(0, 0);
     builder->MaxRectBounds = ImVec2i(0, 0);
+    builder->Pages[builder->PageCurrent].RectsCount = 0;
 }
 
 // This is essentially a free-list pattern, it may be nice to wrap it into a dedicated type.
@@ -4299,14 +5710,45 @@ void ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id)
 
     const int pack_padding = atlas->TexGlyphPadding;
     builder->RectsIndexFreeListStart = index_idx;
+    builder->Pages[builder->RectsPage[builder->Rects.index_from_ptr(rect)]].RectsCount--;
     builder->RectsDiscardedCount++;
     builder->RectsDiscardedSurface += (rect->w + pack_padding) * (rect->h + pack_padding);
+    builder->RectsUsedSurface -= (rect->w + pack_padding) * (rect->h + pack_padding);
     rect->w = rect->h = 0; // Clear rectangle so it won't be packed again
 }
 
+// Pack a colored rectangle into Pages[PageCurrentColor], switching to another color page when full.
+// Return false if colored rectangles cannot go to a separate page (see ImFontAtlasTextureAddColorPage()).
+static bool ImFontAtlasPackAddColorRect(ImFontAtlas* atlas, ImTextureRect* r)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if (builder->PageCurrentColor == -1 && !ImFontAtlasTextureAddColorPage(atlas))
+        return false;
+    const int pack_padding = atlas->TexGlyphPadding;
+    for (int attempts_remaining = 1; attempts_remaining >= 0; attempts_remaining--)
+    {
+        stbrp_rect pack_r = {};
+        pack_r.w = r->w + pack_padding;
+        pack_r.h = r->h + pack_padding;
+        stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContextColor, &pack_r, 1);
+        r->x = (unsigned short)pack_r.x;
+        r->y = (unsigned short)pack_r.y;
+        if (pack_r.was_packed)
+            return true;
+        if (attempts_remaining == 0)
+            break;
+        ImFontAtlasBuildDiscardBakes(atlas, 2);
+        if (!ImFontAtlasTextureAddColorPage(atlas))
+            break;
+    }
+    IMGUI_DEBUG_LOG_FONT("[font] Failed packing %dx%d colored rectangle. Packing into current page.\n", r->w, r->h);
+    return false;
+}
+
 // Important: Calling this may recreate a new texture and therefore change atlas->TexData
 // FIXME-NEWFONTS: Expose other glyph padding settings for custom alteration (e.g. drop shadows). See #7962
-ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry)
+// With atlas->TexDesiredFormat == ImTextureFormat_Alpha8 and ImFontAtlasFlags_MultiPage, 'colored' rectangles go to a separate ImTextureFormat_RGBA32 page.
+ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry, bool colored)
 {
     IM_ASSERT(w > 0 && w <= 0xFFFF);
     IM_ASSERT(h > 0 && h <= 0xFFFF);
@@ -4318,39 +5760,57 @@ ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFon
 
     // Pack
     ImTextureRect r = { 0, 0, (unsigned short)w, (unsigned short)h };
-    for (int attempts_remaining = 3; attempts_remaining >= 0; attempts_remaining--)
+    int page_idx;
+    if (colored && overwrite_entry == NULL && atlas->TexDesiredFormat == ImTextureFormat_Alpha8 && ImFontAtlasPackAddColorRect(atlas, &r))
     {
-        // Try packing
-        stbrp_rect pack_r = {};
-        pack_r.w = w + pack_padding;
-        pack_r.h = h + pack_padding;
-        stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContext, &pack_r, 1);
-        r.x = (unsigned short)pack_r.x;
-        r.y = (unsigned short)pack_r.y;
-        if (pack_r.was_packed)
-            break;
-
-        // If we ran out of attempts, return fallback
-        if (attempts_remaining == 0 || builder->LockDisableResize)
+        page_idx = builder->PageCurrentColor;
+    }
+    else
+    {
+        for (int attempts_remaining = 3; attempts_remaining >= 0; attempts_remaining--)
         {
-            IMGUI_DEBUG_LOG_FONT("[font] Failed packing %dx%d rectangle. Returning fallback.\n", w, h);
-            return ImFontAtlasRectId_Invalid;
-        }
+            // Try packing
+            stbrp_rect pack_r = {};
+            pack_r.w = w + pack_padding;
+            pack_r.h = h + pack_padding;
+            stbrp_pack_rects((stbrp_context*)(void*)&builder->PackContext, &pack_r, 1);
+            r.x = (unsigned short)pack_r.x;
+            r.y = (unsigned short)pack_r.y;
+            if (pack_r.was_packed)
+                break;
 
-        // Resize or repack atlas! (this should be a rare event)
-        ImFontAtlasTextureMakeSpace(atlas);
-    }
+            // If we ran out of attempts, return fallback
+            if (attempts_remaining == 0 || builder->LockDisableResize)
+            {
+                IMGUI_DEBUG_LOG_FONT("[font] Failed packing %dx%d rectangle. Returning fallback.\n", w, h);
+                return ImFontAtlasRectId_Invalid;
+            }
 
-    builder->MaxRectBounds.x = ImMax(builder->MaxRectBounds.x, r.x + r.w + pack_padding);
-    builder->MaxRectBounds.y = ImMax(builder->MaxRectBounds.y, r.y + r.h + pack_padding);
-    builder->RectsPackedCount++;
-    builder->RectsPackedSurface += (w + pack_padding) * (h + pack_padding);
+            // Resize or repack atlas! (this should be a rare event)
+            ImFontAtlasTextureMakeSpace(atlas);
+        }
+        page_idx = builder->PageCurrent;
+        builder->MaxRectBounds.x = ImMax(builder->MaxRectBounds.x, r.x + r.w + pack_padding);
+        builder->MaxRectBounds.y = ImMax(builder->MaxRectBounds.y, r.y + r.h + pack_padding);
+        builder->RectsPackedCount++;
+        builder->RectsPackedSurface += (w + pack_padding) * (h + pack_padding);
+    }
 
     builder->Rects.push_back(r);
+    builder->RectsPage.push_back((ImU8)page_idx);
+    builder->Pages[page_idx].RectsCount++;
     if (overwrite_entry != NULL)
         return ImFontAtlasPackReuseRectEntry(atlas, overwrite_entry); // Write into an existing entry instead of adding one (used during repack)
-    else
-        return ImFontAtlasPackAllocRectEntry(atlas, builder->Rects.Size - 1);
+    builder->RectsUsedSurface += (w + pack_padding) * (h + pack_padding);
+    return ImFontAtlasPackAllocRectEntry(atlas, builder->Rects.Size - 1);
+}
+
+// Texture page holding the rectangle (== atlas->TexData unless using ImFontAtlasFlags_MultiPage).
+ImTextureData* ImFontAtlasPackGetRectTexture(ImFontAtlas* atlas, ImFontAtlasRectId id)
+{
+    ImFontAtlasBuilder* builder = (ImFontAtlasBuilder*)atlas->Builder;
+    ImTextureRect* r = ImFontAtlasPackGetRect(atlas, id);
+    return builder->Pages[builder->RectsPage[builder->Rects.index_from_ptr(r)]].Tex;
 }
 
 // Generally for non-user facing functions: assert on invalid ID.
@@ -4394,15 +5854,6 @@ static bool ImFontAtlasBuildAcceptCodepointForSource(ImFontConfig* src, ImWchar
     return true;
 }
 
-static void ImFontBaked_BuildGrowIndex(ImFontBaked* baked, int new_size)
-{
-    IM_ASSERT(baked->IndexAdvanceX.Size == baked->IndexLookup.Size);
-    if (new_size <= baked->IndexLookup.Size)
-        return;
-    baked->IndexAdvanceX.resize(new_size, -1.0f);
-    baked->IndexLookup.resize(new_size, IM_FONTGLYPH_INDEX_UNUSED);
-}
-
 static void ImFontAtlas_FontHookRemapCodepoint(ImFontAtlas* atlas, ImFont* font, ImWchar* c)
 {
     IM_UNUSED(atlas);
@@ -4435,6 +5886,11 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
         if (ImFontGlyph* glyph = ImFontAtlasBuildSetupFontBakedEllipsis(atlas, baked))
             return glyph;
 
+    // Persistent glyph cache
+    if (atlas->GlyphCache)
+        if (ImFontGlyph* glyph = ImFontAtlasGlyphCacheLoadGlyph(atlas, baked, codepoint, src_codepoint))
+            return glyph;
+
     // Call backend
     char* loader_user_data_p = (char*)baked->FontLoaderDatas;
     int src_n = 0;
@@ -4463,9 +5919,9 @@ static ImFontGlyph* ImFontBaked_BuildLoadGlyph(ImFontBaked* baked, ImWchar codep
         ImFontAtlasBuildSetupFontBakedFallback(baked);
 
     // Mark index as not found, so we don't attempt the search twice
-    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
-    baked->IndexAdvanceX[codepoint] = baked->FallbackAdvanceX;
-    baked->IndexLookup[codepoint] = IM_FONTGLYPH_INDEX_NOT_FOUND;
+    ImFontBakedIndexPage* index_page = ImFontBaked_BuildGetIndexPage(baked, codepoint);
+    index_page->AdvanceX[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = baked->FallbackAdvanceX;
+    index_page->Lookup[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = IM_FONTGLYPH_INDEX_NOT_FOUND;
     return NULL;
 }
 
@@ -4476,36 +5932,485 @@ static float BuildLoadGlyphGetAdvanceOrFallback(ImFontBaked* baked, unsigned int
     ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(baked, (ImWchar)codepoint);
     return glyph ? glyph->AdvanceX : baked->FallbackAdvanceX;
 }
-IM_MSVC_RUNTIME_CHECKS_RESTORE
+IM_MSVC_RUNTIME_CHECKS_RESTORE
+
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+void ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas)
+{
+    // [DEBUG] Log texture update requests
+    ImGuiContext& g = *GImGui;
+    IM_UNUSED(g);
+    for (ImTextureData* tex : atlas->TexList)
+    {
+        if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0)
+            IM_ASSERT(tex->Updates.Size == 0);
+        if (tex->Status == ImTextureStatus_WantCreate)
+            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: create %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
+        else if (tex->Status == ImTextureStatus_WantDestroy)
+            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: destroy %dx%d, texid=0x%" IM_PRIX64 ", backend_data=%p\n", tex->UniqueID, tex->Width, tex->Height, tex->TexID, tex->BackendUserData);
+        else if (tex->Status == ImTextureStatus_WantUpdates)
+        {
+            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update %d regions, texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, tex->Updates.Size, tex->TexID, (ImU64)(intptr_t)tex->BackendUserData);
+            for (const ImTextureRect& r : tex->Updates)
+            {
+                IM_UNUSED(r);
+                IM_ASSERT(r.x >= 0 && r.y >= 0);
+                IM_ASSERT(r.x + r.w <= tex->Width && r.y + r.h <= tex->Height); // In theory should subtract PackPadding but it's currently part of atlas and mid-frame change would wreck assert.
+                //IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update (% 4d..%-4d)->(% 4d..%-4d), texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, r.x, r.y, r.x + r.w, r.y + r.h, tex->TexID, (ImU64)(intptr_t)tex->BackendUserData);
+            }
+        }
+    }
+}
+#endif
+
+//-------------------------------------------------------------------------
+// [SECTION] ImFontAtlas: glyph cache
+//-------------------------------------------------------------------------
+// - ImFontAtlas::LoadGlyphCache()
+// - ImFontAtlas::SaveGlyphCache()
+// - ImFontAtlasGlyphCacheGetBakedKey()
+// - ImFontAtlasGlyphCacheBindBaked()
+// - ImFontAtlasGlyphCacheLoadGlyph()
+// - ImFontAtlasGlyphCacheDestroy()
+//-------------------------------------------------------------------------
+
+// Validate whole file once on load, so lookups don't need to do any bound checking.
+static bool ImFontAtlasGlyphCacheValidate(const void* file_data, size_t file_size)
+{
+    if (file_size < sizeof(ImFontAtlasGlyphCacheHeader))
+        return false;
+    const ImFontAtlasGlyphCacheHeader* header = (const ImFontAtlasGlyphCacheHeader*)file_data;
+    if (memcmp(header->Magic, "IMGC", 4) != 0 || header->Version != IM_FONTATLAS_GLYPH_CACHE_VERSION || header->ImGuiVersionNum != IMGUI_VERSION_NUM)
+        return false;
+    if (header->BakedCount > file_size / sizeof(ImFontAtlasGlyphCacheBaked) || header->GlyphsCount > file_size / sizeof(ImFontAtlasGlyphCacheGlyph) || header->PixelsSize > file_size)
+        return false;
+    const ImU64 expected_size = sizeof(ImFontAtlasGlyphCacheHeader) + (ImU64)header->BakedCount * sizeof(ImFontAtlasGlyphCacheBaked) + (ImU64)header->GlyphsCount * sizeof(ImFontAtlasGlyphCacheGlyph) + header->PixelsSize;
+    if (expected_size != file_size)
+        return false;
+
+    const ImFontAtlasGlyphCacheBaked* baked_entries = (const ImFontAtlasGlyphCacheBaked*)(const void*)(header + 1);
+    const ImFontAtlasGlyphCacheGlyph* glyph_entries = (const ImFontAtlasGlyphCacheGlyph*)(const void*)(baked_entries + header->BakedCount);
+    for (ImU32 baked_n = 0; baked_n < header->BakedCount; baked_n++)
+        if (baked_entries[baked_n].GlyphsOffset > header->GlyphsCount || baked_entries[baked_n].GlyphsCount > header->GlyphsCount - baked_entries[baked_n].GlyphsOffset)
+            return false;
+    for (ImU32 glyph_n = 0; glyph_n < header->GlyphsCount; glyph_n++)
+    {
+        const ImFontAtlasGlyphCacheGlyph* entry = &glyph_entries[glyph_n];
+        if (entry->PixelsFormat != ImTextureFormat_Alpha8 && entry->PixelsFormat != ImTextureFormat_RGBA32)
+            return false;
+        const ImU64 pixels_size = (ImU64)entry->Width * entry->Height * ImTextureDataGetFormatBytesPerPixel((ImTextureFormat)entry->PixelsFormat);
+        if (entry->PixelsOffset > header->PixelsSize || pixels_size > header->PixelsSize - entry->PixelsOffset)
+            return false;
+    }
+    return true;
+}
+
+static void ImFontAtlasGlyphCacheSetFileData(ImFontAtlasGlyphCache* cache, void* file_data, size_t file_size, bool file_data_is_mapped)
+{
+    cache->FileData = file_data;
+    cache->FileDataSize = file_size;
+    cache->FileDataIsMapped = file_data_is_mapped;
+    cache->Header = (const ImFontAtlasGlyphCacheHeader*)file_data;
+    cache->Baked = (const ImFontAtlasGlyphCacheBaked*)(const void*)(cache->Header + 1);
+    cache->Glyphs = (const ImFontAtlasGlyphCacheGlyph*)(const void*)(cache->Baked + cache->Header->BakedCount);
+    cache->Pixels = (const unsigned char*)(const void*)(cache->Glyphs + cache->Header->GlyphsCount);
+}
+
+static void ImFontAtlasGlyphCacheFreeFileData(void* file_data, size_t file_size, bool file_data_is_mapped)
+{
+    if (file_data_is_mapped)
+        ImFileUnmap(file_data, file_size);
+    else
+        IM_FREE(file_data);
+}
+
+// The file is memory-mapped when supported, so only pixels of glyphs actually used get paged in.
+// Like font files (see ImFontAtlasSharedFileDataAcquire()), it must not be truncated by another process while loaded.
+bool ImFontAtlas::LoadGlyphCache(const char* filename)
+{
+    IM_FONTATLAS_SCOPED_LOCK(this);
+    size_t file_size = 0;
+    bool file_data_is_mapped = true;
+    void* file_data = ImFileMapToMemory(filename, &file_size);
+    if (file_data == NULL)
+    {
+        file_data_is_mapped = false;
+        file_data = ImFileLoadToMemory(filename, "rb", &file_size);
+    }
+    if (file_data == NULL)
+        return false;
+    if (!ImFontAtlasGlyphCacheValidate(file_data, file_size))
+    {
+        IMGUI_DEBUG_LOG_FONT("[font] Glyph cache \"%s\": invalid or incompatible, ignoring.\n", filename);
+        ImFontAtlasGlyphCacheFreeFileData(file_data, file_size, file_data_is_mapped);
+        return false;
+    }
+
+    ImFontAtlasGlyphCacheDestroy(this);
+    ImFontAtlasGlyphCache* cache = GlyphCache = IM_NEW(ImFontAtlasGlyphCache)();
+    ImFontAtlasGlyphCacheSetFileData(cache, file_data, file_size, file_data_is_mapped);
+    IMGUI_DEBUG_LOG_FONT("[font] Glyph cache \"%s\": loaded %d baked, %d glyphs.\n", filename, cache->Header->BakedCount, cache->Header->GlyphsCount);
+
+    // Bind existing baked fonts. Glyphs already loaded are kept as is.
+    if (Builder != NULL)
+        for (int baked_n = 0; baked_n < Builder->BakedPool.Size; baked_n++)
+            if (!Builder->BakedPool[baked_n].WantDestroy)
+                ImFontAtlasGlyphCacheBindBaked(this, &Builder->BakedPool[baked_n]);
+    return true;
+}
+
+static int IMGUI_CDECL ImFontAtlasGlyphCacheCompareU64(const void* lhs, const void* rhs)
+{
+    const ImU64 a = *(const ImU64*)lhs;
+    const ImU64 b = *(const ImU64*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+// Write all baked fonts currently in the atlas, plus entries of the previously loaded cache which haven't been used during this session.
+bool ImFontAtlas::SaveGlyphCache(const char* filename)
+{
+    IM_FONTATLAS_SCOPED_LOCK(this);
+    ImFontAtlasBuilder* builder = Builder;
+    ImTextureData* tex = TexData;
+    if (builder == NULL || tex == NULL || tex->Pixels == NULL)
+        return false;
+    ImFontAtlasBuildRasterizePendingGlyphs(this);
+
+    ImVector<ImFontAtlasGlyphCacheBaked> out_baked;
+    ImVector<ImFontAtlasGlyphCacheGlyph> out_glyphs;
+    ImVector<unsigned char> out_pixels;
+    ImVector<ImU64> sorted_glyphs;
+    for (int baked_n = 0; baked_n < builder->BakedPool.Size; baked_n++)
+    {
+        ImFontBaked* baked = &builder->BakedPool[baked_n];
+        if (baked->WantDestroy)
+            continue;
+        const ImU64 key = ImFontAtlasGlyphCacheGetBakedKey(this, baked);
+        if (key == 0)
+            continue;
+        bool duplicate_key = false;
+        for (const ImFontAtlasGlyphCacheBaked& entry : out_baked)
+            duplicate_key |= (entry.Key == key);
+        if (duplicate_key)
+            continue;
+
+        // Sort by codepoint as seen by the loader, skipping synthesized glyphs which are created on the fly anyway
+        ImFont* font = baked->ContainerFont;
+        sorted_glyphs.resize(0);
+        for (int glyph_n = 0; glyph_n < baked->Glyphs.Size; glyph_n++)
+        {
+            ImWchar c = (ImWchar)baked->Glyphs[glyph_n].Codepoint;
+            if (c == 0 || c == '\t' || (c == font->EllipsisChar && font->EllipsisAutoBake))
+                continue;
+            ImFontAtlas_FontHookRemapCodepoint(this, font, &c);
+            sorted_glyphs.push_back(((ImU64)c << 32) | (ImU32)glyph_n);
+        }
+        ImQsort(sorted_glyphs.Data, (size_t)sorted_glyphs.Size, sizeof(ImU64), ImFontAtlasGlyphCacheCompareU64);
+
+        ImFontAtlasGlyphCacheBaked baked_entry;
+        baked_entry.Key = key;
+        baked_entry.Ascent = baked->Ascent;
+        baked_entry.Descent = baked->Descent;
+        baked_entry.GlyphsOffset = (ImU32)out_glyphs.Size;
+        for (int sorted_n = 0; sorted_n < sorted_glyphs.Size; sorted_n++)
+        {
+            const ImU32 codepoint = (ImU32)(sorted_glyphs[sorted_n] >> 32);
+            if (sorted_n > 0 && (ImU32)(sorted_glyphs[sorted_n - 1] >> 32) == codepoint)
+                continue; // Multiple codepoints remapped to the same one
+            const ImFontGlyph* glyph = &baked->Glyphs[(int)(sorted_glyphs[sorted_n] & 0xFFFFFFFF)];
+            ImTextureRect* r = (glyph->PackId != ImFontAtlasRectId_Invalid) ? ImFontAtlasPackGetRectSafe(this, glyph->PackId) : NULL;
+            if (glyph->PackId != ImFontAtlasRectId_Invalid && r == NULL)
+                continue;
+
+            ImFontAtlasGlyphCacheGlyph glyph_entry;
+            memset(&glyph_entry, 0, sizeof(glyph_entry));
+            glyph_entry.Codepoint = codepoint;
+            glyph_entry.SourceIdx = (ImU8)glyph->SourceIdx;
+            glyph_entry.Visible = (ImU8)glyph->Visible;
+            glyph_entry.Colored = (ImU8)glyph->Colored;
+            glyph_entry.PixelsFormat = (ImU8)((glyph->Colored && builder->Pages[glyph->PageIdx].Tex->Format == ImTextureFormat_RGBA32) ? ImTextureFormat_RGBA32 : ImTextureFormat_Alpha8);
+            glyph_entry.AdvanceX = glyph->AdvanceX;
+            glyph_entry.X0 = glyph->X0;
+            glyph_entry.Y0 = glyph->Y0;
+            glyph_entry.X1 = glyph->X1;
+            glyph_entry.Y1 = glyph->Y1;
+            if (r != NULL)
+            {
+                ImTextureData* glyph_tex = builder->Pages[glyph->PageIdx].Tex;
+                const int pitch = r->w * ImTextureDataGetFormatBytesPerPixel((ImTextureFormat)glyph_entry.PixelsFormat);
+                glyph_entry.Width = r->w;
+                glyph_entry.Height = r->h;
+                glyph_entry.PixelsOffset = (ImU32)out_pixels.Size;
+                out_pixels.resize(out_pixels.Size + pitch * r->h);
+                ImFontAtlasTextureBlockConvert((const unsigned char*)glyph_tex->GetPixelsAt(r->x, r->y), glyph_tex->Format, glyph_tex->GetPitch(), out_pixels.Data + glyph_entry.PixelsOffset, (ImTextureFormat)glyph_entry.PixelsFormat, pitch, r->w, r->h);
+            }
+            out_glyphs.push_back(glyph_entry);
+        }
+        baked_entry.GlyphsCount = (ImU32)out_glyphs.Size - baked_entry.GlyphsOffset;
+        out_baked.push_back(baked_entry);
+    }
+
+    // Carry over unused entries from previously loaded cache
+    if (ImFontAtlasGlyphCache* cache = GlyphCache)
+        for (ImU32 cache_baked_n = 0; cache_baked_n < cache->Header->BakedCount; cache_baked_n++)
+        {
+            const ImFontAtlasGlyphCacheBaked* cache_baked = &cache->Baked[cache_baked_n];
+            bool duplicate_key = false;
+            for (const ImFontAtlasGlyphCacheBaked& entry : out_baked)
+                duplicate_key |= (entry.Key == cache_baked->Key);
+            if (duplicate_key)
+                continue;
+            ImFontAtlasGlyphCacheBaked baked_entry = *cache_baked;
+            baked_entry.GlyphsOffset = (ImU32)out_glyphs.Size;
+            for (ImU32 glyph_n = 0; glyph_n < cache_baked->GlyphsCount; glyph_n++)
+            {
+                ImFontAtlasGlyphCacheGlyph glyph_entry = cache->Glyphs[cache_baked->GlyphsOffset + glyph_n];
+                const int pixels_size = glyph_entry.Width * glyph_entry.Height * ImTextureDataGetFormatBytesPerPixel((ImTextureFormat)glyph_entry.PixelsFormat);
+                const ImU32 pixels_offset = (ImU32)out_pixels.Size;
+                out_pixels.resize(out_pixels.Size + pixels_size);
+                if (pixels_size > 0)
+                    memcpy(out_pixels.Data + pixels_offset, cache->Pixels + glyph_entry.PixelsOffset, (size_t)pixels_size);
+                glyph_entry.PixelsOffset = pixels_offset;
+                out_glyphs.push_back(glyph_entry);
+            }
+            out_baked.push_back(baked_entry);
+        }
+
+    ImFontAtlasGlyphCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "IMGC", 4);
+    header.Version = IM_FONTATLAS_GLYPH_CACHE_VERSION;
+    header.ImGuiVersionNum = IMGUI_VERSION_NUM;
+    header.BakedCount = (ImU32)out_baked.Size;
+    header.GlyphsCount = (ImU32)out_glyphs.Size;
+    header.PixelsSize = (ImU32)out_pixels.Size;
+
+    // We may be overwriting the file we have mapped: move loaded cache to heap memory first
+    if (GlyphCache != NULL && GlyphCache->FileDataIsMapped)
+    {
+        void* file_data = IM_ALLOC(GlyphCache->FileDataSize);
+        memcpy(file_data, GlyphCache->FileData, GlyphCache->FileDataSize);
+        ImFileUnmap(GlyphCache->FileData, GlyphCache->FileDataSize);
+        ImFontAtlasGlyphCacheSetFileData(GlyphCache, file_data, GlyphCache->FileDataSize, false);
+    }
+
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return false;
+    bool ret = ImFileWrite(&header, sizeof(header), 1, f) == 1;
+    ret &= out_baked.Size == 0 || ImFileWrite(out_baked.Data, (ImU64)out_baked.size_in_bytes(), 1, f) == 1;
+    ret &= out_glyphs.Size == 0 || ImFileWrite(out_glyphs.Data, (ImU64)out_glyphs.size_in_bytes(), 1, f) == 1;
+    ret &= out_pixels.Size == 0 || ImFileWrite(out_pixels.Data, (ImU64)out_pixels.size_in_bytes(), 1, f) == 1;
+    ImFileClose(f);
+    IMGUI_DEBUG_LOG_FONT("[font] Glyph cache \"%s\": saved %d baked, %d glyphs, %d bytes of pixels.\n", filename, out_baked.Size, out_glyphs.Size, out_pixels.Size);
+    return ret;
+}
+
+// Same as ImHashData64() but reading blocks in little-endian order, as keys are stored in files.
+static ImU64 ImFontAtlasGlyphCacheHashData(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const ImU64 k = 0x9E3779B97F4A7C15ULL;
+    const unsigned char* data = (const unsigned char*)data_p;
+    ImU64 h = seed ^ ((ImU64)data_size * k);
+    for (; data_size >= 8; data_size -= 8, data += 8)
+    {
+        ImU64 v = 0;
+        for (int n = 0; n < 8; n++) // Compiled to a single load on little-endian targets
+            v |= (ImU64)data[n] << (n * 8);
+        h = (h ^ v) * k;
+        h ^= h >> 29;
+    }
+    ImU64 v = 0;
+    for (size_t n = 0; n < data_size; n++)
+        v |= (ImU64)data[n] << (n * 8);
+    h = (h ^ v) * k;
+    h ^= h >> 32;
+    return h;
+}
+
+// Parameters serialized byte-wise in little-endian order before hashing (no padding, no pointers, no native layout)
+struct ImFontAtlasGlyphCacheKeyParams
+{
+    unsigned char       Data[128];
+    int                 Size;
+
+    ImFontAtlasGlyphCacheKeyParams()    { Size = 0; }
+    void    AddU32(ImU32 v)             { IM_ASSERT(Size + 4 <= IM_ARRAYSIZE(Data)); for (int n = 0; n < 4; n++) Data[Size++] = (unsigned char)(v >> (n * 8)); }
+    void    AddU64(ImU64 v)             { AddU32((ImU32)v); AddU32((ImU32)(v >> 32)); }
+    void    AddInt(int v)               { AddU32((ImU32)v); }
+    void    AddFloat(float v)           { ImU32 u; memcpy(&u, &v, sizeof(u)); AddU32(u); }
+    ImU64   Hash(ImU64 seed) const      { return ImFontAtlasGlyphCacheHashData(Data, (size_t)Size, seed); }
+};
+
+// Identify a baked font by everything which affects its glyphs output.
+// Sources without TTF data (e.g. procedural custom loaders) cannot be identified, so their baked fonts are never cached.
+// The key doesn't depend on endianness or structure layout, see ImFontAtlasGlyphCacheKeyParams.
+ImU64 ImFontAtlasGlyphCacheGetBakedKey(ImFontAtlas* atlas, ImFontBaked* baked)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    ImFontAtlasGlyphCacheKeyParams baked_params;
+    baked_params.AddFloat(baked->Size);
+    baked_params.AddFloat(baked->RasterizerDensity);
+    if (atlas->Flags & ImFontAtlasFlags_SDF)
+    {
+        baked_params.AddInt(IM_FONTATLAS_SDF_PADDING);
+        baked_params.AddInt(IM_FONTATLAS_SDF_ONEDGE_VALUE);
+    }
+    ImU64 key = baked_params.Hash(IM_FONTATLAS_GLYPH_CACHE_VERSION);
+    for (ImFontConfig* src : baked->ContainerFont->Sources)
+    {
+        if (src->FontData == NULL || src->FontDataSize <= 0)
+            return 0;
+        const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+        if (loader->Name != NULL)
+            key = ImFontAtlasGlyphCacheHashData(loader->Name, strlen(loader->Name), key);
+
+        // Hashing TTF data is the expensive part, keep it around when we have a cache (we always do except when saving without loading first)
+        ImU64 font_data_hash = 0;
+        ImFontAtlasGlyphCacheFontData* font_data_entry = NULL;
+        if (cache != NULL)
+            for (ImFontAtlasGlyphCacheFontData& entry : cache->FontDataHashes)
+                if (entry.FontData == src->FontData && entry.FontDataSize == src->FontDataSize)
+                    font_data_entry = &entry;
+        if (font_data_entry != NULL)
+        {
+            font_data_hash = font_data_entry->Hash;
+        }
+        else
+        {
+            font_data_hash = ImFontAtlasGlyphCacheHashData(src->FontData, (size_t)src->FontDataSize, 0);
+            if (cache != NULL)
+            {
+                ImFontAtlasGlyphCacheFontData new_entry = { src->FontData, src->FontDataSize, font_data_hash };
+                cache->FontDataHashes.push_back(new_entry);
+            }
+        }
+
+        // Settings
+        ImFontAtlasGlyphCacheKeyParams src_params;
+        src_params.AddU64(font_data_hash);
+        src_params.AddInt(src->FontNo);
+        src_params.AddInt(src->OversampleH);
+        src_params.AddInt(src->OversampleV);
+        src_params.AddInt(src->PixelSnapH);
+        src_params.AddInt(src->PixelSnapV);
+        src_params.AddInt(src->Flags);
+        src_params.AddFloat(src->SizePixels);
+        src_params.AddFloat(src->GlyphOffset.x);
+        src_params.AddFloat(src->GlyphOffset.y);
+        src_params.AddFloat(src->GlyphMinAdvanceX);
+        src_params.AddFloat(src->GlyphMaxAdvanceX);
+        src_params.AddFloat(src->GlyphExtraAdvanceX);
+        src_params.AddFloat(src->RasterizerMultiply);
+        src_params.AddFloat(src->RasterizerDensity);
+        src_params.AddU32(src->FontLoaderFlags);
+        src_params.AddU32(atlas->FontLoaderFlags);
+        key = src_params.Hash(key);
+
+        // Excluded ranges decide which source provides a glyph
+        if (const ImWchar* exclude_list = src->GlyphExcludeRanges)
+        {
+            ImFontAtlasGlyphCacheKeyParams exclude_params;
+            for (int n = 0; exclude_list[n] != 0; n++)
+            {
+                exclude_params.AddU32(exclude_list[n]);
+                if (exclude_params.Size == IM_ARRAYSIZE(exclude_params.Data))
+                {
+                    key = exclude_params.Hash(key);
+                    exclude_params.Size = 0;
+                }
+            }
+            key = exclude_params.Hash(key);
+        }
+    }
+    return (key != 0) ? key : 1;
+}
+
+// Called when creating a baked font, or when loading a cache.
+void ImFontAtlasGlyphCacheBindBaked(ImFontAtlas* atlas, ImFontBaked* baked)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    const ImU64 key = ImFontAtlasGlyphCacheGetBakedKey(atlas, baked);
+    if (key == 0)
+        return;
+    for (ImU32 cache_baked_n = 0; cache_baked_n < cache->Header->BakedCount; cache_baked_n++)
+        if (cache->Baked[cache_baked_n].Key == key)
+        {
+            cache->BakedMap.SetInt(baked->BakedId, (int)cache_baked_n + 1);
+            baked->Ascent = cache->Baked[cache_baked_n].Ascent;
+            baked->Descent = cache->Baked[cache_baked_n].Descent;
+            return;
+        }
+}
+
+// Add glyph from cache, bypassing the font loader. Return NULL if not in the cache.
+// - 'codepoint' is the codepoint after applying ImFont::RemapPairs, 'src_codepoint' the requested one.
+ImFontGlyph* ImFontAtlasGlyphCacheLoadGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImWchar codepoint, ImWchar src_codepoint)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    const int cache_baked_n = cache->BakedMap.GetInt(baked->BakedId, 0) - 1;
+    if (cache_baked_n < 0)
+        return NULL;
+
+    // Binary search
+    const ImFontAtlasGlyphCacheBaked* cache_baked = &cache->Baked[cache_baked_n];
+    const ImFontAtlasGlyphCacheGlyph* entry = cache->Glyphs + cache_baked->GlyphsOffset;
+    ImU32 count = cache_baked->GlyphsCount;
+    while (count > 0)
+    {
+        ImU32 count2 = count >> 1;
+        if (entry[count2].Codepoint < (ImU32)codepoint)
+        {
+            entry += count2 + 1;
+            count -= count2 + 1;
+        }
+        else
+        {
+            count = count2;
+        }
+    }
+    if (entry == cache->Glyphs + cache_baked->GlyphsOffset + cache_baked->GlyphsCount || entry->Codepoint != (ImU32)codepoint || entry->SourceIdx >= baked->ContainerFont->Sources.Size)
+        return NULL;
+
+    ImFontGlyph glyph;
+    glyph.Codepoint = src_codepoint;
+    glyph.SourceIdx = entry->SourceIdx;
+    glyph.Visible = entry->Visible;
+    glyph.Colored = entry->Colored;
+    glyph.AdvanceX = entry->AdvanceX;
+    glyph.X0 = entry->X0;
+    glyph.Y0 = entry->Y0;
+    glyph.X1 = entry->X1;
+    glyph.Y1 = entry->Y1;
+    if (entry->Width > 0 && entry->Height > 0)
+    {
+        glyph.PackId = ImFontAtlasPackAddRect(atlas, entry->Width, entry->Height, NULL, entry->PixelsFormat == ImTextureFormat_RGBA32);
+        if (glyph.PackId == ImFontAtlasRectId_Invalid)
+            return NULL; // Let font loader handle out of memory case
+    }
+
+    // Register glyph without applying source settings again: they are already baked in cached values.
+    ImFontGlyph* out_glyph = ImFontAtlasBakedAddFontGlyph(atlas, baked, NULL, &glyph);
+    if (glyph.PackId != ImFontAtlasRectId_Invalid)
+    {
+        ImTextureData* tex = ImFontAtlasPackGetRectTexture(atlas, glyph.PackId);
+        ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph.PackId);
+        const ImTextureFormat src_fmt = (ImTextureFormat)entry->PixelsFormat;
+        ImFontAtlasTextureBlockConvert(cache->Pixels + entry->PixelsOffset, src_fmt, r->w * ImTextureDataGetFormatBytesPerPixel(src_fmt), (unsigned char*)tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h);
+        ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
+    }
+    return out_glyph;
+}
 
-#ifndef IMGUI_DISABLE_DEBUG_TOOLS
-void ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas)
+void ImFontAtlasGlyphCacheDestroy(ImFontAtlas* atlas)
 {
-    // [DEBUG] Log texture update requests
-    ImGuiContext& g = *GImGui;
-    IM_UNUSED(g);
-    for (ImTextureData* tex : atlas->TexList)
+    if (ImFontAtlasGlyphCache* cache = atlas->GlyphCache)
     {
-        if ((g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0)
-            IM_ASSERT(tex->Updates.Size == 0);
-        if (tex->Status == ImTextureStatus_WantCreate)
-            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: create %dx%d\n", tex->UniqueID, tex->Width, tex->Height);
-        else if (tex->Status == ImTextureStatus_WantDestroy)
-            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: destroy %dx%d, texid=0x%" IM_PRIX64 ", backend_data=%p\n", tex->UniqueID, tex->Width, tex->Height, tex->TexID, tex->BackendUserData);
-        else if (tex->Status == ImTextureStatus_WantUpdates)
-        {
-            IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update %d regions, texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, tex->Updates.Size, tex->TexID, (ImU64)(intptr_t)tex->BackendUserData);
-            for (const ImTextureRect& r : tex->Updates)
-            {
-                IM_UNUSED(r);
-                IM_ASSERT(r.x >= 0 && r.y >= 0);
-                IM_ASSERT(r.x + r.w <= tex->Width && r.y + r.h <= tex->Height); // In theory should subtract PackPadding but it's currently part of atlas and mid-frame change would wreck assert.
-                //IMGUI_DEBUG_LOG_FONT("[font] Texture #%03d: update (% 4d..%-4d)->(% 4d..%-4d), texid=0x%" IM_PRIX64 ", backend_data=0x%" IM_PRIX64 "\n", tex->UniqueID, r.x, r.y, r.x + r.w, r.y + r.h, tex->TexID, (ImU64)(intptr_t)tex->BackendUserData);
-            }
-        }
+        ImFontAtlasGlyphCacheFreeFileData(cache->FileData, cache->FileDataSize, cache->FileDataIsMapped);
+        IM_DELETE(cache);
+        atlas->GlyphCache = NULL;
     }
 }
-#endif
 
 //-------------------------------------------------------------------------
 // [SECTION] ImFontAtlas: backend for stb_truetype
@@ -4515,13 +6420,127 @@ void ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas)
 
 #ifdef IMGUI_ENABLE_STB_TRUETYPE
 
+// Codepoint -> glyph index table built from the font 'cmap', so FontSrcContainsGlyph()/FontBakedLoadGlyph() don't need to binary search
+// the cmap subtable for every lookup (which adds up when merging many fonts: each miss is tested against every source).
+// Stored as pages of 256 codepoints. CmapPagesMap[] entries index CmapGlyphs[] in units of pages, page 0 is a shared empty page for unmapped ranges.
+// FontSrcInit() only walks the subtable ranges to find which pages may contain glyphs: each page is filled on its first lookup, so a large
+// CJK font only pays for the blocks actually used. Lookups happen under the atlas lock (see ImFontAtlasLock()).
+#define IM_STBTT_CMAP_PAGE_SHIFT    8
+#define IM_STBTT_CMAP_PAGE_SIZE     (1 << IM_STBTT_CMAP_PAGE_SHIFT)
+#define IM_STBTT_CMAP_PAGE_MASK     (IM_STBTT_CMAP_PAGE_SIZE - 1)
+#define IM_STBTT_CMAP_PAGE_UNBUILT  0xFFFF  // CmapPagesMap[] value for a page with mapped ranges, not yet filled
+
 // One for each ConfigData
 struct ImGui_ImplStbTrueType_FontSrcData
 {
     stbtt_fontinfo  FontInfo;
     float           ScaleFactor;
+    ImVector<ImU16> CmapPagesMap;   // [codepoint >> IM_STBTT_CMAP_PAGE_SHIFT] -> page number in CmapGlyphs[]
+    ImVector<ImU16> CmapGlyphs;     // [page * IM_STBTT_CMAP_PAGE_SIZE + (codepoint & IM_STBTT_CMAP_PAGE_MASK)] -> glyph index, 0 when not mapped
 };
 
+// Fill a page on first lookup. Pages without any glyph keep pointing to the shared empty page.
+static ImU16 ImGui_ImplStbTrueType_BuildCmapPage(ImGui_ImplStbTrueType_FontSrcData* bd_font_data, unsigned int page_n)
+{
+    ImU16 page_glyphs[IM_STBTT_CMAP_PAGE_SIZE];
+    bool page_used = false;
+    for (unsigned int n = 0; n < IM_STBTT_CMAP_PAGE_SIZE; n++)
+    {
+        // Let stb_truetype resolve the glyph index so we stay in sync with its interpretation of each subtable format.
+        const unsigned int c = (page_n << IM_STBTT_CMAP_PAGE_SHIFT) + n;
+        const int glyph_index = (c <= IM_UNICODE_CODEPOINT_MAX) ? stbtt_FindGlyphIndex(&bd_font_data->FontInfo, (int)c) : 0;
+        page_glyphs[n] = (glyph_index > 0 && glyph_index <= 0xFFFF) ? (ImU16)glyph_index : 0;
+        page_used |= (page_glyphs[n] != 0);
+    }
+    ImU16 page = 0;
+    if (page_used)
+    {
+        page = (ImU16)(bd_font_data->CmapGlyphs.Size >> IM_STBTT_CMAP_PAGE_SHIFT);
+        bd_font_data->CmapGlyphs.resize(bd_font_data->CmapGlyphs.Size + IM_STBTT_CMAP_PAGE_SIZE);
+        memcpy(bd_font_data->CmapGlyphs.Data + ((int)page << IM_STBTT_CMAP_PAGE_SHIFT), page_glyphs, sizeof(page_glyphs));
+    }
+    bd_font_data->CmapPagesMap.Data[page_n] = page;
+    return page;
+}
+
+static inline int ImGui_ImplStbTrueType_FindGlyphIndex(ImGui_ImplStbTrueType_FontSrcData* bd_font_data, ImWchar codepoint)
+{
+    const unsigned int page_n = (unsigned int)codepoint >> IM_STBTT_CMAP_PAGE_SHIFT;
+    if (page_n >= (unsigned int)bd_font_data->CmapPagesMap.Size)
+        return 0;
+    unsigned int page = bd_font_data->CmapPagesMap.Data[page_n];
+    if (page == IM_STBTT_CMAP_PAGE_UNBUILT)
+        page = ImGui_ImplStbTrueType_BuildCmapPage(bd_font_data, page_n);
+    return bd_font_data->CmapGlyphs.Data[(page << IM_STBTT_CMAP_PAGE_SHIFT) + (codepoint & IM_STBTT_CMAP_PAGE_MASK)];
+}
+
+static void ImGui_ImplStbTrueType_BuildCmapAddRange(ImGui_ImplStbTrueType_FontSrcData* bd_font_data, unsigned int c_begin, unsigned int c_end)
+{
+    if (c_end > IM_UNICODE_CODEPOINT_MAX)
+        c_end = IM_UNICODE_CODEPOINT_MAX;
+    const int page_begin = (int)(c_begin >> IM_STBTT_CMAP_PAGE_SHIFT);
+    const int page_end = (int)(c_end >> IM_STBTT_CMAP_PAGE_SHIFT);
+    if (page_end >= bd_font_data->CmapPagesMap.Size)
+    {
+        int old_size = bd_font_data->CmapPagesMap.Size;
+        bd_font_data->CmapPagesMap.resize(page_end + 1);
+        memset(bd_font_data->CmapPagesMap.Data + old_size, 0, (size_t)(page_end + 1 - old_size) * sizeof(ImU16));
+    }
+    for (int page_n = page_begin; page_n <= page_end; page_n++)
+        bd_font_data->CmapPagesMap.Data[page_n] = IM_STBTT_CMAP_PAGE_UNBUILT;
+}
+
+static inline unsigned int ImGui_ImplStbTrueType_ReadU16(const unsigned char* p) { return ((unsigned int)p[0] << 8) | (unsigned int)p[1]; }
+static inline unsigned int ImGui_ImplStbTrueType_ReadU32(const unsigned char* p) { return ((unsigned int)p[0] << 24) | ((unsigned int)p[1] << 16) | ((unsigned int)p[2] << 8) | (unsigned int)p[3]; }
+
+// Enumerate codepoint ranges of the cmap subtable selected by stbtt_InitFont(), and mark their pages to be filled on first lookup.
+// Subtable formats not supported by stbtt_FindGlyphIndex() (e.g. format 2) are left empty, matching its behavior of mapping nothing.
+static void ImGui_ImplStbTrueType_BuildCmap(ImGui_ImplStbTrueType_FontSrcData* bd_font_data)
+{
+    const unsigned char* data = bd_font_data->FontInfo.data + bd_font_data->FontInfo.index_map;
+    bd_font_data->CmapPagesMap.clear();
+    bd_font_data->CmapGlyphs.clear();
+    bd_font_data->CmapGlyphs.resize(IM_STBTT_CMAP_PAGE_SIZE, 0); // Page 0: empty
+    const unsigned int format = ImGui_ImplStbTrueType_ReadU16(data);
+    if (format == 0) // Byte encoding table
+    {
+        const unsigned int bytes = ImGui_ImplStbTrueType_ReadU16(data + 2);
+        if (bytes > 6)
+            ImGui_ImplStbTrueType_BuildCmapAddRange(bd_font_data, 0, bytes - 7);
+    }
+    else if (format == 6) // Trimmed table mapping
+    {
+        const unsigned int first = ImGui_ImplStbTrueType_ReadU16(data + 6);
+        const unsigned int count = ImGui_ImplStbTrueType_ReadU16(data + 8);
+        if (count > 0)
+            ImGui_ImplStbTrueType_BuildCmapAddRange(bd_font_data, first, first + count - 1);
+    }
+    else if (format == 4) // Segment mapping to delta values
+    {
+        const unsigned int seg_count = ImGui_ImplStbTrueType_ReadU16(data + 6) >> 1;
+        const unsigned char* end_codes = data + 14;
+        const unsigned char* start_codes = data + 14 + seg_count * 2 + 2;
+        for (unsigned int seg_n = 0; seg_n < seg_count; seg_n++)
+        {
+            const unsigned int c_begin = ImGui_ImplStbTrueType_ReadU16(start_codes + seg_n * 2);
+            const unsigned int c_end = ImGui_ImplStbTrueType_ReadU16(end_codes + seg_n * 2);
+            if (c_begin <= c_end)
+                ImGui_ImplStbTrueType_BuildCmapAddRange(bd_font_data, c_begin, c_end);
+        }
+    }
+    else if (format == 12 || format == 13) // Segmented coverage, many-to-one range mappings
+    {
+        const unsigned int groups_count = ImGui_ImplStbTrueType_ReadU32(data + 12);
+        for (unsigned int group_n = 0; group_n < groups_count; group_n++)
+        {
+            const unsigned int c_begin = ImGui_ImplStbTrueType_ReadU32(data + 16 + group_n * 12);
+            const unsigned int c_end = ImGui_ImplStbTrueType_ReadU32(data + 16 + group_n * 12 + 4);
+            if (c_begin <= c_end && c_begin <= IM_UNICODE_CODEPOINT_MAX)
+                ImGui_ImplStbTrueType_BuildCmapAddRange(bd_font_data, c_begin, c_end);
+        }
+    }
+}
+
 static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig* src)
 {
     IM_UNUSED(atlas);
@@ -4543,6 +6562,8 @@ static bool ImGui_ImplStbTrueType_FontSrcInit(ImFontAtlas* atlas, ImFontConfig*
         IM_ASSERT_USER_ERROR(0, "stbtt_InitFont(): failed to parse FontData. It is correct and complete? Check FontDataSize.");
         return false;
     }
+    bd_font_data->FontInfo.userdata = NULL; // Use IM_ALLOC(), see ImGui_ImplStbTrueType_RasterizePendingGlyph()
+    ImGui_ImplStbTrueType_BuildCmap(bd_font_data);
     src->FontLoaderData = bd_font_data;
 
     if (src->MergeMode && src->SizePixels == 0.0f)
@@ -4573,7 +6594,7 @@ static bool ImGui_ImplStbTrueType_FontSrcContainsGlyph(ImFontAtlas* atlas, ImFon
     ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
     IM_ASSERT(bd_font_data != NULL);
 
-    int glyph_index = stbtt_FindGlyphIndex(&bd_font_data->FontInfo, (int)codepoint);
+    int glyph_index = ImGui_ImplStbTrueType_FindGlyphIndex(bd_font_data, codepoint);
     return glyph_index != 0;
 }
 
@@ -4595,12 +6616,140 @@ static bool ImGui_ImplStbTrueType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig
     return true;
 }
 
+// Oversampling box filters, equivalent to stbtt__h_prefilter()/stbtt__v_prefilter() (output is identical).
+// - Pixels are filtered in place, each output pixel being the average of itself and the 'kernel_width - 1' pixels preceding it.
+//   Pixels past 'w - kernel_width' (or 'h - kernel_width') are expected to be cleared, as stbtt_MakeGlyphBitmapSubpixel() leaves them.
+// - The SSE path processes 16 pixels at a time, walking backward so that inputs are read before being overwritten.
+//   Sums fit in 16-bit lanes (255 * STBTT_MAX_OVERSAMPLE), and division by 'kernel_width' is done with an exact multiply-high.
+#ifdef IMGUI_ENABLE_SSE
+static inline __m128i ImGui_ImplStbTrueType_PrefilterDiv(__m128i sum_lo, __m128i sum_hi, __m128i div_mul)
+{
+    return _mm_packus_epi16(_mm_mulhi_epu16(sum_lo, div_mul), _mm_mulhi_epu16(sum_hi, div_mul));
+}
+#endif
+
+static void ImGui_ImplStbTrueType_HPrefilter(unsigned char* pixels, int w, int h, int stride, int kernel_width)
+{
+#ifdef IMGUI_ENABLE_SSE
+    if (kernel_width < 2 || kernel_width > STBTT_MAX_OVERSAMPLE)
+    {
+        stbtt__h_prefilter(pixels, w, h, stride, kernel_width);
+        return;
+    }
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div_mul = _mm_set1_epi16((short)(0x10000 / kernel_width + 1));
+    for (int y = 0; y < h; y++, pixels += stride)
+    {
+        int x = w;
+        for (; x - 16 >= kernel_width - 1; x -= 16)
+        {
+            __m128i sum_lo = zero, sum_hi = zero;
+            for (int k = 0; k < kernel_width; k++)
+            {
+                const __m128i src = _mm_loadu_si128((const __m128i*)(pixels + x - 16 - k));
+                sum_lo = _mm_add_epi16(sum_lo, _mm_unpacklo_epi8(src, zero));
+                sum_hi = _mm_add_epi16(sum_hi, _mm_unpackhi_epi8(src, zero));
+            }
+            _mm_storeu_si128((__m128i*)(pixels + x - 16), ImGui_ImplStbTrueType_PrefilterDiv(sum_lo, sum_hi, div_mul));
+        }
+        while (x-- > 0)
+        {
+            unsigned int total = 0;
+            for (int k = 0; k < kernel_width && k <= x; k++)
+                total += pixels[x - k];
+            pixels[x] = (unsigned char)(total / kernel_width);
+        }
+    }
+#else
+    stbtt__h_prefilter(pixels, w, h, stride, kernel_width);
+#endif
+}
+
+static void ImGui_ImplStbTrueType_VPrefilter(unsigned char* pixels, int w, int h, int stride, int kernel_width)
+{
+#ifdef IMGUI_ENABLE_SSE
+    if (kernel_width < 2 || kernel_width > STBTT_MAX_OVERSAMPLE)
+    {
+        stbtt__v_prefilter(pixels, w, h, stride, kernel_width);
+        return;
+    }
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i div_mul = _mm_set1_epi16((short)(0x10000 / kernel_width + 1));
+    int x = 0;
+    for (; x + 16 <= w; x += 16)
+        for (int y = h - 1; y >= 0; y--)
+        {
+            __m128i sum_lo = zero, sum_hi = zero;
+            for (int k = 0; k < kernel_width && k <= y; k++)
+            {
+                const __m128i src = _mm_loadu_si128((const __m128i*)(pixels + (y - k) * stride + x));
+                sum_lo = _mm_add_epi16(sum_lo, _mm_unpacklo_epi8(src, zero));
+                sum_hi = _mm_add_epi16(sum_hi, _mm_unpackhi_epi8(src, zero));
+            }
+            _mm_storeu_si128((__m128i*)(pixels + y * stride + x), ImGui_ImplStbTrueType_PrefilterDiv(sum_lo, sum_hi, div_mul));
+        }
+    for (; x < w; x++)
+        for (int y = h - 1; y >= 0; y--)
+        {
+            unsigned int total = 0;
+            for (int k = 0; k < kernel_width && k <= y; k++)
+                total += pixels[(y - k) * stride + x];
+            pixels[y * stride + x] = (unsigned char)(total / kernel_width);
+        }
+#else
+    stbtt__v_prefilter(pixels, w, h, stride, kernel_width);
+#endif
+}
+
+// Rasterize a glyph queued by ImGui_ImplStbTrueType_FontBakedLoadGlyph(). May be called from any thread.
+static void ImGui_ImplStbTrueType_RasterizePendingGlyph(const ImFontAtlasPendingGlyph* pending, unsigned char* out_pixels)
+{
+    ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)pending->FontSrc->FontLoaderData;
+    ImFontAtlasStbTrueTypeAllocator allocator;
+    ImGui::GetAllocatorFunctions(&allocator.AllocFunc, &allocator.FreeFunc, &allocator.UserData);
+    stbtt_fontinfo font_info = bd_font_data->FontInfo;
+    font_info.userdata = &allocator;
+
+    const int w = pending->Width;
+    const int h = pending->Height;
+    memset(out_pixels, 0, w * h * 1);
+    stbtt_MakeGlyphBitmapSubpixel(&font_info, out_pixels, w - pending->OversampleH + 1, h - pending->OversampleV + 1, w,
+        pending->ScaleX, pending->ScaleY, 0, 0, pending->GlyphIndex);
+    if (pending->OversampleH > 1)
+        ImGui_ImplStbTrueType_HPrefilter(out_pixels, w, h, w, pending->OversampleH);
+    if (pending->OversampleV > 1)
+        ImGui_ImplStbTrueType_VPrefilter(out_pixels, w, h, w, pending->OversampleV);
+}
+
+// Rasterize a signed distance field (ImFontAtlasFlags_SDF), including IM_FONTATLAS_SDF_PADDING texels on each side.
+static void ImGui_ImplStbTrueType_RasterizeGlyphSdf(const stbtt_fontinfo* font_info, int glyph_index, float scale, unsigned char* out_pixels, int w, int h)
+{
+    memset(out_pixels, 0, w * h * 1);
+    int sdf_w = 0, sdf_h = 0;
+    unsigned char* sdf_pixels = stbtt_GetGlyphSDF(font_info, scale, glyph_index, IM_FONTATLAS_SDF_PADDING, IM_FONTATLAS_SDF_ONEDGE_VALUE, (float)IM_FONTATLAS_SDF_ONEDGE_VALUE / IM_FONTATLAS_SDF_PADDING, &sdf_w, &sdf_h, NULL, NULL);
+    if (sdf_pixels == NULL)
+        return;
+    IM_ASSERT(sdf_w == w && sdf_h == h);
+    memcpy(out_pixels, sdf_pixels, (size_t)(w * h));
+    stbtt_FreeSDF(sdf_pixels, font_info->userdata);
+}
+
+static void ImGui_ImplStbTrueType_RasterizePendingGlyphSdf(const ImFontAtlasPendingGlyph* pending, unsigned char* out_pixels)
+{
+    ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)pending->FontSrc->FontLoaderData;
+    ImFontAtlasStbTrueTypeAllocator allocator;
+    ImGui::GetAllocatorFunctions(&allocator.AllocFunc, &allocator.FreeFunc, &allocator.UserData);
+    stbtt_fontinfo font_info = bd_font_data->FontInfo;
+    font_info.userdata = &allocator;
+    ImGui_ImplStbTrueType_RasterizeGlyphSdf(&font_info, pending->GlyphIndex, pending->ScaleX, out_pixels, pending->Width, pending->Height);
+}
+
 static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void*, ImWchar codepoint, ImFontGlyph* out_glyph)
 {
     // Search for first font which has the glyph
     ImGui_ImplStbTrueType_FontSrcData* bd_font_data = (ImGui_ImplStbTrueType_FontSrcData*)src->FontLoaderData;
     IM_ASSERT(bd_font_data);
-    int glyph_index = stbtt_FindGlyphIndex(&bd_font_data->FontInfo, (int)codepoint);
+    int glyph_index = ImGui_ImplStbTrueType_FindGlyphIndex(bd_font_data, codepoint);
     if (glyph_index == 0)
         return false;
 
@@ -4627,8 +6776,10 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
     // (generally based on stbtt_PackFontRangesRenderIntoRects)
     if (is_visible)
     {
-        const int w = (x1 - x0 + oversample_h - 1);
-        const int h = (y1 - y0 + oversample_v - 1);
+        const bool is_sdf = (atlas->Flags & ImFontAtlasFlags_SDF) != 0; // Oversampling is disabled, so scale_for_raster_x == scale_for_raster_y
+        const int sdf_padding = is_sdf ? IM_FONTATLAS_SDF_PADDING : 0;
+        const int w = (x1 - x0 + oversample_h - 1) + sdf_padding * 2;
+        const int h = (y1 - y0 + oversample_v - 1) + sdf_padding * 2;
         ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
         if (pack_id == ImFontAtlasRectId_Invalid)
         {
@@ -4640,19 +6791,49 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
 
         // Render
         stbtt_GetGlyphBitmapBox(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, scale_for_raster_y, &x0, &y0, &x1, &y1);
+        x0 -= sdf_padding;
+        y0 -= sdf_padding;
         ImFontAtlasBuilder* builder = atlas->Builder;
-        builder->TempBuffer.resize(w * h * 1);
-        unsigned char* bitmap_pixels = builder->TempBuffer.Data;
-        memset(bitmap_pixels, 0, w * h * 1);
-        stbtt_MakeGlyphBitmapSubpixel(&bd_font_data->FontInfo, bitmap_pixels, r->w - oversample_h + 1, r->h - oversample_v + 1, w,
-            scale_for_raster_x, scale_for_raster_y, 0, 0, glyph_index);
-
-        // Oversampling
-        // (those functions conveniently assert if pixels are not cleared, which is another safety layer)
-        if (oversample_h > 1)
-            stbtt__h_prefilter(bitmap_pixels, r->w, r->h, r->w, oversample_h);
-        if (oversample_v > 1)
-            stbtt__v_prefilter(bitmap_pixels, r->w, r->h, r->w, oversample_v);
+        unsigned char* bitmap_pixels = NULL;
+        if ((atlas->Flags & ImFontAtlasFlags_BatchGlyphRasterization) && atlas->RendererHasTextures)
+        {
+            // Rasterize during next ImFontAtlasUpdateNewFrame(), possibly in parallel with other glyphs
+            ImFontAtlasPendingGlyph pending;
+            pending.RasterizeFunc = is_sdf ? ImGui_ImplStbTrueType_RasterizePendingGlyphSdf : ImGui_ImplStbTrueType_RasterizePendingGlyph;
+            pending.FontSrc = src;
+            pending.BakedId = baked->BakedId;
+            pending.PackId = pack_id;
+            pending.BakedGlyphIndex = -1;
+            pending.Width = r->w;
+            pending.Height = r->h;
+            pending.PixelsOffset = 0;
+            pending.GlyphIndex = glyph_index;
+            pending.ScaleX = scale_for_raster_x;
+            pending.ScaleY = scale_for_raster_y;
+            pending.OversampleH = oversample_h;
+            pending.OversampleV = oversample_v;
+            builder->PendingGlyphs.push_back(pending);
+        }
+        else if (is_sdf)
+        {
+            builder->TempBuffer.resize(w * h * 1);
+            bitmap_pixels = builder->TempBuffer.Data;
+            ImGui_ImplStbTrueType_RasterizeGlyphSdf(&bd_font_data->FontInfo, glyph_index, scale_for_raster_x, bitmap_pixels, w, h);
+        }
+        else
+        {
+            builder->TempBuffer.resize(w * h * 1);
+            bitmap_pixels = builder->TempBuffer.Data;
+            memset(bitmap_pixels, 0, w * h * 1);
+            stbtt_MakeGlyphBitmapSubpixel(&bd_font_data->FontInfo, bitmap_pixels, r->w - oversample_h + 1, r->h - oversample_v + 1, w,
+                scale_for_raster_x, scale_for_raster_y, 0, 0, glyph_index);
+
+            // Oversampling
+            if (oversample_h > 1)
+                ImGui_ImplStbTrueType_HPrefilter(bitmap_pixels, r->w, r->h, r->w, oversample_h);
+            if (oversample_v > 1)
+                ImGui_ImplStbTrueType_VPrefilter(bitmap_pixels, r->w, r->h, r->w, oversample_v);
+        }
 
         const float ref_size = baked->ContainerFont->Sources[0]->SizePixels;
         const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
@@ -4676,7 +6857,8 @@ static bool ImGui_ImplStbTrueType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontC
         out_glyph->Y1 = (y0 + (int)r->h) * recip_v + font_off_y;
         out_glyph->Visible = true;
         out_glyph->PackId = pack_id;
-        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
+        if (bitmap_pixels != NULL)
+            ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, bitmap_pixels, ImTextureFormat_Alpha8, w);
     }
 
     return true;
@@ -4692,6 +6874,7 @@ const ImFontLoader* ImFontAtlasGetFontLoaderForStbTruetype()
     loader.FontBakedInit = ImGui_ImplStbTrueType_FontBakedInit;
     loader.FontBakedDestroy = NULL;
     loader.FontBakedLoadGlyph = ImGui_ImplStbTrueType_FontBakedLoadGlyph;
+    loader.SupportsSdf = true;
     return &loader;
 }
 
@@ -5027,8 +7210,8 @@ void ImFontBaked::ClearOutputData()
 {
     FallbackAdvanceX = 0.0f;
     Glyphs.clear();
-    IndexAdvanceX.clear();
-    IndexLookup.clear();
+    IndexPagesMap.clear();
+    IndexPages.clear();
     FallbackGlyphIndex = -1;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
@@ -5077,19 +7260,26 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
     int glyph_idx = baked->Glyphs.Size;
     baked->Glyphs.push_back(*in_glyph);
     ImFontGlyph* glyph = &baked->Glyphs[glyph_idx];
-    IM_ASSERT(baked->Glyphs.Size < 0xFFFE); // IndexLookup[] hold 16-bit values and -1/-2 are reserved.
+    IM_ASSERT(baked->Glyphs.Size < 0xFFFE); // ImFontBakedIndexPage::Lookup[] hold 16-bit values and -1/-2 are reserved.
 
     // Set UV from packed rectangle
     if (glyph->PackId != ImFontAtlasRectId_Invalid)
     {
         ImTextureRect* r = ImFontAtlasPackGetRect(atlas, glyph->PackId);
         IM_ASSERT(glyph->U0 == 0.0f && glyph->V0 == 0.0f && glyph->U1 == 0.0f && glyph->V1 == 0.0f);
+        glyph->PageIdx = atlas->Builder->RectsPage[atlas->Builder->Rects.index_from_ptr(r)];
         glyph->U0 = (r->x) * atlas->TexUvScale.x;
         glyph->V0 = (r->y) * atlas->TexUvScale.y;
         glyph->U1 = (r->x + r->w) * atlas->TexUvScale.x;
         glyph->V1 = (r->y + r->h) * atlas->TexUvScale.y;
         baked->MetricsTotalSurface += r->w * r->h;
+
+        // Glyph just queued by the loader for batched rasterization (ImFontAtlasFlags_BatchGlyphRasterization)
+        ImVector<ImFontAtlasPendingGlyph>& pending_glyphs = atlas->Builder->PendingGlyphs;
+        if (pending_glyphs.Size > 0 && pending_glyphs.back().PackId == glyph->PackId)
+            pending_glyphs.back().BakedGlyphIndex = glyph_idx;
     }
+    glyph->LastUsedFrame = atlas->Builder->FrameCount;
 
     if (src != NULL)
     {
@@ -5112,13 +7302,13 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
         glyph->AdvanceX = advance_x + src->GlyphExtraAdvanceX;
     }
     if (glyph->Colored)
-        atlas->TexPixelsUseColors = atlas->TexData->UseColors = true;
+        atlas->TexPixelsUseColors = atlas->Builder->Pages[glyph->PageIdx].Tex->UseColors = true;
 
     // Update lookup tables
     const int codepoint = glyph->Codepoint;
-    ImFontBaked_BuildGrowIndex(baked, codepoint + 1);
-    baked->IndexAdvanceX[codepoint] = glyph->AdvanceX;
-    baked->IndexLookup[codepoint] = (ImU16)glyph_idx;
+    ImFontBakedIndexPage* index_page = ImFontBaked_BuildGetIndexPage(baked, codepoint);
+    index_page->AdvanceX[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = glyph->AdvanceX;
+    index_page->Lookup[codepoint & IM_FONTBAKED_INDEX_PAGE_MASK] = (ImU16)glyph_idx;
     const int page_n = codepoint / 8192;
     baked->ContainerFont->Used8kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
 
@@ -5128,7 +7318,7 @@ ImFontGlyph* ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked
 // Copy to texture, post-process and queue update for backend
 void ImFontAtlasBakedSetFontGlyphBitmap(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImFontGlyph* glyph, ImTextureRect* r, const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch)
 {
-    ImTextureData* tex = atlas->TexData;
+    ImTextureData* tex = ImFontAtlasPackGetRectTexture(atlas, glyph->PackId);
     IM_ASSERT(r->x + r->w <= tex->Width && r->y + r->h <= tex->Height);
     ImFontAtlasTextureBlockConvert(src_pixels, src_fmt, src_pitch, (unsigned char*)tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h);
     ImFontAtlasPostProcessData pp_data = { atlas, baked->ContainerFont, src, baked, glyph, tex->GetPixelsAt(r->x, r->y), tex->Format, tex->GetPitch(), r->w, r->h };
@@ -5136,6 +7326,65 @@ void ImFontAtlasBakedSetFontGlyphBitmap(ImFontAtlas* atlas, ImFontBaked* baked,
     ImFontAtlasTextureBlockQueueUpload(atlas, tex, r->x, r->y, r->w, r->h);
 }
 
+static void ImFontAtlasBuildRasterizePendingGlyphTask(void* task_data, int task_idx)
+{
+    ImFontAtlasBuilder* builder = (ImFontAtlasBuilder*)task_data;
+    const ImFontAtlasPendingGlyph* pending = &builder->PendingGlyphs.Data[task_idx];
+    pending->RasterizeFunc(pending, builder->PendingGlyphsPixels.Data + pending->PixelsOffset);
+}
+
+// Rasterize glyphs batched by ImFontAtlasFlags_BatchGlyphRasterization, one task per glyph (see ImGui::ParallelFor()).
+// Then copy them into the texture and queue uploads serially.
+// This is a fork/join: it returns once every glyph is done, nothing keeps running in the background.
+void ImFontAtlasBuildRasterizePendingGlyphs(ImFontAtlas* atlas)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if (builder == NULL || builder->PendingGlyphs.Size == 0)
+        return;
+
+    int pixels_size = 0;
+    for (ImFontAtlasPendingGlyph& pending : builder->PendingGlyphs)
+    {
+        pending.PixelsOffset = pixels_size;
+        pixels_size += pending.Width * pending.Height;
+    }
+    builder->PendingGlyphsPixels.resize(pixels_size);
+    ImGui::ParallelFor(ImFontAtlasBuildRasterizePendingGlyphTask, builder, builder->PendingGlyphs.Size);
+
+    for (const ImFontAtlasPendingGlyph& pending : builder->PendingGlyphs)
+    {
+        // Skip glyphs discarded since they were loaded. Recently loaded glyphs are at the end of the list.
+        ImFontBaked* baked = (ImFontBaked*)builder->BakedMap.GetVoidPtr(pending.BakedId);
+        ImTextureRect* r = ImFontAtlasPackGetRectSafe(atlas, pending.PackId);
+        if (baked == NULL || r == NULL)
+            continue;
+        ImFontGlyph* glyph = NULL;
+        if (pending.BakedGlyphIndex >= 0 && pending.BakedGlyphIndex < baked->Glyphs.Size && baked->Glyphs.Data[pending.BakedGlyphIndex].PackId == pending.PackId)
+            glyph = &baked->Glyphs.Data[pending.BakedGlyphIndex];
+        else
+            for (int glyph_n = baked->Glyphs.Size - 1; glyph_n >= 0 && glyph == NULL; glyph_n--) // Moved by ImFontAtlasBakedCompactGlyphs()
+                if (baked->Glyphs.Data[glyph_n].PackId == pending.PackId)
+                    glyph = &baked->Glyphs.Data[glyph_n];
+        if (glyph == NULL)
+            continue;
+        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, pending.FontSrc, glyph, r, builder->PendingGlyphsPixels.Data + pending.PixelsOffset, ImTextureFormat_Alpha8, pending.Width);
+    }
+    builder->PendingGlyphs.resize(0);
+    builder->PendingGlyphsPixels.clear();
+}
+
+void ImFontAtlasBuildDiscardPendingGlyphs(ImFontAtlas* atlas, ImFontConfig* src)
+{
+    ImFontAtlasBuilder* builder = atlas->Builder;
+    if (builder == NULL)
+        return;
+    int dst_n = 0;
+    for (int src_n = 0; src_n < builder->PendingGlyphs.Size; src_n++)
+        if (src != NULL && builder->PendingGlyphs.Data[src_n].FontSrc != src)
+            builder->PendingGlyphs.Data[dst_n++] = builder->PendingGlyphs.Data[src_n];
+    builder->PendingGlyphs.resize(dst_n);
+}
+
 void ImFont::AddRemapChar(ImWchar from_codepoint, ImWchar to_codepoint)
 {
     RemapPairs.SetInt((ImGuiID)from_codepoint, (int)to_codepoint);
@@ -5144,13 +7393,17 @@ void ImFont::AddRemapChar(ImWchar from_codepoint, ImWchar to_codepoint)
 // Find glyph, load if necessary, return fallback if missing
 ImFontGlyph* ImFontBaked::FindGlyph(ImWchar c)
 {
-    if (c < (size_t)IndexLookup.Size) IM_LIKELY
+    IM_FONTATLAS_SCOPED_LOCK(ContainerFont->ContainerAtlas);
+    if ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)IndexPagesMap.Size) IM_LIKELY
     {
-        const int i = (int)IndexLookup.Data[c];
+        const int i = (int)IndexPages.Data[IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK];
         if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
             return &Glyphs.Data[FallbackGlyphIndex];
         if (i != IM_FONTGLYPH_INDEX_UNUSED)
+        {
+            Glyphs.Data[i].LastUsedFrame = LastUsedFrame;
             return &Glyphs.Data[i];
+        }
     }
     ImFontGlyph* glyph = ImFontBaked_BuildLoadGlyph(this, c);
     return glyph ? glyph : &Glyphs.Data[FallbackGlyphIndex];
@@ -5159,9 +7412,10 @@ ImFontGlyph* ImFontBaked::FindGlyph(ImWchar c)
 // Attempt to load but when missing, return NULL instead of FallbackGlyph
 ImFontGlyph* ImFontBaked::FindGlyphNoFallback(ImWchar c)
 {
-    if (c < (size_t)IndexLookup.Size) IM_LIKELY
+    IM_FONTATLAS_SCOPED_LOCK(ContainerFont->ContainerAtlas);
+    if ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)IndexPagesMap.Size) IM_LIKELY
     {
-        const int i = (int)IndexLookup.Data[c];
+        const int i = (int)IndexPages.Data[IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK];
         if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
             return NULL;
         if (i != IM_FONTGLYPH_INDEX_UNUSED)
@@ -5175,9 +7429,10 @@ ImFontGlyph* ImFontBaked::FindGlyphNoFallback(ImWchar c)
 
 bool ImFontBaked::IsGlyphLoaded(ImWchar c)
 {
-    if (c < (size_t)IndexLookup.Size) IM_LIKELY
+    IM_FONTATLAS_SCOPED_LOCK(ContainerFont->ContainerAtlas);
+    if ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)IndexPagesMap.Size) IM_LIKELY
     {
-        const int i = (int)IndexLookup.Data[c];
+        const int i = (int)IndexPages.Data[IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK];
         if (i == IM_FONTGLYPH_INDEX_NOT_FOUND)
             return false;
         if (i != IM_FONTGLYPH_INDEX_UNUSED)
@@ -5186,10 +7441,108 @@ bool ImFontBaked::IsGlyphLoaded(ImWchar c)
     return false;
 }
 
+// Return true if glyph has been loaded or found to be missing
+static inline bool ImFontBaked_BuildIsGlyphSearched(ImFontBaked* baked, ImWchar c)
+{
+    if ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) >= (unsigned int)baked->IndexPagesMap.Size)
+        return false;
+    return baked->IndexPages.Data[baked->IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].Lookup[c & IM_FONTBAKED_INDEX_PAGE_MASK] != IM_FONTGLYPH_INDEX_UNUSED;
+}
+
+// Load all glyphs of 'glyph_ranges' which haven't been searched for yet. Equivalent to calling FindGlyph() for each codepoint, but
+// font loaders implementing FontBakedPrerenderGlyphs() are first given the codepoints each of their sources will provide,
+// so they can render them together (e.g. in parallel). Glyphs are then registered in order, exactly like FindGlyph() would.
+// Codepoints are processed in batches of IM_FONTBAKED_PRERENDER_BATCH_SIZE, which bounds the pixels held by loaders.
+void ImFontBaked::LoadGlyphs(const ImWchar* glyph_ranges)
+{
+    ImFont* font = ContainerFont;
+    ImFontAtlas* atlas = font->ContainerAtlas;
+    IM_FONTATLAS_SCOPED_LOCK(atlas);
+    if (atlas->Locked || (font->Flags & ImFontFlags_NoLoadGlyphs))
+        return;
+
+    ImVector<ImWchar> codepoints;
+    for (; glyph_ranges[0]; glyph_ranges += 2)
+        for (unsigned int c = glyph_ranges[0]; c <= glyph_ranges[1] && c <= IM_UNICODE_CODEPOINT_MAX; c++) //-V560
+            if (!ImFontBaked_BuildIsGlyphSearched(this, (ImWchar)c))
+                codepoints.push_back((ImWchar)c);
+
+    bool any_prerender = false;
+    for (ImFontConfig* src : font->Sources)
+        any_prerender |= ((src->FontLoader ? src->FontLoader : atlas->FontLoader)->FontBakedPrerenderGlyphs != NULL);
+    if (!any_prerender)
+    {
+        for (ImWchar c : codepoints)
+            if (!ImFontBaked_BuildIsGlyphSearched(this, c)) // Ranges may overlap
+                ImFontBaked_BuildLoadGlyph(this, c);
+        return;
+    }
+
+    ImVector<int> codepoints_src_n;
+    ImVector<ImWchar> src_codepoints;
+    for (int batch_begin = 0; batch_begin < codepoints.Size; batch_begin += IM_FONTBAKED_PRERENDER_BATCH_SIZE)
+    {
+        const int batch_end = ImMin(batch_begin + IM_FONTBAKED_PRERENDER_BATCH_SIZE, codepoints.Size);
+
+        // Give each source supporting it the (remapped) codepoints it will be the first source to contain
+        codepoints_src_n.resize(batch_end - batch_begin);
+        for (int codepoint_n = batch_begin; codepoint_n < batch_end; codepoint_n++)
+        {
+            ImWchar c = codepoints[codepoint_n];
+            ImFontAtlas_FontHookRemapCodepoint(atlas, font, &c);
+            int* p_src_n = &codepoints_src_n[codepoint_n - batch_begin];
+            *p_src_n = -1;
+            for (int src_n = 0; src_n < font->Sources.Size && *p_src_n == -1; src_n++)
+            {
+                ImFontConfig* src = font->Sources[src_n];
+                const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+                if ((!src->GlyphExcludeRanges || ImFontAtlasBuildAcceptCodepointForSource(src, c)) && loader->FontSrcContainsGlyph != NULL && loader->FontSrcContainsGlyph(atlas, src, c))
+                    *p_src_n = src_n;
+            }
+        }
+
+        char* loader_user_data_p = (char*)FontLoaderDatas;
+        for (int src_n = 0; src_n < font->Sources.Size; src_n++)
+        {
+            ImFontConfig* src = font->Sources[src_n];
+            const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+            if (loader->FontBakedPrerenderGlyphs != NULL)
+            {
+                src_codepoints.resize(0);
+                for (int codepoint_n = batch_begin; codepoint_n < batch_end; codepoint_n++)
+                    if (codepoints_src_n[codepoint_n - batch_begin] == src_n)
+                    {
+                        ImWchar c = codepoints[codepoint_n];
+                        ImFontAtlas_FontHookRemapCodepoint(atlas, font, &c);
+                        src_codepoints.push_back(c);
+                    }
+                if (src_codepoints.Size > 0)
+                    loader->FontBakedPrerenderGlyphs(atlas, src, this, loader_user_data_p, src_codepoints.Data, src_codepoints.Size);
+            }
+            loader_user_data_p += loader->FontBakedSrcLoaderDataSize;
+        }
+
+        for (int codepoint_n = batch_begin; codepoint_n < batch_end; codepoint_n++)
+            if (!ImFontBaked_BuildIsGlyphSearched(this, codepoints[codepoint_n])) // Ranges may overlap
+                ImFontBaked_BuildLoadGlyph(this, codepoints[codepoint_n]);
+
+        // Release glyphs which were rendered ahead but not requested (e.g. loaded from ImFontAtlas::GlyphCache instead), and pixels held by loaders
+        loader_user_data_p = (char*)FontLoaderDatas;
+        for (ImFontConfig* src : font->Sources)
+        {
+            const ImFontLoader* loader = src->FontLoader ? src->FontLoader : atlas->FontLoader;
+            if (loader->FontBakedPrerenderGlyphs != NULL)
+                loader->FontBakedPrerenderGlyphs(atlas, src, this, loader_user_data_p, NULL, 0);
+            loader_user_data_p += loader->FontBakedSrcLoaderDataSize;
+        }
+    }
+}
+
 // This is not fast query
 bool ImFont::IsGlyphInFont(ImWchar c)
 {
     ImFontAtlas* atlas = ContainerAtlas;
+    IM_FONTATLAS_SCOPED_LOCK(atlas); // Loaders may update their lookup tables
     ImFontAtlas_FontHookRemapCodepoint(atlas, this, &c);
     for (ImFontConfig* src : Sources)
     {
@@ -5204,10 +7557,11 @@ bool ImFont::IsGlyphInFont(ImWchar c)
 IM_MSVC_RUNTIME_CHECKS_OFF
 float ImFontBaked::GetCharAdvance(ImWchar c)
 {
-    if ((int)c < IndexAdvanceX.Size)
+    IM_FONTATLAS_SCOPED_LOCK(ContainerFont->ContainerAtlas);
+    if ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)IndexPagesMap.Size)
     {
         // Missing glyphs fitting inside index will have stored FallbackAdvanceX already.
-        const float x = IndexAdvanceX.Data[c];
+        const float x = IndexPages.Data[IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK];
         if (x >= 0.0f)
             return x;
     }
@@ -5227,14 +7581,23 @@ ImGuiID ImFontAtlasBakedGetId(ImGuiID font_id, float baked_size, float rasterize
     return ImHashData(&hashed_data, sizeof(hashed_data));
 }
 
+// Signed distance fields (ImFontAtlasFlags_SDF) are scaled from the next power of two size.
+static inline float ImFontAtlasBuildGetSdfBakedSize(float size)
+{
+    return (float)ImUpperPowerOfTwo(ImMax((int)ImCeil(size), IM_FONTATLAS_SDF_BAKED_SIZE_MIN));
+}
+
 // ImFontBaked pointers are valid for the entire frame but shall never be kept between frames.
 ImFontBaked* ImFont::GetFontBaked(float size, float density)
 {
+    IM_FONTATLAS_SCOPED_LOCK(ContainerAtlas);
     ImFontBaked* baked = LastBaked;
 
     // Round font size
     // - ImGui::PushFont() will already round, but other paths calling GetFontBaked() directly also needs it (e.g. ImFontAtlasBuildPreloadAllGlyphRanges)
     size = ImGui::GetRoundedFontSize(size);
+    if (ContainerAtlas->Flags & ImFontAtlasFlags_SDF)
+        size = ImFontAtlasBuildGetSdfBakedSize(size);
 
     if (density < 0.0f)
         density = CurrentRasterizerDensity;
@@ -5301,6 +7664,8 @@ static inline const char* CalcWordWrapNextLineStartA(const char* text, const cha
 // FIXME: Much possible improvements (don't cut things like "word !", "word!!!" but cut within "word,,,,", more sensible support for punctuations, support for Unicode punctuations, etc.)
 const char* ImFont::CalcWordWrapPosition(float size, const char* text, const char* text_end, float wrap_width)
 {
+    IM_FONTATLAS_SCOPED_LOCK(ContainerAtlas);
+
     // For references, possible wrap point marked with ^
     //  "aaa bbb, ccc,ddd. eee   fff. ggg!"
     //      ^    ^    ^   ^   ^__    ^    ^
@@ -5353,7 +7718,7 @@ const char* ImFont::CalcWordWrapPosition(float size, const char* text, const cha
         }
 
         // Optimized inline version of 'float char_width = GetCharAdvance((ImWchar)c);'
-        float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+        float char_width = ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)baked->IndexPagesMap.Size) ? baked->IndexPages.Data[baked->IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] : -1.0f;
         if (char_width < 0.0f)
             char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
 
@@ -5405,11 +7770,54 @@ const char* ImFont::CalcWordWrapPosition(float size, const char* text, const cha
     return s;
 }
 
+// Output begin/end offsets (two entries per line) of each visual line of word-wrapped text.
+// This follows the same logic as the word-wrapping loops of CalcTextSizeA() and RenderText(), so that rendering each line
+// individually with wrapping disabled outputs the same glyphs as rendering the whole text with wrapping enabled.
+void ImFontCalcWordWrapLines(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImVector<int>* out_line_offsets)
+{
+    IM_ASSERT(text_end != NULL && wrap_width > 0.0f);
+    out_line_offsets->resize(0);
+    const char* line_begin = text;
+    const char* word_wrap_eol = NULL;
+    const char* s = text;
+    while (s < text_end)
+    {
+        if (!word_wrap_eol)
+            word_wrap_eol = font->CalcWordWrapPosition(size, s, text_end, wrap_width);
+        if (s >= word_wrap_eol)
+        {
+            out_line_offsets->push_back((int)(line_begin - text));
+            out_line_offsets->push_back((int)(s - text));
+            word_wrap_eol = NULL;
+            s = CalcWordWrapNextLineStartA(s, text_end); // Wrapping skips upcoming blanks
+            line_begin = s;
+            continue;
+        }
+
+        // Decode and advance source (we need to advance the same way as the rendering loop, as word_wrap_eol may not be a character start point)
+        const char* prev_s = s;
+        unsigned int c = (unsigned int)*s;
+        if (c < 0x80)
+            s += 1;
+        else
+            s += ImTextCharFromUtf8(&c, s, text_end);
+        if (c == '\n')
+        {
+            out_line_offsets->push_back((int)(line_begin - text));
+            out_line_offsets->push_back((int)(prev_s - text));
+            line_begin = s;
+        }
+    }
+    out_line_offsets->push_back((int)(line_begin - text));
+    out_line_offsets->push_back((int)(s - text));
+}
+
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining)
 {
     if (!text_end)
         text_end = text_begin + ImStrlen(text_begin); // FIXME-OPT: Need to avoid this.
 
+    IM_FONTATLAS_SCOPED_LOCK(ContainerAtlas);
     const float line_height = size;
     ImFontBaked* baked = GetFontBaked(size);
     const float scale = size / baked->Size;
@@ -5441,6 +7849,27 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path for runs of printable ASCII characters: find the end of the run with SIMD, then accumulate advances without decoding.
+        // Widths are summed in the same order as the generic path below, so results are identical.
+        if ((unsigned char)*s >= 32 && (unsigned char)*s < 0x80)
+        {
+            const char* run_end = ImTextFindNonAscii(s, (word_wrap_enabled && word_wrap_eol < text_end) ? word_wrap_eol : text_end, 32);
+            for (; s < run_end; s++)
+            {
+                unsigned int c = (unsigned char)*s;
+                float char_width = ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)baked->IndexPagesMap.Size) ? baked->IndexPages.Data[baked->IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] : -1.0f;
+                if (char_width < 0.0f)
+                    char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
+                char_width *= scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -5463,7 +7892,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
         }
 
         // Optimized inline version of 'float char_width = GetCharAdvance((ImWchar)c);'
-        float char_width = (c < (unsigned int)baked->IndexAdvanceX.Size) ? baked->IndexAdvanceX.Data[c] : -1.0f;
+        float char_width = ((c >> IM_FONTBAKED_INDEX_PAGE_SHIFT) < (unsigned int)baked->IndexPagesMap.Size) ? baked->IndexPages.Data[baked->IndexPagesMap.Data[c >> IM_FONTBAKED_INDEX_PAGE_SHIFT]].AdvanceX[c & IM_FONTBAKED_INDEX_PAGE_MASK] : -1.0f;
         if (char_width < 0.0f)
             char_width = BuildLoadGlyphGetAdvanceOrFallback(baked, c);
         char_width *= scale;
@@ -5489,9 +7918,36 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
     return text_size;
 }
 
+// Switch texture in the middle of a PrimReserve() block, for glyphs stored in another page (ImFontAtlasFlags_MultiPage).
+// Indices already written stay in current command, remaining reserved indices are moved to a command using the new texture.
+// We don't try to merge with previous command so the number of commands only grows (see edge case in RenderText()).
+static void ImFontRenderTextSetTexture(ImDrawList* draw_list, ImTextureRef tex_ref, ImDrawIdx* idx_write, int idx_expected_size)
+{
+    draw_list->_CmdHeader.TexRef = tex_ref;
+    ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+    if (curr_cmd->TexRef == tex_ref)
+        return;
+    const int idx_written_size = (int)(idx_write - draw_list->IdxBuffer.Data);
+    const int idx_unused_count = idx_expected_size - idx_written_size;
+    curr_cmd->ElemCount -= idx_unused_count;
+    if (curr_cmd->ElemCount == 0)
+    {
+        curr_cmd->TexRef = tex_ref;
+    }
+    else
+    {
+        draw_list->IdxBuffer.Size = idx_written_size; // AddDrawCmd() starts new command at IdxBuffer.Size
+        draw_list->AddDrawCmd();
+        draw_list->IdxBuffer.Size = idx_expected_size;
+    }
+    draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1].ElemCount += idx_unused_count;
+}
+
 // Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
 void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, ImWchar c, const ImVec4* cpu_fine_clip)
 {
+    IM_FONTATLAS_SCOPED_LOCK(ContainerAtlas);
+    ImFontAtlasSyncDrawListSharedData(ContainerAtlas, draw_list->_Data);
     ImFontBaked* baked = GetFontBaked(size);
     const ImFontGlyph* glyph = baked->FindGlyph(c);
     if (!glyph || !glyph->Visible)
@@ -5524,33 +7980,50 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, const ImVec2& pos, Im
         if (y1 >= y2)
             return;
     }
+    if (ContainerAtlas->Builder->Pages.Size > 1) // ImFontAtlasFlags_MultiPage
+    {
+        ImTextureRef tex_ref = ContainerAtlas->Builder->Pages[glyph->PageIdx].Tex->GetTexRef();
+        if (draw_list->_CmdHeader.TexRef != tex_ref)
+        {
+            draw_list->_CmdHeader.TexRef = tex_ref;
+            draw_list->_OnChangedTexture();
+        }
+    }
     draw_list->PrimReserve(6, 4);
     draw_list->PrimRectUV(ImVec2(x1, y1), ImVec2(x2, y2), ImVec2(u1, v1), ImVec2(u2, v2), col);
 }
 
-// Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
-void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
+// Shared by ImFont::RenderText() and ImFontRenderTextMeasured(), instantiated for each so the measuring code is compiled out of RenderText().
+// With MEASURE, also measure text the same way as CalcTextSizeA() without word-wrapping, stopping before the first character which
+// would make a line reach 'max_width'. Measuring needs to visit the whole text, so lines outside of vertical clipping range are skipped later.
+template<bool MEASURE>
+static void ImFontRenderTextT(ImFont* font, ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip, float max_width, ImVec2* out_size, const char** out_remaining)
 {
+    IM_FONTATLAS_SCOPED_LOCK(font->ContainerAtlas);
+    ImFontAtlasSyncDrawListSharedData(font->ContainerAtlas, draw_list->_Data);
+
     // Align to be pixel perfect
 begin:
     float x = IM_TRUNC(pos.x);
     float y = IM_TRUNC(pos.y);
-    if (y > clip_rect.w)
+    if (y > clip_rect.w && !MEASURE)
         return;
 
     if (!text_end)
         text_end = text_begin + ImStrlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
 
     const float line_height = size;
-    ImFontBaked* baked = GetFontBaked(size);
+    ImFontBaked* baked = font->GetFontBaked(size);
 
     const float scale = size / baked->Size;
     const float origin_x = x;
     const bool word_wrap_enabled = (wrap_width > 0.0f);
+    ImVec2 text_size = ImVec2(0, 0);
+    float line_width = 0.0f;
 
     // Fast-forward to first visible line
     const char* s = text_begin;
-    if (y + line_height < clip_rect.y)
+    if (y + line_height < clip_rect.y && !MEASURE)
         while (y + line_height < clip_rect.y && s < text_end)
         {
             const char* line_end = (const char*)ImMemchr(s, '\n', text_end - s);
@@ -5559,7 +8032,7 @@ begin:
                 // FIXME-OPT: This is not optimal as do first do a search for \n before calling CalcWordWrapPosition().
                 // If the specs for CalcWordWrapPosition() were reworked to optionally return on \n we could combine both.
                 // However it is still better than nothing performing the fast-forward!
-                s = CalcWordWrapPosition(size, s, line_end ? line_end : text_end, wrap_width);
+                s = font->CalcWordWrapPosition(size, s, line_end ? line_end : text_end, wrap_width);
                 s = CalcWordWrapNextLineStartA(s, text_end);
             }
             else
@@ -5571,7 +8044,7 @@ begin:
 
     // For large text, scan for the last visible line in order to avoid over-reserving in the call to PrimReserve()
     // Note that very large horizontal line will still be affected by the issue (e.g. a one megabyte string buffer without a newline will likely crash atm)
-    if (text_end - s > 10000 && !word_wrap_enabled)
+    if (text_end - s > 10000 && !word_wrap_enabled && !MEASURE)
     {
         const char* s_end = s;
         float y_end = y;
@@ -5583,7 +8056,7 @@ begin:
         }
         text_end = s_end;
     }
-    if (s == text_end)
+    if (s == text_end && !MEASURE)
         return;
 
     // Reserve vertices for remaining worse case (over-reserving is useful and easily amortized)
@@ -5594,7 +8067,11 @@ begin:
     ImDrawVert*  vtx_write = draw_list->_VtxWritePtr;
     ImDrawIdx*   idx_write = draw_list->_IdxWritePtr;
     unsigned int vtx_index = draw_list->_VtxCurrentIdx;
-    const int cmd_count = draw_list->CmdBuffer.Size;
+    const ImVec2 vtx_origin = draw_list->VtxOrigin;
+    const int cmd_count_reserved = draw_list->CmdBuffer.Size;
+    const unsigned int cmd_elem_count_reserved = draw_list->CmdBuffer.Data[cmd_count_reserved - 1].ElemCount;
+    int cmd_count = cmd_count_reserved;
+    int page_idx = (font->ContainerAtlas->Builder->Pages.Size > 1) ? -1 : 0; // With ImFontAtlasFlags_MultiPage, glyphs may be stored in multiple textures
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
     const char* word_wrap_eol = NULL;
@@ -5605,7 +8082,7 @@ begin:
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
             if (!word_wrap_eol)
-                word_wrap_eol = CalcWordWrapPosition(size, s, text_end, wrap_width - (x - origin_x));
+                word_wrap_eol = font->CalcWordWrapPosition(size, s, text_end, wrap_width - (x - origin_x));
 
             if (s >= word_wrap_eol)
             {
@@ -5620,6 +8097,7 @@ begin:
         }
 
         // Decode and advance source
+        const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
             s += 1;
@@ -5630,9 +8108,15 @@ begin:
         {
             if (c == '\n')
             {
+                if (MEASURE)
+                {
+                    text_size.x = ImMax(text_size.x, line_width);
+                    text_size.y += line_height;
+                    line_width = 0.0f;
+                }
                 x = origin_x;
                 y += line_height;
-                if (y > clip_rect.w)
+                if (y > clip_rect.w && !MEASURE)
                     break; // break out of main loop
                 continue;
             }
@@ -5645,9 +8129,20 @@ begin:
         //    continue;
 
         float char_width = glyph->AdvanceX * scale;
-        if (glyph->Visible)
+        if (MEASURE)
+        {
+            if (line_width + char_width >= max_width)
+            {
+                s = prev_s;
+                break;
+            }
+            line_width += char_width;
+        }
+
+        // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
+        // (when measuring, lines outside of vertical clipping range are skipped here instead)
+        if (glyph->Visible && y + line_height >= clip_rect.y && y <= clip_rect.w)
         {
-            // We don't do a second finer clipping test on the Y axis as we've already skipped anything before clip_rect.y and exit once we pass clip_rect.w
             float x1 = x + glyph->X0 * scale;
             float x2 = x + glyph->X1 * scale;
             float y1 = y + glyph->Y0 * scale;
@@ -5690,15 +8185,23 @@ begin:
                     }
                 }
 
+                // Switch texture if glyph is stored in another page (ImFontAtlasFlags_MultiPage). Leave texture changes made by glyph loading to the edge case below.
+                if (glyph->PageIdx != page_idx && cmd_count == draw_list->CmdBuffer.Size)
+                {
+                    page_idx = glyph->PageIdx;
+                    ImFontRenderTextSetTexture(draw_list, font->ContainerAtlas->Builder->Pages[page_idx].Tex->GetTexRef(), idx_write, idx_expected_size);
+                    cmd_count = draw_list->CmdBuffer.Size;
+                }
+
                 // Support for untinted glyphs
                 ImU32 glyph_col = glyph->Colored ? col_untinted : col;
 
                 // We are NOT calling PrimRectUV() here because non-inlined causes too much overhead in a debug builds. Inlined here:
                 {
-                    vtx_write[0].pos.x = x1; vtx_write[0].pos.y = y1; vtx_write[0].col = glyph_col; vtx_write[0].uv.x = u1; vtx_write[0].uv.y = v1;
-                    vtx_write[1].pos.x = x2; vtx_write[1].pos.y = y1; vtx_write[1].col = glyph_col; vtx_write[1].uv.x = u2; vtx_write[1].uv.y = v1;
-                    vtx_write[2].pos.x = x2; vtx_write[2].pos.y = y2; vtx_write[2].col = glyph_col; vtx_write[2].uv.x = u2; vtx_write[2].uv.y = v2;
-                    vtx_write[3].pos.x = x1; vtx_write[3].pos.y = y2; vtx_write[3].col = glyph_col; vtx_write[3].uv.x = u1; vtx_write[3].uv.y = v2;
+                    IM_DRAWVERT_WRITE(&vtx_write[0], x1, y1, ImVec2(u1, v1), glyph_col, vtx_origin);
+                    IM_DRAWVERT_WRITE(&vtx_write[1], x2, y1, ImVec2(u2, v1), glyph_col, vtx_origin);
+                    IM_DRAWVERT_WRITE(&vtx_write[2], x2, y2, ImVec2(u2, v2), glyph_col, vtx_origin);
+                    IM_DRAWVERT_WRITE(&vtx_write[3], x1, y2, ImVec2(u1, v2), glyph_col, vtx_origin);
                     idx_write[0] = (ImDrawIdx)(vtx_index); idx_write[1] = (ImDrawIdx)(vtx_index + 1); idx_write[2] = (ImDrawIdx)(vtx_index + 2);
                     idx_write[3] = (ImDrawIdx)(vtx_index); idx_write[4] = (ImDrawIdx)(vtx_index + 2); idx_write[5] = (ImDrawIdx)(vtx_index + 3);
                     vtx_write += 4;
@@ -5714,14 +8217,13 @@ begin:
     if (cmd_count != draw_list->CmdBuffer.Size) //-V547
     {
         IM_ASSERT(draw_list->CmdBuffer[draw_list->CmdBuffer.Size - 1].ElemCount == 0);
-        draw_list->CmdBuffer.pop_back();
+        draw_list->CmdBuffer.resize(cmd_count_reserved); // Also drop commands added by ImFontRenderTextSetTexture()
+        draw_list->CmdBuffer[cmd_count_reserved - 1].ElemCount = cmd_elem_count_reserved;
         draw_list->PrimUnreserve(idx_count_max, vtx_count_max);
         draw_list->AddDrawCmd();
         //IMGUI_DEBUG_LOG("RenderText: cancel and retry to missing glyphs.\n"); // [DEBUG]
         //draw_list->AddRectFilled(pos, pos + ImVec2(10, 10), IM_COL32(255, 0, 0, 255)); // [DEBUG]
         goto begin;
-        //RenderText(draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip); // FIXME-OPT: Would a 'goto begin' be better for code-gen?
-        //return;
     }
 
     // Give back unused vertices (clipped ones, blanks) ~ this is essentially a PrimUnreserve() action.
@@ -5731,6 +8233,37 @@ begin:
     draw_list->_VtxWritePtr = vtx_write;
     draw_list->_IdxWritePtr = idx_write;
     draw_list->_VtxCurrentIdx = vtx_index;
+
+    if (MEASURE)
+    {
+        if (text_size.x < line_width)
+            text_size.x = line_width;
+        if (line_width > 0 || text_size.y == 0.0f)
+            text_size.y += line_height;
+        *out_size = text_size;
+        if (out_remaining)
+            *out_remaining = s;
+    }
+}
+
+// Note: as with every ImDrawList drawing function, this expects that the font atlas texture is bound.
+void ImFont::RenderText(ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip)
+{
+    ImFontRenderTextT<false>(this, draw_list, size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip, FLT_MAX, NULL, NULL);
+}
+
+// Render text while measuring it, stopping before the first character which would make a line reach 'max_width' (same rule as CalcTextSizeA()).
+// Return the same value as CalcTextSizeA(size, max_width, 0.0f, text_begin, text_end, out_remaining) and render the same vertices as
+// RenderText(draw_list, size, pos, col, clip_rect, text_begin, *out_remaining, 0.0f, cpu_fine_clip), but only decode the text once.
+// Used by RenderTextEllipsis(), which would otherwise need to measure the text once to find where to cut it, then decode it again to render it.
+ImVec2 ImFontRenderTextMeasured(ImFont* font, ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float max_width, bool cpu_fine_clip, const char** out_remaining)
+{
+    IM_ASSERT(text_end != NULL);
+    if ((col & IM_COL32_A_MASK) == 0 || text_begin == text_end || text_begin[0] == 0)
+        return font->CalcTextSizeA(size, max_width, 0.0f, text_begin, text_end, out_remaining);
+    ImVec2 text_size;
+    ImFontRenderTextT<true>(font, draw_list, size, pos, col, clip_rect, text_begin, text_end, 0.0f, cpu_fine_clip, max_width, &text_size, out_remaining);
+    return text_size;
 }
 
 //-----------------------------------------------------------------------------
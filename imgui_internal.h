@@ -144,6 +144,8 @@ struct ImDrawListSharedData;        // Data shared between all ImDrawList instan
 struct ImFontAtlasBuilder;          // Internal storage for incrementally packing and building a ImFontAtlas
 struct ImFontAtlasPostProcessData;  // Data available to potential texture post-processing functions
 struct ImFontAtlasRectEntry;        // Packed rectangle lookup entry
+struct ImFontAtlasPendingGlyph;     // Glyph waiting to be rasterized (ImFontAtlasFlags_BatchGlyphRasterization)
+struct ImFontAtlasPage;             // Texture page (ImFontAtlasFlags_MultiPage)
 
 // ImGui
 struct ImGuiBoxSelectState;         // Box-selection state (currently used by multi-selection, could potentially be used by others)
@@ -226,8 +228,12 @@ typedef ImU16 ImGuiTableDrawChannelIdx;
 //-----------------------------------------------------------------------------
 
 #ifndef GImGui
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+extern IMGUI_API thread_local ImGuiContext* GImGui;  // Current implicit context pointer, per thread
+#else
 extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 #endif
+#endif
 
 //-----------------------------------------------------------------------------
 // [SECTION] Macros
@@ -377,6 +383,7 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+IMGUI_API ImU64         ImHashData64(const void* data, size_t data_size, ImU64 seed = 0);     // Faster, non-persistent hash to detect contents changes
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -437,6 +444,7 @@ IMGUI_API int           ImTextCountUtf8BytesFromChar(const char* in_text, const
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                        // return number of bytes to express string in UTF-8
 IMGUI_API const char*   ImTextFindPreviousUtf8Codepoint(const char* in_text_start, const char* in_text_curr);                   // return previous UTF-8 code-point.
 IMGUI_API int           ImTextCountLines(const char* in_text, const char* in_text_end);                                         // return number of lines taken by text. trailing carriage return doesn't count as an extra line.
+IMGUI_API const char*   ImTextFindNonAscii(const char* in_text, const char* in_text_end, int min_char);                         // return first byte which is not an ASCII character in the [min_char..0x7F] range, or in_text_end. Uses SSE2/AVX2 when available.
 
 // Helpers: File System
 #ifdef IMGUI_DISABLE_FILE_FUNCTIONS
@@ -459,6 +467,9 @@ IMGUI_API ImU64             ImFileWrite(const void* data, ImU64 size, ImU64 coun
 #define IMGUI_DISABLE_TTY_FUNCTIONS // Can't use stdout, fflush if we are not using default file functions
 #endif
 IMGUI_API void*             ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_file_size = NULL, int padding_bytes = 0);
+IMGUI_API void*             ImFileMapToMemory(const char* filename, size_t* out_file_size); // Read-only. Return NULL if unsupported (e.g. IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS) or failed.
+IMGUI_API void              ImFileUnmap(void* file_data, size_t file_size);
+IMGUI_API ImU64             ImFileGetUniqueId(const char* filename); // Hash of file identity (device+inode, or volume+file index) and of its size and modification time. Return 0 if unsupported or failed.
 
 // Helpers: Maths
 IM_MSVC_RUNTIME_CHECKS_OFF
@@ -841,6 +852,23 @@ IMGUI_API ImGuiStoragePair* ImLowerBound(ImGuiStoragePair* in_begin, ImGuiStorag
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// ImDrawVert: Helpers to write/read vertices regardless of the layout selected by IMGUI_USE_COMPACT_DRAWVERT. 'origin' is ImDrawList::VtxOrigin.
+#ifdef IMGUI_USE_COMPACT_DRAWVERT
+static inline ImS16  ImDrawVertPackPos(float v)                                         { v *= IM_DRAWVERT_POS_SCALE; IM_ASSERT_PARANOID(v >= -32768.0f && v <= 32767.0f && "Vertex too far from ImDrawList::VtxOrigin for IMGUI_USE_COMPACT_DRAWVERT!"); v = ImClamp(v, -32768.0f, 32767.0f); return (ImS16)(int)(v + (v >= 0.0f ? 0.5f : -0.5f)); }
+static inline ImU16  ImDrawVertPackUV(float v)                                          { return (ImU16)(int)(ImSaturate(v) * 65535.0f + 0.5f); }
+static inline ImVec2 ImDrawVertGetPos(const ImDrawVert* v, const ImVec2& origin)        { return ImVec2(origin.x + v->pos[0] * (1.0f / IM_DRAWVERT_POS_SCALE), origin.y + v->pos[1] * (1.0f / IM_DRAWVERT_POS_SCALE)); }
+static inline ImVec2 ImDrawVertGetUV(const ImDrawVert* v)                               { return ImVec2(v->uv[0] * (1.0f / 65535.0f), v->uv[1] * (1.0f / 65535.0f)); }
+static inline void   ImDrawVertSetPos(ImDrawVert* v, const ImVec2& pos, const ImVec2& origin) { v->pos[0] = ImDrawVertPackPos(pos.x - origin.x); v->pos[1] = ImDrawVertPackPos(pos.y - origin.y); }
+static inline void   ImDrawVertSetUV(ImDrawVert* v, const ImVec2& uv)                   { v->uv[0] = ImDrawVertPackUV(uv.x); v->uv[1] = ImDrawVertPackUV(uv.y); }
+#define IM_DRAWVERT_WRITE(_VTX,_X,_Y,_UV,_COL,_ORIGIN)  { (_VTX)->pos[0] = ImDrawVertPackPos((_X) - (_ORIGIN).x); (_VTX)->pos[1] = ImDrawVertPackPos((_Y) - (_ORIGIN).y); (_VTX)->uv[0] = ImDrawVertPackUV((_UV).x); (_VTX)->uv[1] = ImDrawVertPackUV((_UV).y); (_VTX)->col = (_COL); } (void)0
+#else
+static inline ImVec2 ImDrawVertGetPos(const ImDrawVert* v, const ImVec2& origin)        { IM_UNUSED(origin); return ImVec2(v->pos.x, v->pos.y); }
+static inline ImVec2 ImDrawVertGetUV(const ImDrawVert* v)                               { return ImVec2(v->uv.x, v->uv.y); }
+static inline void   ImDrawVertSetPos(ImDrawVert* v, const ImVec2& pos, const ImVec2& origin) { IM_UNUSED(origin); v->pos = pos; }
+static inline void   ImDrawVertSetUV(ImDrawVert* v, const ImVec2& uv)                   { v->uv = uv; }
+#define IM_DRAWVERT_WRITE(_VTX,_X,_Y,_UV,_COL,_ORIGIN)  { (_VTX)->pos.x = (_X); (_VTX)->pos.y = (_Y); (_VTX)->uv = (_UV); (_VTX)->col = (_COL); IM_UNUSED(_ORIGIN); } (void)0
+#endif
+
 // Data shared between all ImDrawList instances
 // Conceptually this could have been called e.g. ImDrawListSharedContext
 // Typically one ImGui context would create and maintain one of this.
@@ -858,8 +886,11 @@ struct IMGUI_API ImDrawListSharedData
     float           InitialFringeScale;         // Initial scale to apply to AA fringe
     ImDrawListFlags InitialFlags;               // Initial flags at the beginning of the frame (it is possible to alter flags on a per-drawlist basis afterwards)
     ImVec4          ClipRectFullscreen;         // Value for PushClipRectFullscreen()
-    ImVector<ImVec2> TempBuffer;                // Temporary write buffer
     ImVector<ImDrawList*> DrawLists;            // All draw lists associated to this ImDrawListSharedData
+    ImTextureRef    FontAtlasTexRef;            // FontAtlas->TexRef as last seen by DrawLists[], see ImFontAtlasSyncDrawListSharedData()
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+    ImVec4          TexUvLinesCopy[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1]; // Copy of FontAtlas->TexUvLines[] matching FontAtlasTexRef, as another thread may modify the atlas while we draw
+#endif
     ImGuiContext*   Context;                    // [OPTIONAL] Link to Dear ImGui context. 99% of ImDrawList/ImFontAtlas can function without an ImGui context, but this facilitate handling one legacy edge case.
 
     // Lookup tables
@@ -887,6 +918,52 @@ struct ImFontStackData
     float       FontSizeAfterScaling;       // ~~ g.FontSize
 };
 
+// Cross-frame cache of CalcTextSize() results, enabled with io.ConfigTextSizeCache.
+// - 4-way set associative table: on a miss, the least recently used entry of the set is replaced.
+// - Entries are invalidated when any baked font of the atlas is discarded (see ImFontAtlasBakedDiscard() which bumps ImFontAtlas::BakedGeneration).
+#ifndef IM_TEXT_SIZE_CACHE_SIZE
+#define IM_TEXT_SIZE_CACHE_SIZE                                 4096 // Number of entries. Must be a power of two.
+#endif
+#define IM_TEXT_SIZE_CACHE_WAYS                                 4    // Number of entries per set.
+struct ImGuiTextSizeCacheEntry
+{
+    ImU64           Hash;                   // Hash of text and of other fields below
+    int             Generation;             // == ImFontAtlas::BakedGeneration when stored
+    int             LastFrameUsed;
+    ImFontBaked*    FontBaked;
+    float           FontSize;
+    float           WrapWidth;
+    ImVec2          TextSize;               // Output of CalcTextSize() (rounded)
+};
+
+// Word-wrapped line index of a large text block, cached across frames by TextEx() (e.g. TextWrapped() with more than 2000 characters).
+// Keyed by call order rather than by text pointer, so text formatted into a new buffer every frame reuses the same entry.
+// Rebuilt when text contents, font or wrap width change. Discarded when not used for a frame.
+struct ImGuiTextWrapCache
+{
+    ImGuiID         ID;                     // Key in g.TextWrapCaches: hash of ID stack top and index of the text block in the window (== window->DC.TextWrapCacheCount)
+    ImU64           TextHash;               // == ImHashData64(text)
+    int             TextLen;
+    int             LastFrameUsed;
+    int             Generation;             // == ImFontAtlas::BakedGeneration when built (invalidated when baked fonts are discarded)
+    ImFontBaked*    FontBaked;
+    float           FontSize;
+    float           WrapWidth;
+    ImVec2          TextSize;               // Output of CalcTextSize()
+    ImVector<int>   LineOffsets;            // Begin/end offsets of each visual line (two entries per line), see ImFontCalcWordWrapLines()
+
+    ImGuiTextWrapCache()    { ID = 0; TextHash = 0; TextLen = LastFrameUsed = Generation = 0; FontBaked = NULL; FontSize = WrapWidth = 0.0f; }
+};
+
+struct ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Entries;  // IM_TEXT_SIZE_CACHE_SIZE entries, allocated on first use. Zero-cleared entries never match as ImFontAtlas::BakedGeneration starts at 1.
+    int             HitsCount;              // Number of measurements served from the cache this frame
+    int             MissesCount;            // Number of measurements computed this frame
+
+    ImGuiTextSizeCache()    { HitsCount = MissesCount = 0; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Style support
 //-----------------------------------------------------------------------------
@@ -1268,6 +1345,9 @@ enum ImGuiWindowRefreshFlags_
     ImGuiWindowRefreshFlags_TryToAvoidRefresh   = 1 << 0,   // [EXPERIMENTAL] Try to keep existing contents, USER MUST NOT HONOR BEGIN() RETURNING FALSE AND NOT APPEND.
     ImGuiWindowRefreshFlags_RefreshOnHover      = 1 << 1,   // [EXPERIMENTAL] Always refresh on hover
     ImGuiWindowRefreshFlags_RefreshOnFocus      = 1 << 2,   // [EXPERIMENTAL] Always refresh on focus
+    ImGuiWindowRefreshFlags_RefreshOnInput      = 1 << 3,   // [EXPERIMENTAL] Refresh on mouse inputs while hovered, keyboard inputs while focused, while owning the active item, and one frame after.
+    ImGuiWindowRefreshFlags_RefreshOnChange     = 1 << 4,   // [EXPERIMENTAL] Refresh when position, size, scroll, style, font or font atlas texture changed, or after calling InvalidateWindowRefresh().
+    ImGuiWindowRefreshFlags_RetainGeometry      = ImGuiWindowRefreshFlags_TryToAvoidRefresh | ImGuiWindowRefreshFlags_RefreshOnInput | ImGuiWindowRefreshFlags_RefreshOnChange,
     // Refresh policy/frequency, Load Balancing etc.
 };
 
@@ -2102,6 +2182,7 @@ struct ImGuiViewportP : public ImGuiViewport
     ImDrawList*         BgFgDrawLists[2];       // Convenience background (0) and foreground (1) draw lists. We use them to draw software mouser cursor when io.MouseDrawCursor is set and to draw most debug overlays.
     ImDrawData          DrawDataP;
     ImDrawDataBuilder   DrawDataBuilder;        // Temporary data while building final ImDrawData
+    ImVector<ImDrawList*> MergedDrawLists;      // Draw lists owned by the viewport, output of merging DrawDataP.CmdLists[] when io.ConfigDrawDataMergeDrawLists is set
     ImVec2              LastPlatformPos;
     ImVec2              LastPlatformSize;
     ImVec2              LastRendererSize;
@@ -2116,7 +2197,7 @@ struct ImGuiViewportP : public ImGuiViewport
     ImVec2              BuildWorkInsetMax;      // "
 
     ImGuiViewportP()                    { Window = NULL; Idx = -1; LastFrameActive = BgFgDrawListsLastFrame[0] = BgFgDrawListsLastFrame[1] = LastFocusedStampCount = -1; LastNameHash = 0; Alpha = LastAlpha = 1.0f; LastFocusedHadNavWindow = false; PlatformMonitor = -1; BgFgDrawLists[0] = BgFgDrawLists[1] = NULL; LastPlatformPos = LastPlatformSize = LastRendererSize = ImVec2(FLT_MAX, FLT_MAX); }
-    ~ImGuiViewportP()                   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); }
+    ~ImGuiViewportP()                   { if (BgFgDrawLists[0]) IM_DELETE(BgFgDrawLists[0]); if (BgFgDrawLists[1]) IM_DELETE(BgFgDrawLists[1]); for (ImDrawList* draw_list : MergedDrawLists) IM_DELETE(draw_list); }
     void    ClearRequestFlags()         { PlatformRequestClose = PlatformRequestMove = PlatformRequestResize = false; }
 
     // Calculate work rect pos/size given a set of offset (we have 1 pair of offset for rect locked from last frame data, and 1 pair for currently building rect)
@@ -2337,12 +2418,20 @@ struct ImGuiContext
     ImVector<ImFontAtlas*>  FontAtlases;                        // List of font atlases used by the context (generally only contains g.IO.Fonts aka the main font atlas)
     ImFont*                 Font;                               // Currently bound font. (== FontStack.back().Font)
     ImFontBaked*            FontBaked;                          // Currently bound font at currently bound size. (== Font->GetFontBaked(FontSize))
+    ImGuiTextSizeCache      TextSizeCache;                      // CalcTextSize() results, when io.ConfigTextSizeCache is set
+    ImPool<ImGuiTextWrapCache> TextWrapCaches;                  // Word-wrapped line index of large text blocks, see TextEx()
     float                   FontSize;                           // Currently bound font size == line height (== FontSizeBase + externals scales applied in the UpdateCurrentFontSize() function).
     float                   FontSizeBase;                       // Font size before scaling == style.FontSizeBase == value passed to PushFont() when specified.
     float                   FontBakedScale;                     // == FontBaked->Size / FontSize. Scale factor over baked size. Rarely used nowadays, very often == 1.0f.
     float                   FontRasterizerDensity;              // Current font density. Used by all calls to GetFontBaked().
     float                   CurrentDpiScale;                    // Current window/viewport DpiScale == CurrentViewport->DpiScale
     ImDrawListSharedData    DrawListSharedData;
+    ImVector<ImDrawList*>   DrawListsToFinalize;                // Draw lists of all viewports, gathered in Render() to be finalized in parallel
+    ImVector<ImRect>        OcclusionCullingRects;              // Temporary storage for io.ConfigDrawDataOcclusionCulling: opaque rectangles in front of the draw list being tested
+    int                     OcclusionCulledDrawListsCount;      // Number of draw lists culled by io.ConfigDrawDataOcclusionCulling during last Render()
+    int                     OcclusionCulledDrawCmdsCount;       // Number of draw commands culled from visible draw lists during last Render()
+    int                     OcclusionCulledVtxCount;            // Number of vertices of culled draw lists during last Render()
+    int                     OcclusionCulledIdxCount;            // Number of indices of culled draw lists and draw commands during last Render()
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -2369,6 +2458,9 @@ struct ImGuiContext
     ImVector<ImGuiWindowStackData> CurrentWindowStack;
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
+    int                     WindowsRefreshHitsCount;            // Number of windows with a refresh policy which reused their previous contents this frame
+    int                     WindowsRefreshMissesCount;          // Number of windows with a refresh policy which had to be refreshed this frame
+    ImGuiID                 WindowsRefreshStyleHash;            // Hash of style fields for ImGuiWindowRefreshFlags_RefreshOnChange, computed in NewFrame()
     float                   WindowsBorderHoverPadding;          // Padding around resizable windows for which hovering on counts as hovering the window == ImMax(style.TouchExtraPadding, style.WindowBorderHoverPadding). This isn't so multi-dpi friendly.
     ImGuiID                 DebugBreakInWindow;                 // Set to break in Begin() call.
     ImGuiWindow*            CurrentWindow;                      // Window being drawn into
@@ -2755,6 +2847,7 @@ struct IMGUI_API ImGuiWindowTempData
     int                     TreeDepth;              // Current tree depth.
     ImU32                   TreeHasStackDataDepthMask;      // Store whether given depth has ImGuiTreeNodeStackData data. Could be turned into a ImU64 if necessary.
     ImU32                   TreeRecordsClippedNodesY2Mask;  // Store whether we should keep recording Y2. Cleared when passing clip max. Equivalent TreeHasStackDataDepthMask value should always be set.
+    int                     TextWrapCacheCount;     // Number of large wrapped text blocks submitted this frame. Used to key g.TextWrapCaches[] (see TextEx()).
     ImVector<ImGuiWindow*>  ChildWindows;
     ImGuiStorage*           StateStorage;           // Current persistent per-window storage (store e.g. tree node open/close state)
     ImGuiOldColumns*        CurrentColumns;         // Current columns set
@@ -2898,6 +2991,17 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
 
+    // [EXPERIMENTAL] Refresh policy (see SetNextWindowRefreshPolicy())
+    ImGuiWindowRefreshFlags RefreshFlags;                       // Refresh policy of last Begin()
+    bool                    RefreshInvalidated;                 // Set by InvalidateWindowRefresh(), cleared on next refresh
+    bool                    RefreshSettling;                    // Was refreshed on last frame: refresh one more frame to let layout settle
+    ImVec2                  RefreshLastPos;                     // Pos/Size/Scroll at the end of the last refresh
+    ImVec2                  RefreshLastSize;
+    ImVec2                  RefreshLastScroll;
+    ImGuiID                 RefreshLastStateHash;               // Hash of style, font and atlas texture at the time of the last refresh
+    int                     RefreshHitsCount;                   // Number of frames which reused previous contents
+    int                     RefreshMissesCount;                 // Number of frames which had to be refreshed
+
     // Docking
     bool                    DockIsActive        :1;             // When docking artifacts are actually visible. When this is set, DockNode is guaranteed to be != NULL. ~~ (DockNode != NULL) && (DockNode->Windows.Size > 1).
     bool                    DockNodeIsVisible   :1;
@@ -3347,6 +3451,8 @@ namespace ImGui
 
     // Windows: Idle, Refresh Policies [EXPERIMENTAL]
     IMGUI_API void          SetNextWindowRefreshPolicy(ImGuiWindowRefreshFlags flags);
+    IMGUI_API void          InvalidateWindowRefresh(ImGuiWindow* window);   // Refresh contents on next Begin() when using ImGuiWindowRefreshFlags_RefreshOnChange, e.g. after application data changed.
+    IMGUI_API void          InvalidateWindowRefresh(const char* name);
 
     // Fonts, drawing
     IMGUI_API void          RegisterUserTexture(ImTextureData* tex); // Register external texture
@@ -3363,6 +3469,7 @@ namespace ImGui
     IMGUI_API void          PopPasswordFont();
     inline ImDrawList*      GetForegroundDrawList(ImGuiWindow* window) { return GetForegroundDrawList(window->Viewport); }
     IMGUI_API void          AddDrawListToDrawDataEx(ImDrawData* draw_data, ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
+    IMGUI_API void          ParallelFor(void (*task_func)(void* task_data, int task_idx), void* task_data, int task_count);
 
     // Init
     IMGUI_API void          Initialize();
@@ -3976,6 +4083,8 @@ namespace ImGui
 // [SECTION] ImFontLoader
 //-----------------------------------------------------------------------------
 
+#define IM_FONTBAKED_PRERENDER_BATCH_SIZE   1024    // Max codepoints given at once to ImFontLoader::FontBakedPrerenderGlyphs()
+
 // Hooks and storage for a given font backend.
 // This structure is likely to evolve as we add support for incremental atlas updates.
 // Conceptually this could be public, but API is still going to be evolve.
@@ -3991,6 +4100,14 @@ struct ImFontLoader
     void            (*FontBakedDestroy)(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src);
     bool            (*FontBakedLoadGlyph)(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, ImWchar codepoint, ImFontGlyph* out_glyph);
 
+    // Optional: called by ImFontBaked::LoadGlyphs() with the codepoints FontBakedLoadGlyph() is about to be called with for this source, so they may be rendered ahead (e.g. in parallel).
+    // Called again with codepoints_count == 0 once done, to release glyphs that were not requested and their pixels.
+    // Large ranges are split in batches of at most IM_FONTBAKED_PRERENDER_BATCH_SIZE codepoints, so the loader never holds more than one batch of pixels.
+    void            (*FontBakedPrerenderGlyphs)(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, const ImWchar* codepoints, int codepoints_count);
+
+    // Set when FontBakedLoadGlyph() outputs signed distance fields (see IM_FONTATLAS_SDF_XXX) if atlas->Flags has ImFontAtlasFlags_SDF.
+    bool            SupportsSdf;
+
     // Size of backend data, Per Baked * Per Source. Buffers are managed by core to avoid excessive allocations.
     // FIXME: At this point the two other types of buffers may be managed by core to be consistent?
     size_t          FontBakedSrcLoaderDataSize;
@@ -4034,6 +4151,30 @@ struct ImFontAtlasRectEntry
     unsigned int        IsUsed : 1;
 };
 
+// Texture page (ImFontAtlasFlags_MultiPage)
+// - Without the flag there is a single page, which follows atlas->TexData as it gets resized.
+// - With the flag, only the current page (== atlas->TexData) receives new rectangles. Other pages are left untouched until they get empty and reused,
+//   or until reaching IM_FONTATLAS_PAGES_MAX.
+// - All pages have the same size and hold the rectangles for white pixel/mouse cursors/lines at the same location, so TexUvWhitePixel and TexUvLines are valid with any page.
+// - With atlas->TexDesiredFormat == ImTextureFormat_Alpha8, colored glyphs and colored custom rectangles go to ImTextureFormat_RGBA32 pages,
+//   packed separately from Pages[PageCurrentColor]. Other pages stay in ImTextureFormat_Alpha8.
+// - After IM_FONTATLAS_PAGES_MAX pages, the page with least used surface is repacked into a new texture (see ImFontAtlasTextureRepackEmptiestPage()).
+//   If every page is more than 3/4 full, loading more glyphs is a user error ("Out of texture memory" assert): use bigger pages, or set ImFontAtlas::TexGlyphBudget.
+#define IM_FONTATLAS_PAGES_MAX              32      // Limited by ImFontGlyph::PageIdx
+
+struct ImFontAtlasPage
+{
+    ImTextureData*      Tex;
+    int                 RectsCount;             // Number of rectangles in use in this page, including the ones shared by all pages.
+};
+
+// Signed distance field glyphs (ImFontAtlasFlags_SDF)
+// - Requested sizes are rounded up to a power of two (no less than IM_FONTATLAS_SDF_BAKED_SIZE_MIN) to select the ImFontBaked: rendering scales glyphs from there.
+// - Glyph rectangles include IM_FONTATLAS_SDF_PADDING texels of distance field on each side. Alpha == IM_FONTATLAS_SDF_ONEDGE_VALUE on the glyph outline.
+#define IM_FONTATLAS_SDF_BAKED_SIZE_MIN     32
+#define IM_FONTATLAS_SDF_PADDING            4
+#define IM_FONTATLAS_SDF_ONEDGE_VALUE       128
+
 // Data available to potential texture post-processing functions
 struct ImFontAtlasPostProcessData
 {
@@ -4051,6 +4192,103 @@ struct ImFontAtlasPostProcessData
     int                 Height;
 };
 
+// Glyph laid out and packed by a font loader, waiting to be rasterized (ImFontAtlasFlags_BatchGlyphRasterization)
+// - RasterizeFunc() is called from ImFontAtlasBuildRasterizePendingGlyphs(), possibly concurrently with other glyphs: it must only write to 'out_pixels' (Alpha8, Width*Height).
+// - The glyph is then looked up from BakedId/PackId, so it is skipped if its baked font or rectangle got discarded in the meanwhile.
+struct ImFontAtlasPendingGlyph
+{
+    void                (*RasterizeFunc)(const ImFontAtlasPendingGlyph* pending, unsigned char* out_pixels);
+    ImFontConfig*       FontSrc;
+    ImGuiID             BakedId;
+    ImFontAtlasRectId   PackId;
+    int                 BakedGlyphIndex;        // Index into ImFontBaked::Glyphs[], set by ImFontAtlasBakedAddFontGlyph(). Verified against PackId, as evicting glyphs compacts Glyphs[].
+    int                 Width;
+    int                 Height;
+    int                 PixelsOffset;           // Offset into ImFontAtlasBuilder::PendingGlyphsPixels[]
+
+    // Loader data
+    int                 GlyphIndex;
+    float               ScaleX, ScaleY;
+    int                 OversampleH, OversampleV;
+};
+
+// Font file data loaded by ImFontAtlas::AddFontFromFileTTF(), shared between all atlases loading the same file.
+// - Memory-mapped when supported (see ImFileMapToMemory() for caveats), otherwise loaded into heap memory.
+// - Identified by ImFileGetUniqueId(), so a file modified or replaced on disk since it was loaded gets loaded again. Falls back to comparing filenames when unsupported.
+// - Each ImFontConfig::FontDataShared holds a reference. Data is released with the last reference.
+struct ImFontSharedFileData
+{
+    ImFontSharedFileData*   Next;               // Linked list of all loaded files
+    char*                   Filename;
+    ImU64                   FileId;             // == ImFileGetUniqueId(Filename) when loaded, 0 if unsupported
+    void*                   Data;               // Read-only!
+    size_t                  DataSize;
+    int                     RefCount;
+    bool                    DataIsMapped;
+};
+
+// Persistent glyph cache (ImFontAtlas::LoadGlyphCache(), ImFontAtlas::SaveGlyphCache())
+// - File layout: ImFontAtlasGlyphCacheHeader, ImFontAtlasGlyphCacheBaked[BakedCount], ImFontAtlasGlyphCacheGlyph[GlyphsCount], unsigned char Pixels[PixelsSize].
+// - Each baked entry is identified by a hash of its size, rasterizer density and of every source (loader, TTF data, settings). Its glyphs are sorted by codepoint.
+// - Glyph pixels are stored as Alpha8, or as RGBA32 for colored glyphs, and converted to the texture format when loaded.
+// - Keys are hashed from parameters serialized in little-endian order, so they don't depend on the platform. Other fields are stored in native endianness:
+//   a file written with the other byte order fails the Version check. Any version or layout mismatch discards the whole file.
+#define IM_FONTATLAS_GLYPH_CACHE_VERSION    2
+
+struct ImFontAtlasGlyphCacheHeader
+{
+    char                Magic[4];               // "IMGC"
+    ImU32               Version;                // == IM_FONTATLAS_GLYPH_CACHE_VERSION
+    ImU32               ImGuiVersionNum;        // == IMGUI_VERSION_NUM
+    ImU32               BakedCount;
+    ImU32               GlyphsCount;
+    ImU32               PixelsSize;
+    ImU32               Reserved[2];
+};
+
+struct ImFontAtlasGlyphCacheBaked
+{
+    ImU64               Key;                    // See ImFontAtlasGlyphCacheGetBakedKey()
+    float               Ascent, Descent;
+    ImU32               GlyphsOffset;           // Index of first glyph in ImFontAtlasGlyphCache::Glyphs[]
+    ImU32               GlyphsCount;
+};
+
+struct ImFontAtlasGlyphCacheGlyph
+{
+    ImU32               Codepoint;              // After applying ImFont::RemapPairs
+    ImU8                SourceIdx;
+    ImU8                Visible;
+    ImU8                Colored;
+    ImU8                PixelsFormat;           // ImTextureFormat
+    float               AdvanceX;
+    float               X0, Y0, X1, Y1;
+    ImU16               Width, Height;          // Packed rectangle size, 0 when there are no pixels
+    ImU32               PixelsOffset;           // Offset into ImFontAtlasGlyphCache::Pixels[]
+};
+
+struct ImFontAtlasGlyphCacheFontData
+{
+    const void*         FontData;
+    int                 FontDataSize;
+    ImU64               Hash;
+};
+
+struct ImFontAtlasGlyphCache
+{
+    void*                               FileData;   // Whole file, owned. Memory-mapped when supported (see ImFileMapToMemory()), otherwise loaded into heap memory.
+    size_t                              FileDataSize;
+    bool                                FileDataIsMapped;
+    const ImFontAtlasGlyphCacheHeader*  Header;     // Pointers into FileData
+    const ImFontAtlasGlyphCacheBaked*   Baked;
+    const ImFontAtlasGlyphCacheGlyph*   Glyphs;
+    const unsigned char*                Pixels;
+    ImGuiStorage                        BakedMap;   // ImFontBaked::BakedId --> 1 + index into Baked[], 0 when not bound
+    ImVector<ImFontAtlasGlyphCacheFontData> FontDataHashes; // Avoid hashing TTF data for every new baked size. Entries are removed when their FontData is released, as its address may be reused.
+
+    ImFontAtlasGlyphCache()     { memset((void*)this, 0, sizeof(*this)); }
+};
+
 // We avoid dragging imstb_rectpack.h into public header (partly because binding generators are having issues with it)
 #ifdef IMGUI_STB_NAMESPACE
 namespace IMGUI_STB_NAMESPACE { struct stbrp_node; }
@@ -4066,14 +4304,22 @@ struct ImFontAtlasBuilder
 {
     stbrp_context_opaque        PackContext;            // Actually 'stbrp_context' but we don't want to define this in the header file.
     ImVector<stbrp_node_im>     PackNodes;
+    stbrp_context_opaque        PackContextColor;       // Packing state of Pages[PageCurrentColor]
+    ImVector<stbrp_node_im>     PackNodesColor;
     ImVector<ImTextureRect>     Rects;
     ImVector<ImFontAtlasRectEntry> RectsIndex;          // ImFontAtlasRectId -> index into Rects[]
+    ImVector<ImU8>              RectsPage;              // Rects[] index -> index into Pages[]
+    ImVector<ImFontAtlasPage>   Pages;                  // Texture pages. Always a single one unless using ImFontAtlasFlags_MultiPage.
+    int                         PageCurrent;            // Page being packed into, Pages[PageCurrent].Tex == atlas->TexData
+    int                         PageCurrentColor;       // ImTextureFormat_RGBA32 page receiving colored rectangles when atlas->TexDesiredFormat == ImTextureFormat_Alpha8, -1 until first needed (see ImFontAtlasPackAddRect())
     ImVector<unsigned char>     TempBuffer;             // Misc scratch buffer
     int                         RectsIndexFreeListStart;// First unused entry
     int                         RectsPackedCount;       // Number of packed rectangles.
     int                         RectsPackedSurface;     // Number of packed pixels. Used when compacting to heuristically find the ideal texture size.
     int                         RectsDiscardedCount;
     int                         RectsDiscardedSurface;
+    int                         RectsUsedSurface;       // Number of pixels used by rectangles which are not discarded, on all pages. Compared to ImFontAtlas::TexGlyphBudget.
+    int                         RectsUsedSurfaceLastEvict; // Value of RectsUsedSurface after last call to ImFontAtlasBuildEvictGlyphs(), so we don't retry until more rectangles are packed.
     int                         FrameCount;             // Current frame count
     ImVec2i                     MaxRectSize;            // Largest rectangle to pack (de-facto used as a "minimum texture size")
     ImVec2i                     MaxRectBounds;          // Bottom-right most used pixels
@@ -4085,11 +4331,18 @@ struct ImFontAtlasBuilder
     ImGuiStorage                BakedMap;               // BakedId --> ImFontBaked*
     int                         BakedDiscardedCount;
 
+    // Glyphs waiting to be rasterized (ImFontAtlasFlags_BatchGlyphRasterization)
+    ImVector<ImFontAtlasPendingGlyph> PendingGlyphs;
+    ImVector<unsigned char>     PendingGlyphsPixels;
+
+    // Lock for atlas shared by multiple contexts in multiple threads (std::recursive_mutex* when IMGUI_ENABLE_THREAD_LOCAL_CONTEXT is defined)
+    void*                       Mutex;
+
     // Custom rectangle identifiers
     ImFontAtlasRectId           PackIdMouseCursors;     // White pixel + mouse cursors. Also happen to be fallback in case of packing failure.
     ImFontAtlasRectId           PackIdLinesTexData;
 
-    ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
+    ImFontAtlasBuilder()        { memset(this, 0, sizeof(*this)); FrameCount = -1; PageCurrentColor = -1; RectsIndexFreeListStart = -1; PackIdMouseCursors = PackIdLinesTexData = -1; }
 };
 
 IMGUI_API void              ImFontAtlasBuildInit(ImFontAtlas* atlas);
@@ -4099,6 +4352,29 @@ IMGUI_API void              ImFontAtlasBuildSetupFontLoader(ImFontAtlas* atlas,
 IMGUI_API void              ImFontAtlasBuildUpdatePointers(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildRenderBitmapFromString(ImFontAtlas* atlas, int x, int y, int w, int h, const char* in_str, char in_marker_char);
 IMGUI_API void              ImFontAtlasBuildClear(ImFontAtlas* atlas); // Clear output and custom rects
+IMGUI_API void              ImFontAtlasBuildRasterizePendingGlyphs(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasBuildDiscardPendingGlyphs(ImFontAtlas* atlas, ImFontConfig* src); // Discard glyphs of 'src', or all glyphs when 'src == NULL'
+
+IMGUI_API ImU64             ImFontAtlasGlyphCacheGetBakedKey(ImFontAtlas* atlas, ImFontBaked* baked); // Return 0 if baked font cannot be cached
+IMGUI_API void              ImFontAtlasGlyphCacheBindBaked(ImFontAtlas* atlas, ImFontBaked* baked);
+IMGUI_API ImFontGlyph*      ImFontAtlasGlyphCacheLoadGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImWchar codepoint, ImWchar src_codepoint);
+IMGUI_API void              ImFontAtlasGlyphCacheDestroy(ImFontAtlas* atlas);
+
+// With IMGUI_ENABLE_THREAD_LOCAL_CONTEXT, hold the lock while using ImFontGlyph* returned by ImFontBaked::FindGlyph() etc., as another thread may load glyphs
+// and reallocate ImFontBaked::Glyphs[] as soon as it is released. ImFontBaked* stay valid until the next ImFontAtlasUpdateNewFrame() call.
+IMGUI_API void              ImFontAtlasLock(ImFontAtlas* atlas);    // No-op unless IMGUI_ENABLE_THREAD_LOCAL_CONTEXT is defined
+IMGUI_API void              ImFontAtlasUnlock(ImFontAtlas* atlas);
+struct ImFontAtlasScopedLock
+{
+    ImFontAtlas* Atlas;
+    ImFontAtlasScopedLock(ImFontAtlas* atlas)   { Atlas = atlas; ImFontAtlasLock(atlas); }
+    ~ImFontAtlasScopedLock()                    { ImFontAtlasUnlock(Atlas); }
+};
+#ifdef IMGUI_ENABLE_THREAD_LOCAL_CONTEXT
+#define IM_FONTATLAS_SCOPED_LOCK(_ATLAS)    ImFontAtlasScopedLock font_atlas_scoped_lock(_ATLAS)
+#else
+#define IM_FONTATLAS_SCOPED_LOCK(_ATLAS)    ((void)0)
+#endif
 
 IMGUI_API ImTextureData*    ImFontAtlasTextureAdd(ImFontAtlas* atlas, int w, int h);
 IMGUI_API void              ImFontAtlasTextureMakeSpace(ImFontAtlas* atlas);
@@ -4106,15 +4382,21 @@ IMGUI_API void              ImFontAtlasTextureRepack(ImFontAtlas* atlas, int w,
 IMGUI_API void              ImFontAtlasTextureGrow(ImFontAtlas* atlas, int old_w = -1, int old_h = -1);
 IMGUI_API void              ImFontAtlasTextureCompact(ImFontAtlas* atlas);
 IMGUI_API ImVec2i           ImFontAtlasTextureGetSizeEstimate(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasTextureAddPage(ImFontAtlas* atlas);
+IMGUI_API bool              ImFontAtlasTextureAddColorPage(ImFontAtlas* atlas);
 
 IMGUI_API void              ImFontAtlasBuildSetupFontSpecialGlyphs(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasBuildLegacyPreloadAllGlyphRanges(ImFontAtlas* atlas); // Legacy
 IMGUI_API void              ImFontAtlasBuildGetOversampleFactors(ImFontConfig* src, ImFontBaked* baked, int* out_oversample_h, int* out_oversample_v);
 IMGUI_API void              ImFontAtlasBuildDiscardBakes(ImFontAtlas* atlas, int unused_frames);
+IMGUI_API void              ImFontAtlasBuildEvictGlyphs(ImFontAtlas* atlas, int unused_frames);
 
 IMGUI_API bool              ImFontAtlasFontSourceInit(ImFontAtlas* atlas, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasFontSourceAddToFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* src);
 IMGUI_API void              ImFontAtlasFontDestroySourceData(ImFontAtlas* atlas, ImFontConfig* src);
+IMGUI_API ImFontSharedFileData* ImFontAtlasSharedFileDataAcquire(const char* filename); // Return a new reference, or NULL if file cannot be loaded
+IMGUI_API void              ImFontAtlasSharedFileDataAddRef(ImFontSharedFileData* shared_data);
+IMGUI_API void              ImFontAtlasSharedFileDataRelease(ImFontSharedFileData* shared_data);
 IMGUI_API bool              ImFontAtlasFontInitOutput(ImFontAtlas* atlas, ImFont* font); // Using FontDestroyOutput/FontInitOutput sequence useful notably if font loader params have changed
 IMGUI_API void              ImFontAtlasFontDestroyOutput(ImFontAtlas* atlas, ImFont* font);
 IMGUI_API void              ImFontAtlasFontDiscardBakes(ImFontAtlas* atlas, ImFont* font, int unused_frames);
@@ -4126,12 +4408,14 @@ IMGUI_API ImFontBaked*      ImFontAtlasBakedAdd(ImFontAtlas* atlas, ImFont* font
 IMGUI_API void              ImFontAtlasBakedDiscard(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked);
 IMGUI_API ImFontGlyph*      ImFontAtlasBakedAddFontGlyph(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, const ImFontGlyph* in_glyph);
 IMGUI_API void              ImFontAtlasBakedDiscardFontGlyph(ImFontAtlas* atlas, ImFont* font, ImFontBaked* baked, ImFontGlyph* glyph);
+IMGUI_API int               ImFontAtlasGetBakedGeneration(ImFontAtlas* atlas); // == atlas->BakedGeneration, read under the atlas lock
 IMGUI_API void              ImFontAtlasBakedSetFontGlyphBitmap(ImFontAtlas* atlas, ImFontBaked* baked, ImFontConfig* src, ImFontGlyph* glyph, ImTextureRect* r, const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch);
 
 IMGUI_API void              ImFontAtlasPackInit(ImFontAtlas* atlas);
-IMGUI_API ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry = NULL);
+IMGUI_API ImFontAtlasRectId ImFontAtlasPackAddRect(ImFontAtlas* atlas, int w, int h, ImFontAtlasRectEntry* overwrite_entry = NULL, bool colored = false); // 'colored': rectangle will receive ImTextureFormat_RGBA32 pixels
 IMGUI_API ImTextureRect*    ImFontAtlasPackGetRect(ImFontAtlas* atlas, ImFontAtlasRectId id);
 IMGUI_API ImTextureRect*    ImFontAtlasPackGetRectSafe(ImFontAtlas* atlas, ImFontAtlasRectId id);
+IMGUI_API ImTextureData*    ImFontAtlasPackGetRectTexture(ImFontAtlas* atlas, ImFontAtlasRectId id); // Return texture page holding the rectangle
 IMGUI_API void              ImFontAtlasPackDiscardRect(ImFontAtlas* atlas, ImFontAtlasRectId id);
 
 IMGUI_API void              ImFontAtlasUpdateNewFrame(ImFontAtlas* atlas, int frame_count, bool renderer_has_textures);
@@ -4139,6 +4423,7 @@ IMGUI_API void              ImFontAtlasAddDrawListSharedData(ImFontAtlas* atlas,
 IMGUI_API void              ImFontAtlasRemoveDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* data);
 IMGUI_API void              ImFontAtlasUpdateDrawListsTextures(ImFontAtlas* atlas, ImTextureRef old_tex, ImTextureRef new_tex);
 IMGUI_API void              ImFontAtlasUpdateDrawListsSharedData(ImFontAtlas* atlas);
+IMGUI_API void              ImFontAtlasSyncDrawListSharedData(ImFontAtlas* atlas, ImDrawListSharedData* shared_data);
 
 IMGUI_API void              ImFontAtlasTextureBlockConvert(const unsigned char* src_pixels, ImTextureFormat src_fmt, int src_pitch, unsigned char* dst_pixels, ImTextureFormat dst_fmt, int dst_pitch, int w, int h);
 IMGUI_API void              ImFontAtlasTextureBlockPostProcess(ImFontAtlasPostProcessData* data);
@@ -4147,9 +4432,13 @@ IMGUI_API void              ImFontAtlasTextureBlockFill(ImTextureData* dst_tex,
 IMGUI_API void              ImFontAtlasTextureBlockCopy(ImTextureData* src_tex, int src_x, int src_y, ImTextureData* dst_tex, int dst_x, int dst_y, int w, int h);
 IMGUI_API void              ImFontAtlasTextureBlockQueueUpload(ImFontAtlas* atlas, ImTextureData* tex, int x, int y, int w, int h);
 
+IMGUI_API void              ImFontCalcWordWrapLines(ImFont* font, float size, const char* text, const char* text_end, float wrap_width, ImVector<int>* out_line_offsets);
+IMGUI_API ImVec2            ImFontRenderTextMeasured(ImFont* font, ImDrawList* draw_list, float size, const ImVec2& pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float max_width, bool cpu_fine_clip, const char** out_remaining); // Same as ImFont::RenderText() + CalcTextSizeA() without wrapping, in a single pass.
+
 IMGUI_API int               ImTextureDataGetFormatBytesPerPixel(ImTextureFormat format);
 IMGUI_API const char*       ImTextureDataGetStatusName(ImTextureStatus status);
 IMGUI_API const char*       ImTextureDataGetFormatName(ImTextureFormat format);
+IMGUI_API float             ImTextureDataSampleSdf(ImTextureData* tex, ImVec2 uv, float texels_per_pixel); // CPU reference of coverage output by ImGuiBackendFlags_RendererHasSdfTextures backends
 
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
 IMGUI_API void              ImFontAtlasDebugLogTextureRequests(ImFontAtlas* atlas);
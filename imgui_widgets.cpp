@@ -176,7 +176,60 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
     const ImVec2 text_pos(window->DC.CursorPos.x, window->DC.CursorPos.y + window->DC.CurrLineTextBaseOffset);
     const float wrap_pos_x = window->DC.TextWrapPos;
     const bool wrap_enabled = (wrap_pos_x >= 0.0f);
-    if (text_end - text <= 2000 || wrap_enabled)
+    if (text_end - text > 2000 && wrap_enabled && !g.LogEnabled)
+    {
+        // Long wrapped text!
+        // Use a cached index of wrapped lines, so we only measure/wrap the text when its contents, font or wrap width change,
+        // and only render visible lines. Output is the same as RenderTextWrapped() over the whole text.
+        const float wrap_width = CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x);
+        const int text_len = (int)(text_end - text_begin);
+        const ImU64 text_hash = ImHashData64(text_begin, (size_t)text_len);
+        const ImGuiID cache_id = ImHashData(&window->DC.TextWrapCacheCount, sizeof(int), window->IDStack.back());
+        window->DC.TextWrapCacheCount++;
+        const int generation = ImFontAtlasGetBakedGeneration(g.Font->ContainerAtlas);
+        ImGuiTextWrapCache* cache = g.TextWrapCaches.GetOrAddByKey(cache_id);
+        if (cache->ID != cache_id || cache->TextHash != text_hash || cache->TextLen != text_len || cache->Generation != generation || cache->FontBaked != g.FontBaked || cache->FontSize != g.FontSize || cache->WrapWidth != wrap_width)
+        {
+            cache->ID = cache_id;
+            cache->TextHash = text_hash;
+            cache->TextLen = text_len;
+            cache->Generation = generation;
+            cache->FontBaked = g.FontBaked;
+            cache->FontSize = g.FontSize;
+            cache->WrapWidth = wrap_width;
+            cache->TextSize = CalcTextSize(text_begin, text_end, false, wrap_width);
+            ImFontCalcWordWrapLines(g.Font, g.FontSize, text_begin, text_end, wrap_width, &cache->LineOffsets);
+        }
+        cache->LastFrameUsed = g.FrameCount;
+
+        ImRect bb(text_pos, text_pos + cache->TextSize);
+        ItemSize(cache->TextSize, 0.0f);
+        if (!ItemAdd(bb, 0))
+            return;
+
+        // Render visible lines, with wrapping disabled as line boundaries are already known.
+        ImDrawList* draw_list = window->DrawList;
+        const ImU32 col = GetColorU32(ImGuiCol_Text);
+        if ((col & IM_COL32_A_MASK) == 0)
+            return;
+        const ImVec4 clip_rect = draw_list->_CmdHeader.ClipRect;
+        const float line_height = g.FontSize;
+        const float line0_y = IM_TRUNC(bb.Min.y);
+        const int lines_count = cache->LineOffsets.Size / 2;
+        for (int line_n = ImMax((int)((clip_rect.y - line0_y) / line_height) - 1, 0); line_n < lines_count; line_n++)
+        {
+            const float line_y = line0_y + line_n * line_height;
+            if (line_y > clip_rect.w)
+                break;
+            if (line_y + line_height < clip_rect.y)
+                continue;
+            const char* line_begin = text_begin + cache->LineOffsets[line_n * 2 + 0];
+            const char* line_end = text_begin + cache->LineOffsets[line_n * 2 + 1];
+            if (line_begin < line_end)
+                g.Font->RenderText(draw_list, g.FontSize, ImVec2(bb.Min.x, line_y), col, clip_rect, line_begin, line_end, 0.0f, false);
+        }
+    }
+    else if (text_end - text <= 2000 || wrap_enabled)
     {
         // Common case
         const float wrap_width = wrap_enabled ? CalcWrapWidthForPos(window->DC.CursorPos, wrap_pos_x) : 0.0f;
@@ -4324,13 +4377,14 @@ void ImGui::PushPasswordFont()
 {
     ImGuiContext& g = *GImGui;
     ImFontBaked* backup = &g.InputTextPasswordFontBackupBaked;
-    IM_ASSERT(backup->IndexAdvanceX.Size == 0 && backup->IndexLookup.Size == 0);
+    IM_ASSERT(backup->IndexPagesMap.Size == 0 && backup->IndexPages.Size == 0);
+    ImFontAtlasLock(g.Font->ContainerAtlas); // We are altering font data possibly shared with other contexts: hold lock until PopPasswordFont().
     ImFontGlyph* glyph = g.FontBaked->FindGlyph('*');
     g.InputTextPasswordFontBackupFlags = g.Font->Flags;
     backup->FallbackGlyphIndex = g.FontBaked->FallbackGlyphIndex;
     backup->FallbackAdvanceX = g.FontBaked->FallbackAdvanceX;
-    backup->IndexLookup.swap(g.FontBaked->IndexLookup);
-    backup->IndexAdvanceX.swap(g.FontBaked->IndexAdvanceX);
+    backup->IndexPagesMap.swap(g.FontBaked->IndexPagesMap);
+    backup->IndexPages.swap(g.FontBaked->IndexPages);
     g.Font->Flags |= ImFontFlags_NoLoadGlyphs;
     g.FontBaked->FallbackGlyphIndex = g.FontBaked->Glyphs.index_from_ptr(glyph);
     g.FontBaked->FallbackAdvanceX = glyph->AdvanceX;
@@ -4343,9 +4397,10 @@ void ImGui::PopPasswordFont()
     g.Font->Flags = g.InputTextPasswordFontBackupFlags;
     g.FontBaked->FallbackGlyphIndex = backup->FallbackGlyphIndex;
     g.FontBaked->FallbackAdvanceX = backup->FallbackAdvanceX;
-    g.FontBaked->IndexLookup.swap(backup->IndexLookup);
-    g.FontBaked->IndexAdvanceX.swap(backup->IndexAdvanceX);
-    IM_ASSERT(backup->IndexAdvanceX.Size == 0 && backup->IndexLookup.Size == 0);
+    g.FontBaked->IndexPagesMap.swap(backup->IndexPagesMap);
+    g.FontBaked->IndexPages.swap(backup->IndexPages);
+    IM_ASSERT(backup->IndexPagesMap.Size == 0 && backup->IndexPages.Size == 0);
+    ImFontAtlasUnlock(g.Font->ContainerAtlas);
 }
 
 // Return false to discard a character.
@@ -7,6 +7,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025/XX/XX: added ImFontLoader::FontBakedPrerenderGlyphs() support: ImFontBaked::LoadGlyphs() renders glyphs in parallel using per-task FT_Library/FT_Face instances when platform_io.Platform_ParallelForFn is set.
 //  2025/06/11: refactored for the new ImFontLoader architecture, and ImGuiBackendFlags_RendererHasTextures support.
 //  2024/10/17: added plutosvg support for SVG Fonts (seems faster/better than lunasvg). Enable by using '#define IMGUI_ENABLE_FREETYPE_PLUTOSVG'. (#7927)
 //  2023/11/13: added support for ImFontConfig::RasterizationDensity field for scaling render density without scaling metrics.
@@ -95,6 +96,12 @@ static void* (*GImGuiFreeTypeAllocFunc)(size_t size, void* user_data) = ImGuiFre
 static void  (*GImGuiFreeTypeFreeFunc)(void* ptr, void* user_data) = ImGuiFreeTypeDefaultFreeFunc;
 static void* GImGuiFreeTypeAllocatorUserData = nullptr;
 
+// Maximum number of tasks rendering glyphs in parallel, each owning an FT_Library instance and one FT_Face instance per font source.
+#ifndef IMGUI_FREETYPE_MAX_WORKERS
+#define IMGUI_FREETYPE_MAX_WORKERS          16
+#endif
+#define IMGUI_FREETYPE_MIN_GLYPHS_PER_WORKER 8
+
 // Lunasvg support
 #ifdef IMGUI_ENABLE_FREETYPE_LUNASVG
 static FT_Error ImGuiLunasvgPortInit(FT_Pointer* state);
@@ -141,14 +148,56 @@ static FT_Error ImGuiLunasvgPortPresetSlot(FT_GlyphSlot slot, FT_Bool cache, FT_
 //              |                                   |
 //              |------------- advanceX ----------->|
 
+// Memory allocators used by FreeType libraries of worker tasks, which cannot use IM_ALLOC() as it may update context data.
+struct ImGui_ImplFreeType_Allocator
+{
+    void*                           (*AllocFunc)(size_t size, void* user_data);
+    void                            (*FreeFunc)(void* ptr, void* user_data);
+    void*                           UserData;
+};
+
+// Stored in ImGui_ImplFreeType_Data::Workers[]. ALLOCATED BY US.
+// Each task of ImGui_ImplFreeType_FontBakedPrerenderGlyphs() uses its own library and faces, so tasks can run concurrently.
+struct ImGui_ImplFreeType_Worker
+{
+    FT_Library                      Library;
+    FT_MemoryRec_                   MemoryManager;
+    ImGui_ImplFreeType_Allocator    Allocator;
+    ImGui_ImplFreeType_Worker()     { memset((void*)this, 0, sizeof(*this)); }
+};
+
+// Stored in ImGui_ImplFreeType_FontSrcData::WorkerFaces[]: instance of a font source owned by a worker.
+struct ImGui_ImplFreeType_WorkerFace
+{
+    FT_Face                         Face;               // Created from Workers[n]->Library
+    ImGui_ImplFreeType_Allocator*   Allocator;          // == &Workers[n]->Allocator
+    uint8_t*                        Pixels;             // Pixels of glyphs rendered by the last task: Alpha8, or RGBA32 for colored glyphs. Freed once ImFontBaked::LoadGlyphs() is done with them.
+    int                             PixelsSize;         // In bytes
+    int                             PixelsCapacity;     // In bytes
+};
+
 // Stored in ImFontAtlas::FontLoaderData. ALLOCATED BY US.
 struct ImGui_ImplFreeType_Data
 {
     FT_Library                      Library;
     FT_MemoryRec_                   MemoryManager;
+    ImVector<ImGui_ImplFreeType_Worker*> Workers;       // Created on demand by ImGui_ImplFreeType_FontBakedPrerenderGlyphs()
     ImGui_ImplFreeType_Data()       { memset((void*)this, 0, sizeof(*this)); }
 };
 
+// Glyph rendered ahead of ImGui_ImplFreeType_FontBakedLoadGlyph() by ImGui_ImplFreeType_FontBakedPrerenderGlyphs().
+struct ImGui_ImplFreeType_PrerenderedGlyph
+{
+    ImWchar                         Codepoint;
+    bool                            Loaded;             // false if FT_Load_Glyph() or FT_Render_Glyph() failed
+    bool                            Colored;
+    int                             Width, Height;
+    int                             BitmapLeft, BitmapTop;
+    FT_Pos                          AdvanceX;
+    int                             WorkerIdx;
+    int                             PixelsOffset;       // Offset into WorkerFaces[WorkerIdx].Pixels[], in bytes
+};
+
 // Stored in ImFontConfig::FontLoaderData. ALLOCATED BY US.
 struct ImGui_ImplFreeType_FontSrcData
 {
@@ -163,6 +212,9 @@ struct ImGui_ImplFreeType_FontSrcData
     ImGuiFreeTypeLoaderFlags        UserFlags;          // = ImFontConfig::FontLoaderFlags
     FT_Int32                        LoadFlags;
     ImFontBaked*                    BakedLastActivated;
+    ImVector<ImGui_ImplFreeType_WorkerFace> WorkerFaces; // One per ImGui_ImplFreeType_Data::Workers[], created on demand
+    ImVector<ImGui_ImplFreeType_PrerenderedGlyph> PrerenderedGlyphs; // Sorted by codepoint
+    ImFontBaked*                    PrerenderedBaked;
 };
 
 // Stored in ImFontBaked::FontLoaderDatas: pointer to SourcesCount instances of this. ALLOCATED BY CORE.
@@ -172,6 +224,14 @@ struct ImGui_ImplFreeType_FontSrcBakedData
     ImGui_ImplFreeType_FontSrcBakedData() { memset((void*)this, 0, sizeof(*this)); }
 };
 
+static void ImGui_ImplFreeType_WorkerFaceFreePixels(ImGui_ImplFreeType_WorkerFace* worker_face)
+{
+    if (worker_face->Pixels)
+        worker_face->Allocator->FreeFunc(worker_face->Pixels, worker_face->Allocator->UserData);
+    worker_face->Pixels = nullptr;
+    worker_face->PixelsSize = worker_face->PixelsCapacity = 0;
+}
+
 bool ImGui_ImplFreeType_FontSrcData::InitFont(FT_Library ft_library, ImFontConfig* src, ImGuiFreeTypeLoaderFlags extra_font_loader_flags)
 {
     FT_Error error = FT_New_Memory_Face(ft_library, (uint8_t*)src->FontData, (uint32_t)src->FontDataSize, (uint32_t)src->FontNo, &FtFace);
@@ -212,6 +272,14 @@ bool ImGui_ImplFreeType_FontSrcData::InitFont(FT_Library ft_library, ImFontConfi
 
 void ImGui_ImplFreeType_FontSrcData::CloseFont()
 {
+    for (ImGui_ImplFreeType_WorkerFace& worker_face : WorkerFaces)
+    {
+        FT_Done_Face(worker_face.Face);
+        ImGui_ImplFreeType_WorkerFaceFreePixels(&worker_face);
+    }
+    WorkerFaces.clear();
+    PrerenderedGlyphs.clear();
+    PrerenderedBaked = nullptr;
     if (FtFace)
     {
         FT_Done_Face(FtFace);
@@ -219,9 +287,10 @@ void ImGui_ImplFreeType_FontSrcData::CloseFont()
     }
 }
 
-static const FT_Glyph_Metrics* ImGui_ImplFreeType_LoadGlyph(ImGui_ImplFreeType_FontSrcData* src_data, uint32_t codepoint)
+// Load glyph into face->glyph. 'face' is either src_data->FtFace or one of src_data->WorkerFaces[].
+static const FT_Glyph_Metrics* ImGui_ImplFreeType_LoadGlyph(ImGui_ImplFreeType_FontSrcData* src_data, FT_Face face, uint32_t codepoint)
 {
-    uint32_t glyph_index = FT_Get_Char_Index(src_data->FtFace, codepoint);
+    uint32_t glyph_index = FT_Get_Char_Index(face, codepoint);
     if (glyph_index == 0)
         return nullptr;
 
@@ -230,12 +299,12 @@ static const FT_Glyph_Metrics* ImGui_ImplFreeType_LoadGlyph(ImGui_ImplFreeType_F
     // - https://github.com/ocornut/imgui/issues/4567
     // - https://github.com/ocornut/imgui/issues/4566
     // You can use FreeType 2.10, or the patched version of 2.11.0 in VcPkg, or probably any upcoming FreeType version.
-    FT_Error error = FT_Load_Glyph(src_data->FtFace, glyph_index, src_data->LoadFlags);
+    FT_Error error = FT_Load_Glyph(face, glyph_index, src_data->LoadFlags);
     if (error)
         return nullptr;
 
     // Need an outline for this to work
-    FT_GlyphSlot slot = src_data->FtFace->glyph;
+    FT_GlyphSlot slot = face->glyph;
 #if defined(IMGUI_ENABLE_FREETYPE_LUNASVG) || defined(IMGUI_ENABLE_FREETYPE_PLUTOSVG)
     IM_ASSERT(slot->format == FT_GLYPH_FORMAT_OUTLINE || slot->format == FT_GLYPH_FORMAT_BITMAP || slot->format == FT_GLYPH_FORMAT_SVG);
 #else
@@ -260,6 +329,18 @@ static const FT_Glyph_Metrics* ImGui_ImplFreeType_LoadGlyph(ImGui_ImplFreeType_F
     return &slot->metrics;
 }
 
+// Load glyph and render it into face->glyph->bitmap (currently held by FreeType)
+static const FT_Bitmap* ImGui_ImplFreeType_RenderGlyph(ImGui_ImplFreeType_FontSrcData* src_data, FT_Face face, uint32_t codepoint)
+{
+    if (ImGui_ImplFreeType_LoadGlyph(src_data, face, codepoint) == nullptr)
+        return nullptr;
+    FT_Render_Mode render_mode = (src_data->UserFlags & ImGuiFreeTypeLoaderFlags_Monochrome) ? FT_RENDER_MODE_MONO : FT_RENDER_MODE_NORMAL;
+    FT_Error error = FT_Render_Glyph(face->glyph, render_mode);
+    if (error != 0)
+        return nullptr;
+    return &face->glyph->bitmap;
+}
+
 static void ImGui_ImplFreeType_BlitGlyph(const FT_Bitmap* ft_bitmap, uint32_t* dst, uint32_t dst_pitch)
 {
     IM_ASSERT(ft_bitmap != nullptr);
@@ -310,34 +391,77 @@ static void ImGui_ImplFreeType_BlitGlyph(const FT_Bitmap* ft_bitmap, uint32_t* d
     }
 }
 
+// Same as ImGui_ImplFreeType_BlitGlyph() for non-colored glyphs, writing ImTextureFormat_Alpha8 pixels.
+static void ImGui_ImplFreeType_BlitGlyphAlpha8(const FT_Bitmap* ft_bitmap, uint8_t* dst, uint32_t dst_pitch)
+{
+    IM_ASSERT(ft_bitmap != nullptr);
+    const uint32_t w = ft_bitmap->width;
+    const uint32_t h = ft_bitmap->rows;
+    const uint8_t* src = ft_bitmap->buffer;
+    const uint32_t src_pitch = ft_bitmap->pitch;
+
+    switch (ft_bitmap->pixel_mode)
+    {
+    case FT_PIXEL_MODE_GRAY: // Grayscale image, 1 byte per pixel.
+        {
+            for (uint32_t y = 0; y < h; y++, src += src_pitch, dst += dst_pitch)
+                memcpy(dst, src, w);
+            break;
+        }
+    case FT_PIXEL_MODE_MONO: // Monochrome image, 1 bit per pixel. The bits in each byte are ordered from MSB to LSB.
+        {
+            for (uint32_t y = 0; y < h; y++, src += src_pitch, dst += dst_pitch)
+            {
+                uint8_t bits = 0;
+                const uint8_t* bits_ptr = src;
+                for (uint32_t x = 0; x < w; x++, bits <<= 1)
+                {
+                    if ((x & 7) == 0)
+                        bits = *bits_ptr++;
+                    dst[x] = (bits & 0x80) ? 255 : 0;
+                }
+            }
+            break;
+        }
+    default:
+        IM_ASSERT(0 && "FreeTypeFont::BlitGlyphAlpha8(): Unsupported bitmap pixel mode!");
+    }
+}
+
 // FreeType memory allocation callbacks
-static void* FreeType_Alloc(FT_Memory /*memory*/, long size)
+// (memory->user is set to a ImGui_ImplFreeType_Allocator for libraries of worker tasks)
+static void* FreeType_Alloc(FT_Memory memory, long size)
 {
+    if (ImGui_ImplFreeType_Allocator* allocator = (ImGui_ImplFreeType_Allocator*)memory->user)
+        return allocator->AllocFunc((size_t)size, allocator->UserData);
     return GImGuiFreeTypeAllocFunc((size_t)size, GImGuiFreeTypeAllocatorUserData);
 }
 
-static void FreeType_Free(FT_Memory /*memory*/, void* block)
+static void FreeType_Free(FT_Memory memory, void* block)
 {
-    GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
+    if (ImGui_ImplFreeType_Allocator* allocator = (ImGui_ImplFreeType_Allocator*)memory->user)
+        allocator->FreeFunc(block, allocator->UserData);
+    else
+        GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
 }
 
-static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size, void* block)
+static void* FreeType_Realloc(FT_Memory memory, long cur_size, long new_size, void* block)
 {
     // Implement realloc() as we don't ask user to provide it.
     if (block == nullptr)
-        return GImGuiFreeTypeAllocFunc((size_t)new_size, GImGuiFreeTypeAllocatorUserData);
+        return FreeType_Alloc(memory, new_size);
 
     if (new_size == 0)
     {
-        GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
+        FreeType_Free(memory, block);
         return nullptr;
     }
 
     if (new_size > cur_size)
     {
-        void* new_block = GImGuiFreeTypeAllocFunc((size_t)new_size, GImGuiFreeTypeAllocatorUserData);
+        void* new_block = FreeType_Alloc(memory, new_size);
         memcpy(new_block, block, (size_t)cur_size);
-        GImGuiFreeTypeFreeFunc(block, GImGuiFreeTypeAllocatorUserData);
+        FreeType_Free(memory, block);
         return new_block;
     }
 
@@ -384,10 +508,53 @@ bool ImGui_ImplFreeType_LoaderInit(ImFontAtlas* atlas)
     return true;
 }
 
+static ImGui_ImplFreeType_Worker* ImGui_ImplFreeType_CreateWorker()
+{
+    ImGui_ImplFreeType_Worker* worker = IM_NEW(ImGui_ImplFreeType_Worker)();
+
+    // Use ImGui::GetAllocatorFunctions() directly unless ImGuiFreeType::SetAllocatorFunctions() was called, in which case those functions need to be thread-safe.
+    if (GImGuiFreeTypeAllocFunc == ImGuiFreeTypeDefaultAllocFunc && GImGuiFreeTypeFreeFunc == ImGuiFreeTypeDefaultFreeFunc)
+    {
+        ImGui::GetAllocatorFunctions(&worker->Allocator.AllocFunc, &worker->Allocator.FreeFunc, &worker->Allocator.UserData);
+    }
+    else
+    {
+        worker->Allocator.AllocFunc = GImGuiFreeTypeAllocFunc;
+        worker->Allocator.FreeFunc = GImGuiFreeTypeFreeFunc;
+        worker->Allocator.UserData = GImGuiFreeTypeAllocatorUserData;
+    }
+    worker->MemoryManager.user = &worker->Allocator;
+    worker->MemoryManager.alloc = &FreeType_Alloc;
+    worker->MemoryManager.free = &FreeType_Free;
+    worker->MemoryManager.realloc = &FreeType_Realloc;
+    if (FT_New_Library(&worker->MemoryManager, &worker->Library) != 0)
+    {
+        IM_DELETE(worker);
+        return nullptr;
+    }
+    FT_Add_Default_Modules(worker->Library);
+#ifdef IMGUI_ENABLE_FREETYPE_LUNASVG
+    SVG_RendererHooks hooks = { ImGuiLunasvgPortInit, ImGuiLunasvgPortFree, ImGuiLunasvgPortRender, ImGuiLunasvgPortPresetSlot };
+    FT_Property_Set(worker->Library, "ot-svg", "svg-hooks", &hooks);
+#endif
+#ifdef IMGUI_ENABLE_FREETYPE_PLUTOSVG
+    FT_Property_Set(worker->Library, "ot-svg", "svg-hooks", plutosvg_ft_svg_hooks());
+#endif
+    return worker;
+}
+
+static void ImGui_ImplFreeType_DestroyWorker(ImGui_ImplFreeType_Worker* worker)
+{
+    FT_Done_Library(worker->Library);
+    IM_DELETE(worker);
+}
+
 void ImGui_ImplFreeType_LoaderShutdown(ImFontAtlas* atlas)
 {
     ImGui_ImplFreeType_Data* bd = (ImGui_ImplFreeType_Data*)atlas->FontLoaderData;
     IM_ASSERT(bd != nullptr);
+    for (ImGui_ImplFreeType_Worker* worker : bd->Workers)
+        ImGui_ImplFreeType_DestroyWorker(worker);
     FT_Done_Library(bd->Library);
     IM_DELETE(bd);
     atlas->FontLoaderData = nullptr;
@@ -418,24 +585,13 @@ void ImGui_ImplFreeType_FontSrcDestroy(ImFontAtlas* atlas, ImFontConfig* src)
     src->FontLoaderData = nullptr;
 }
 
-bool ImGui_ImplFreeType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src)
+// Set the active size of 'face' for rendering glyphs of 'baked'
+static void ImGui_ImplFreeType_RequestSize(ImGui_ImplFreeType_FontSrcData* bd_font_data, FT_Face face, ImFontConfig* src, ImFontBaked* baked)
 {
-    IM_UNUSED(atlas);
     float size = baked->Size;
     if (src->MergeMode && src->SizePixels != 0.0f)
         size *= (src->SizePixels / baked->ContainerFont->Sources[0]->SizePixels);
 
-    ImGui_ImplFreeType_FontSrcData* bd_font_data = (ImGui_ImplFreeType_FontSrcData*)src->FontLoaderData;
-    bd_font_data->BakedLastActivated = baked;
-
-    // We use one FT_Size per (source + baked) combination.
-    ImGui_ImplFreeType_FontSrcBakedData* bd_baked_data = (ImGui_ImplFreeType_FontSrcBakedData*)loader_data_for_baked_src;
-    IM_ASSERT(bd_baked_data != nullptr);
-    IM_PLACEMENT_NEW(bd_baked_data) ImGui_ImplFreeType_FontSrcBakedData();
-
-    FT_New_Size(bd_font_data->FtFace, &bd_baked_data->FtSize);
-    FT_Activate_Size(bd_baked_data->FtSize);
-
     // Vuhdo 2017: "I'm not sure how to deal with font sizes properly. As far as I understand, currently ImGui assumes that the 'pixel_height'
     // is a maximum height of an any given glyph, i.e. it's the sum of font's ascender and descender. Seems strange to me.
     // FT_Set_Pixel_Sizes() doesn't seem to get us the same result."
@@ -447,14 +603,30 @@ bool ImGui_ImplFreeType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig* src, ImF
     req.height = (uint32_t)(size * 64 * rasterizer_density);
     req.horiResolution = 0;
     req.vertResolution = 0;
-    FT_Request_Size(bd_font_data->FtFace, &req);
+    FT_Request_Size(face, &req);
+}
+
+bool ImGui_ImplFreeType_FontBakedInit(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src)
+{
+    IM_UNUSED(atlas);
+    ImGui_ImplFreeType_FontSrcData* bd_font_data = (ImGui_ImplFreeType_FontSrcData*)src->FontLoaderData;
+    bd_font_data->BakedLastActivated = baked;
+
+    // We use one FT_Size per (source + baked) combination.
+    ImGui_ImplFreeType_FontSrcBakedData* bd_baked_data = (ImGui_ImplFreeType_FontSrcBakedData*)loader_data_for_baked_src;
+    IM_ASSERT(bd_baked_data != nullptr);
+    IM_PLACEMENT_NEW(bd_baked_data) ImGui_ImplFreeType_FontSrcBakedData();
+
+    FT_New_Size(bd_font_data->FtFace, &bd_baked_data->FtSize);
+    FT_Activate_Size(bd_baked_data->FtSize);
+    ImGui_ImplFreeType_RequestSize(bd_font_data, bd_font_data->FtFace, src, baked);
 
     // Output
     if (src->MergeMode == false)
     {
         // Read metrics
         FT_Size_Metrics metrics = bd_baked_data->FtSize->metrics;
-        const float scale = 1.0f / rasterizer_density;
+        const float scale = 1.0f / (src->RasterizerDensity * baked->RasterizerDensity);
         baked->Ascent     = (float)FT_CEIL(metrics.ascender) * scale;       // The pixel extents above the baseline in pixels (typically positive).
         baked->Descent    = (float)FT_CEIL(metrics.descender) * scale;      // The extents below the baseline in pixels (typically negative).
         //LineSpacing     = (float)FT_CEIL(metrics.height) * scale;         // The baseline-to-baseline distance. Note that it usually is larger than the sum of the ascender and descender taken as absolute values. There is also no guarantee that no glyphs extend above or below subsequent baselines when using this distance. Think of it as a value the designer of the font finds appropriate.
@@ -475,6 +647,25 @@ void ImGui_ImplFreeType_FontBakedDestroy(ImFontAtlas* atlas, ImFontConfig* src,
     bd_baked_data->~ImGui_ImplFreeType_FontSrcBakedData(); // ~IM_PLACEMENT_DELETE()
 }
 
+// Find glyph rendered ahead by ImGui_ImplFreeType_FontBakedPrerenderGlyphs()
+static const ImGui_ImplFreeType_PrerenderedGlyph* ImGui_ImplFreeType_FindPrerenderedGlyph(ImGui_ImplFreeType_FontSrcData* bd_font_data, ImFontBaked* baked, ImWchar codepoint)
+{
+    if (bd_font_data->PrerenderedBaked != baked)
+        return nullptr;
+    int lo = 0, hi = bd_font_data->PrerenderedGlyphs.Size;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) >> 1;
+        if (bd_font_data->PrerenderedGlyphs.Data[mid].Codepoint < codepoint)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo < bd_font_data->PrerenderedGlyphs.Size && bd_font_data->PrerenderedGlyphs.Data[lo].Codepoint == codepoint)
+        return &bd_font_data->PrerenderedGlyphs.Data[lo];
+    return nullptr;
+}
+
 bool ImGui_ImplFreeType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, ImWchar codepoint, ImFontGlyph* out_glyph)
 {
     ImGui_ImplFreeType_FontSrcData* bd_font_data = (ImGui_ImplFreeType_FontSrcData*)src->FontLoaderData;
@@ -482,40 +673,56 @@ bool ImGui_ImplFreeType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src
     if (glyph_index == 0)
         return false;
 
-    if (bd_font_data->BakedLastActivated != baked) // <-- could use id
+    int w, h, bitmap_left, bitmap_top;
+    FT_Pos advance_x;
+    bool is_colored;
+    const FT_Bitmap* ft_bitmap = nullptr;
+    const ImGui_ImplFreeType_PrerenderedGlyph* prerendered_glyph = ImGui_ImplFreeType_FindPrerenderedGlyph(bd_font_data, baked, codepoint);
+    if (prerendered_glyph != nullptr)
     {
-        // Activate current size
-        ImGui_ImplFreeType_FontSrcBakedData* bd_baked_data = (ImGui_ImplFreeType_FontSrcBakedData*)loader_data_for_baked_src;
-        FT_Activate_Size(bd_baked_data->FtSize);
-        bd_font_data->BakedLastActivated = baked;
+        if (!prerendered_glyph->Loaded)
+            return false;
+        w = prerendered_glyph->Width;
+        h = prerendered_glyph->Height;
+        bitmap_left = prerendered_glyph->BitmapLeft;
+        bitmap_top = prerendered_glyph->BitmapTop;
+        advance_x = prerendered_glyph->AdvanceX;
+        is_colored = prerendered_glyph->Colored;
     }
+    else
+    {
+        if (bd_font_data->BakedLastActivated != baked) // <-- could use id
+        {
+            // Activate current size
+            ImGui_ImplFreeType_FontSrcBakedData* bd_baked_data = (ImGui_ImplFreeType_FontSrcBakedData*)loader_data_for_baked_src;
+            FT_Activate_Size(bd_baked_data->FtSize);
+            bd_font_data->BakedLastActivated = baked;
+        }
 
-    const FT_Glyph_Metrics* metrics = ImGui_ImplFreeType_LoadGlyph(bd_font_data, codepoint);
-    if (metrics == nullptr)
-        return false;
-
-    // Render glyph into a bitmap (currently held by FreeType)
-    FT_Face face = bd_font_data->FtFace;
-    FT_GlyphSlot slot = face->glyph;
-    FT_Render_Mode render_mode = (bd_font_data->UserFlags & ImGuiFreeTypeLoaderFlags_Monochrome) ? FT_RENDER_MODE_MONO : FT_RENDER_MODE_NORMAL;
-    FT_Error error = FT_Render_Glyph(slot, render_mode);
-    const FT_Bitmap* ft_bitmap = &slot->bitmap;
-    if (error != 0 || ft_bitmap == nullptr)
-        return false;
+        // Render glyph into a bitmap (currently held by FreeType)
+        FT_Face face = bd_font_data->FtFace;
+        ft_bitmap = ImGui_ImplFreeType_RenderGlyph(bd_font_data, face, codepoint);
+        if (ft_bitmap == nullptr)
+            return false;
+        w = (int)ft_bitmap->width;
+        h = (int)ft_bitmap->rows;
+        bitmap_left = face->glyph->bitmap_left;
+        bitmap_top = face->glyph->bitmap_top;
+        advance_x = face->glyph->advance.x;
+        is_colored = (ft_bitmap->pixel_mode == FT_PIXEL_MODE_BGRA);
+    }
 
-    const int w = (int)ft_bitmap->width;
-    const int h = (int)ft_bitmap->rows;
     const bool is_visible = (w != 0 && h != 0);
     const float rasterizer_density = src->RasterizerDensity * baked->RasterizerDensity;
 
     // Prepare glyph
     out_glyph->Codepoint = codepoint;
-    out_glyph->AdvanceX = (slot->advance.x / FT_SCALEFACTOR) / rasterizer_density;
+    out_glyph->AdvanceX = (advance_x / FT_SCALEFACTOR) / rasterizer_density;
 
     // Pack and retrieve position inside texture atlas
     if (is_visible)
     {
-        ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h);
+        ImFontAtlasRectId pack_id = ImFontAtlasPackAddRect(atlas, w, h, NULL, is_colored);
         if (pack_id == ImFontAtlasRectId_Invalid)
         {
             // Pathological out of memory case (TexMaxWidth/TexMaxHeight set too small?)
@@ -524,10 +731,21 @@ bool ImGui_ImplFreeType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src
         }
         ImTextureRect* r = ImFontAtlasPackGetRect(atlas, pack_id);
 
-        // Render pixels to our temporary buffer
-        atlas->Builder->TempBuffer.resize(w * h * 4);
-        uint32_t* temp_buffer = (uint32_t*)atlas->Builder->TempBuffer.Data;
-        ImGui_ImplFreeType_BlitGlyph(ft_bitmap, temp_buffer, w);
+        // Render pixels to our temporary buffer, unless already rendered ahead
+        const uint8_t* glyph_pixels;
+        ImTextureFormat glyph_pixels_format = ImTextureFormat_RGBA32;
+        if (prerendered_glyph != nullptr)
+        {
+            glyph_pixels = bd_font_data->WorkerFaces[prerendered_glyph->WorkerIdx].Pixels + prerendered_glyph->PixelsOffset;
+            glyph_pixels_format = is_colored ? ImTextureFormat_RGBA32 : ImTextureFormat_Alpha8;
+        }
+        else
+        {
+            atlas->Builder->TempBuffer.resize(w * h * 4);
+            uint32_t* temp_buffer = (uint32_t*)atlas->Builder->TempBuffer.Data;
+            ImGui_ImplFreeType_BlitGlyph(ft_bitmap, temp_buffer, w);
+            glyph_pixels = (const uint8_t*)temp_buffer;
+        }
 
         const float ref_size = baked->ContainerFont->Sources[0]->SizePixels;
         const float offsets_scale = (ref_size != 0.0f) ? (baked->Size / ref_size) : 1.0f;
@@ -541,21 +759,155 @@ bool ImGui_ImplFreeType_FontBakedLoadGlyph(ImFontAtlas* atlas, ImFontConfig* src
         float recip_v = 1.0f / rasterizer_density;
 
         // Register glyph
-        float glyph_off_x = (float)face->glyph->bitmap_left;
-        float glyph_off_y = (float)-face->glyph->bitmap_top;
+        float glyph_off_x = (float)bitmap_left;
+        float glyph_off_y = (float)-bitmap_top;
         out_glyph->X0 = glyph_off_x * recip_h + font_off_x;
         out_glyph->Y0 = glyph_off_y * recip_v + font_off_y;
         out_glyph->X1 = (glyph_off_x + w) * recip_h + font_off_x;
         out_glyph->Y1 = (glyph_off_y + h) * recip_v + font_off_y;
         out_glyph->Visible = true;
-        out_glyph->Colored = (ft_bitmap->pixel_mode == FT_PIXEL_MODE_BGRA);
+        out_glyph->Colored = is_colored;
         out_glyph->PackId = pack_id;
-        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, (const unsigned char*)temp_buffer, ImTextureFormat_RGBA32, w * 4);
+        ImFontAtlasBakedSetFontGlyphBitmap(atlas, baked, src, out_glyph, r, (const unsigned char*)glyph_pixels, glyph_pixels_format, w * ImTextureDataGetFormatBytesPerPixel(glyph_pixels_format));
     }
 
     return true;
 }
 
+struct ImGui_ImplFreeType_PrerenderTaskData
+{
+    ImGui_ImplFreeType_FontSrcData* FontSrcData;
+    ImFontConfig*                   Src;
+    ImFontBaked*                    Baked;
+    int                             TasksCount;
+};
+
+static void ImGui_ImplFreeType_WorkerFaceReservePixels(ImGui_ImplFreeType_WorkerFace* worker_face, int new_size)
+{
+    if (new_size <= worker_face->PixelsCapacity)
+        return;
+    const int new_capacity = ImMax(new_size, worker_face->PixelsCapacity * 2);
+    uint8_t* new_pixels = (uint8_t*)worker_face->Allocator->AllocFunc((size_t)new_capacity, worker_face->Allocator->UserData);
+    if (worker_face->Pixels)
+    {
+        memcpy(new_pixels, worker_face->Pixels, (size_t)worker_face->PixelsSize);
+        worker_face->Allocator->FreeFunc(worker_face->Pixels, worker_face->Allocator->UserData);
+    }
+    worker_face->Pixels = new_pixels;
+    worker_face->PixelsCapacity = new_capacity;
+}
+
+// Render every TasksCount-th glyph of FontSrcData->PrerenderedGlyphs[], starting from 'task_idx', using worker 'task_idx'.
+// May be called from any thread: only touches data owned by the worker and its own glyphs.
+static void ImGui_ImplFreeType_PrerenderGlyphsTask(void* task_data_p, int task_idx)
+{
+    ImGui_ImplFreeType_PrerenderTaskData* task_data = (ImGui_ImplFreeType_PrerenderTaskData*)task_data_p;
+    ImGui_ImplFreeType_FontSrcData* bd_font_data = task_data->FontSrcData;
+    ImGui_ImplFreeType_WorkerFace* worker_face = &bd_font_data->WorkerFaces[task_idx];
+    FT_Face face = worker_face->Face;
+    ImGui_ImplFreeType_RequestSize(bd_font_data, face, task_data->Src, task_data->Baked);
+
+    worker_face->PixelsSize = 0;
+    for (int glyph_n = task_idx; glyph_n < bd_font_data->PrerenderedGlyphs.Size; glyph_n += task_data->TasksCount)
+    {
+        ImGui_ImplFreeType_PrerenderedGlyph* glyph = &bd_font_data->PrerenderedGlyphs.Data[glyph_n];
+        const FT_Bitmap* ft_bitmap = ImGui_ImplFreeType_RenderGlyph(bd_font_data, face, glyph->Codepoint);
+        if (ft_bitmap == nullptr)
+            continue;
+        glyph->Loaded = true;
+        glyph->Colored = (ft_bitmap->pixel_mode == FT_PIXEL_MODE_BGRA);
+        glyph->Width = (int)ft_bitmap->width;
+        glyph->Height = (int)ft_bitmap->rows;
+        glyph->BitmapLeft = face->glyph->bitmap_left;
+        glyph->BitmapTop = face->glyph->bitmap_top;
+        glyph->AdvanceX = face->glyph->advance.x;
+        glyph->WorkerIdx = task_idx;
+        if (glyph->Width != 0 && glyph->Height != 0)
+        {
+            // Keep non-colored glyphs as Alpha8: 4x less memory until they are copied into the atlas
+            if (glyph->Colored)
+                worker_face->PixelsSize = (worker_face->PixelsSize + 3) & ~3;
+            const int bytes_per_pixel = glyph->Colored ? 4 : 1;
+            glyph->PixelsOffset = worker_face->PixelsSize;
+            ImGui_ImplFreeType_WorkerFaceReservePixels(worker_face, worker_face->PixelsSize + glyph->Width * glyph->Height * bytes_per_pixel);
+            if (glyph->Colored)
+                ImGui_ImplFreeType_BlitGlyph(ft_bitmap, (uint32_t*)(void*)(worker_face->Pixels + glyph->PixelsOffset), glyph->Width);
+            else
+                ImGui_ImplFreeType_BlitGlyphAlpha8(ft_bitmap, worker_face->Pixels + glyph->PixelsOffset, glyph->Width);
+            worker_face->PixelsSize += glyph->Width * glyph->Height * bytes_per_pixel;
+        }
+    }
+}
+
+static int IMGUI_CDECL ImGui_ImplFreeType_PrerenderedGlyphCompare(const void* lhs, const void* rhs)
+{
+    return (int)((const ImGui_ImplFreeType_PrerenderedGlyph*)lhs)->Codepoint - (int)((const ImGui_ImplFreeType_PrerenderedGlyph*)rhs)->Codepoint;
+}
+
+// Render glyphs requested by ImFontBaked::LoadGlyphs() in parallel, ahead of ImGui_ImplFreeType_FontBakedLoadGlyph() calls.
+// - FT_Face objects cannot be used concurrently, so each task uses its own FT_Library with its own FT_Face instance of this source.
+//   Those are created here on the calling thread (FT_New_Face() is not thread-safe), and kept for subsequent calls.
+// - Does nothing when platform_io.Platform_ParallelForFn is not set: glyphs are then rendered by ImGui_ImplFreeType_FontBakedLoadGlyph().
+// - Pixels are held until the release call (codepoints_count == 0), which ImFontBaked::LoadGlyphs() makes after each batch of IM_FONTBAKED_PRERENDER_BATCH_SIZE codepoints.
+void ImGui_ImplFreeType_FontBakedPrerenderGlyphs(ImFontAtlas* atlas, ImFontConfig* src, ImFontBaked* baked, void* loader_data_for_baked_src, const ImWchar* codepoints, int codepoints_count)
+{
+    IM_UNUSED(loader_data_for_baked_src);
+    ImGui_ImplFreeType_Data* bd = (ImGui_ImplFreeType_Data*)atlas->FontLoaderData;
+    ImGui_ImplFreeType_FontSrcData* bd_font_data = (ImGui_ImplFreeType_FontSrcData*)src->FontLoaderData;
+    bd_font_data->PrerenderedGlyphs.resize(0);
+    bd_font_data->PrerenderedBaked = nullptr;
+    if (codepoints_count == 0)
+    {
+        // Release call: glyphs were copied into the atlas, drop their pixels
+        for (ImGui_ImplFreeType_WorkerFace& worker_face : bd_font_data->WorkerFaces)
+            ImGui_ImplFreeType_WorkerFaceFreePixels(&worker_face);
+        return;
+    }
+
+    ImGuiContext* ctx = ImGui::GetCurrentContext();
+    if (ctx == nullptr || ImGui::GetPlatformIO().Platform_ParallelForFn == nullptr)
+        return;
+    int tasks_count = ImMin(codepoints_count / IMGUI_FREETYPE_MIN_GLYPHS_PER_WORKER, IMGUI_FREETYPE_MAX_WORKERS);
+    if (tasks_count < 2)
+        return;
+
+    // Create workers and their instance of this source on demand
+    while (bd->Workers.Size < tasks_count)
+    {
+        ImGui_ImplFreeType_Worker* worker = ImGui_ImplFreeType_CreateWorker();
+        if (worker == nullptr)
+            break;
+        bd->Workers.push_back(worker);
+    }
+    while (bd_font_data->WorkerFaces.Size < ImMin(tasks_count, bd->Workers.Size))
+    {
+        ImGui_ImplFreeType_Worker* worker = bd->Workers[bd_font_data->WorkerFaces.Size];
+        ImGui_ImplFreeType_WorkerFace worker_face = {};
+        if (FT_New_Memory_Face(worker->Library, (uint8_t*)src->FontData, (uint32_t)src->FontDataSize, (uint32_t)src->FontNo, &worker_face.Face) != 0)
+            break;
+        if (FT_Select_Charmap(worker_face.Face, FT_ENCODING_UNICODE) != 0)
+        {
+            FT_Done_Face(worker_face.Face);
+            break;
+        }
+        worker_face.Allocator = &worker->Allocator;
+        bd_font_data->WorkerFaces.push_back(worker_face);
+    }
+    tasks_count = ImMin(tasks_count, bd_font_data->WorkerFaces.Size);
+    if (tasks_count < 2)
+        return;
+
+    bd_font_data->PrerenderedGlyphs.resize(codepoints_count);
+    memset(bd_font_data->PrerenderedGlyphs.Data, 0, (size_t)codepoints_count * sizeof(ImGui_ImplFreeType_PrerenderedGlyph));
+    for (int n = 0; n < codepoints_count; n++)
+        bd_font_data->PrerenderedGlyphs.Data[n].Codepoint = codepoints[n];
+    ImQsort(bd_font_data->PrerenderedGlyphs.Data, (size_t)codepoints_count, sizeof(ImGui_ImplFreeType_PrerenderedGlyph), ImGui_ImplFreeType_PrerenderedGlyphCompare);
+    bd_font_data->PrerenderedBaked = baked;
+
+    ImGui_ImplFreeType_PrerenderTaskData task_data = { bd_font_data, src, baked, tasks_count };
+    ImGui::ParallelFor(ImGui_ImplFreeType_PrerenderGlyphsTask, &task_data, tasks_count);
+}
+
 bool ImGui_ImplFreetype_FontSrcContainsGlyph(ImFontAtlas* atlas, ImFontConfig* src, ImWchar codepoint)
 {
     IM_UNUSED(atlas);
@@ -576,6 +928,7 @@ const ImFontLoader* ImGuiFreeType::GetFontLoader()
     loader.FontBakedInit = ImGui_ImplFreeType_FontBakedInit;
     loader.FontBakedDestroy = ImGui_ImplFreeType_FontBakedDestroy;
     loader.FontBakedLoadGlyph = ImGui_ImplFreeType_FontBakedLoadGlyph;
+    loader.FontBakedPrerenderGlyphs = ImGui_ImplFreeType_FontBakedPrerenderGlyphs;
     loader.FontBakedSrcLoaderDataSize = sizeof(ImGui_ImplFreeType_FontSrcBakedData);
     return &loader;
 }
@@ -10,6 +10,11 @@
 //   for imgui_freetype in imgui. It is equivalent to selecting the default loader with:
 //      io.Fonts.FontLoader = ImGuiFreeType::GetFontLoader()
 
+// Parallel glyph loading:
+// - ImFontBaked::LoadGlyphs() renders glyphs on multiple threads if platform_io.Platform_ParallelForFn is set,
+//   e.g. when preloading glyph ranges with legacy backends. Each task uses its own FT_Library and FT_Face instances.
+// - Define IMGUI_FREETYPE_MAX_WORKERS to change the maximum number of tasks (default to 16).
+
 // Optional support for OpenType SVG fonts:
 // - Add '#define IMGUI_ENABLE_FREETYPE_PLUTOSVG' to use plutosvg (not provided). See #7927.
 // - Add '#define IMGUI_ENABLE_FREETYPE_LUNASVG' to use lunasvg (not provided). See #6591.
@@ -68,6 +73,7 @@ namespace ImGuiFreeType
 
     // Override allocators. By default ImGuiFreeType will use IM_ALLOC()/IM_FREE()
     // However, as FreeType does lots of allocations we provide a way for the user to redirect it to a separate memory heap if desired.
+    // Those functions need to be thread-safe if platform_io.Platform_ParallelForFn is set (see ImFontBaked::LoadGlyphs()).
     IMGUI_API void                      SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data = nullptr);
 
     // Display UI to edit ImFontAtlas::FontLoaderFlags (shared) or ImFontConfig::FontLoaderFlags (single source)